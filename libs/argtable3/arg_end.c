@@ -98,6 +98,7 @@ struct arg_end* arg_end(int maxcount) {
     result->hdr.scanfn = NULL;
     result->hdr.checkfn = NULL;
     result->hdr.errorfn = (arg_errorfn*)arg_end_errorfn;
+    result->hdr.priv = NULL; /* option tables built by arg_compile() */
 
     /* store error[maxcount] array immediately after struct arg_end */
     result->error = (int*)(result + 1);
@@ -74,11 +74,24 @@ int getopt(int, char * const [], const char *);
 extern char *optarg;			/* getopt(3) external variables */
 extern int optind, opterr, optopt;
 #endif
+
 #ifndef _OPTRESET_DECLARED
 #define	_OPTRESET_DECLARED
 extern int optreset;			/* getopt(3) external variable */
 #endif
 
+/*
+ * Reentrant variants, all scanner state is kept in the caller owned
+ * struct arg_parse_ctx (see argtable3.h) which has to be reset with
+ * arg_getopt_init() before the first call.
+ */
+struct arg_parse_ctx;
+void	arg_getopt_init(struct arg_parse_ctx *);
+int	getopt_long_r(int, char * const *, const char *,
+	const struct option *, int *, struct arg_parse_ctx *);
+int	getopt_long_only_r(int, char * const *, const char *,
+	const struct option *, int *, struct arg_parse_ctx *);
+
 #ifdef __cplusplus
 }
 #endif
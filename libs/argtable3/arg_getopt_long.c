@@ -72,7 +72,7 @@ int	optopt = '?';	/* character checked for validity */
 int	optreset;		/* reset getopt */
 char *optarg;		/* argument associated with option */
 
-#define PRINT_ERROR	((opterr) && (*options != ':'))
+#define PRINT_ERROR	((st->opterr) && (*options != ':'))
 
 #define FLAG_PERMUTE	0x01	/* permute non-options to the end of argv */
 #define FLAG_ALLARGS	0x02	/* treat non-options as args to option "-1" */
@@ -93,23 +93,38 @@ char *optarg;		/* argument associated with option */
 #endif
 
 static int getopt_internal(int, char * const *, const char *,
+			   const struct option *, int *, int,
+			   struct arg_parse_ctx *);
+static int getopt_global(int, char * const *, const char *,
 			   const struct option *, int *, int);
 static int parse_long_options(char * const *, const char *,
-			      const struct option *, int *, int, int);
+			      const struct option *, int *, int, int,
+			      struct arg_parse_ctx *);
 static int gcd(int, int);
 static void permute_args(int, int, int, char * const *);
 
-static char *place = EMSG; /* option letter processing */
-
-/* XXX: set optreset to 1 rather than these two */
-static int nonopt_start = -1; /* first non option argument (for permute) */
-static int nonopt_end = -1;   /* first option after non options (for permute) */
+/*
+ * Scanner state behind the getopt(3) external variables. The reentrant
+ * getopt_long_r()/getopt_long_only_r() keep all state in a caller owned
+ * struct arg_parse_ctx instead.
+ */
+static struct arg_parse_ctx global_state = {
+	1,		/* optind */
+	1,		/* opterr */
+	'?',		/* optopt */
+	0,		/* optreset */
+	NULL,		/* optarg */
+	EMSG,		/* place: option letter processing */
+	-1,		/* nonopt_start: first non option argument (for permute) */
+	-1,		/* nonopt_end: first option after non options (for permute) */
+	-1,		/* dash_prefix: NO_PREFIX */
+	-1		/* posixly_correct */
+};
 
 /* Error messages */
 static const char recargchar[] = "option requires an argument -- %c";
 static const char illoptchar[] = "illegal option -- %c"; /* From P1003.2 */
 #ifdef GNU_COMPATIBLE
-static int dash_prefix = NO_PREFIX;
 static const char gnuoptchar[] = "invalid option -- %c";
 
 static const char recargstring[] = "option `%s%s' requires an argument";
@@ -230,7 +245,8 @@ permute_args(int panonopt_start, int panonopt_end, int opt_end,
  */
 static int
 parse_long_options(char * const *nargv, const char *options,
-	const struct option *long_options, int *idx, int short_too, int flags)
+	const struct option *long_options, int *idx, int short_too, int flags,
+	struct arg_parse_ctx *st)
 {
 	char *current_argv, *has_equal;
 #ifdef GNU_COMPATIBLE
@@ -239,9 +255,9 @@ parse_long_options(char * const *nargv, const char *options,
 	size_t current_argv_len;
 	int i, match, exact_match, second_partial_match;
 
-	current_argv = place;
+	current_argv = st->place;
 #ifdef GNU_COMPATIBLE
-	switch (dash_prefix) {
+	switch (st->dash_prefix) {
 		case D_PREFIX:
 			current_dash = "-";
 			break;
@@ -260,7 +276,7 @@ parse_long_options(char * const *nargv, const char *options,
 	exact_match = 0;
 	second_partial_match = 0;
 
-	optind++;
+	st->optind++;
 
 	if ((has_equal = strchr(current_argv, '=')) != NULL) {
 		/* argument found (--option=arg) */
@@ -306,7 +322,7 @@ parse_long_options(char * const *nargv, const char *options,
 #endif
 			     (int)current_argv_len,
 			     current_argv);
-		optopt = 0;
+		st->optopt = 0;
 		return (BADCH);
 	}
 	if (match != -1) {		/* option found */
@@ -323,9 +339,9 @@ parse_long_options(char * const *nargv, const char *options,
 			 * XXX: GNU sets optopt to val regardless of flag
 			 */
 			if (long_options[match].flag == NULL)
-				optopt = long_options[match].val;
+				st->optopt = long_options[match].val;
 			else
-				optopt = 0;
+				st->optopt = 0;
 #ifdef GNU_COMPATIBLE
 			return (BADCH);
 #else
@@ -335,17 +351,17 @@ parse_long_options(char * const *nargv, const char *options,
 		if (long_options[match].has_arg == required_argument ||
 		    long_options[match].has_arg == optional_argument) {
 			if (has_equal)
-				optarg = has_equal;
+				st->optarg = has_equal;
 			else if (long_options[match].has_arg ==
 			    required_argument) {
 				/*
 				 * optional argument doesn't use next nargv
 				 */
-				optarg = nargv[optind++];
+				st->optarg = nargv[st->optind++];
 			}
 		}
 		if ((long_options[match].has_arg == required_argument)
-		    && (optarg == NULL)) {
+		    && (st->optarg == NULL)) {
 			/*
 			 * Missing argument; leading ':' indicates no error
 			 * should be generated.
@@ -360,15 +376,15 @@ parse_long_options(char * const *nargv, const char *options,
 			 * XXX: GNU sets optopt to val regardless of flag
 			 */
 			if (long_options[match].flag == NULL)
-				optopt = long_options[match].val;
+				st->optopt = long_options[match].val;
 			else
-				optopt = 0;
-			--optind;
+				st->optopt = 0;
+			--st->optind;
 			return (BADARG);
 		}
 	} else {			/* unknown option */
 		if (short_too) {
-			--optind;
+			--st->optind;
 			return (-1);
 		}
 		if (PRINT_ERROR)
@@ -377,7 +393,7 @@ parse_long_options(char * const *nargv, const char *options,
 			      current_dash,
 #endif
 			      current_argv);
-		optopt = 0;
+		st->optopt = 0;
 		return (BADCH);
 	}
 	if (idx)
@@ -395,11 +411,11 @@ parse_long_options(char * const *nargv, const char *options,
  */
 static int
 getopt_internal(int nargc, char * const *nargv, const char *options,
-	const struct option *long_options, int *idx, int flags)
+	const struct option *long_options, int *idx, int flags,
+	struct arg_parse_ctx *st)
 {
 	char *oli;				/* option letter list index */
 	int optchar, short_too;
-	static int posixly_correct = -1;
 
 	if (options == NULL)
 		return (-1);
@@ -408,67 +424,67 @@ getopt_internal(int nargc, char * const *nargv, const char *options,
 	 * XXX Some GNU programs (like cvs) set optind to 0 instead of
 	 * XXX using optreset.  Work around this braindamage.
 	 */
-	if (optind == 0)
-		optind = optreset = 1;
+	if (st->optind == 0)
+		st->optind = st->optreset = 1;
 
 	/*
 	 * Disable GNU extensions if POSIXLY_CORRECT is set or options
 	 * string begins with a '+'.
 	 */
-	if (posixly_correct == -1 || optreset) {
+	if (st->posixly_correct == -1 || st->optreset) {
 #if defined(_WIN32) && ((defined(__STDC_LIB_EXT1__) && defined(__STDC_WANT_LIB_EXT1__)) || (defined(__STDC_SECURE_LIB__) && defined(__STDC_WANT_SECURE_LIB__)))
 		size_t requiredSize;
 		getenv_s(&requiredSize, NULL, 0, "POSIXLY_CORRECT");
-		posixly_correct = requiredSize != 0;
+		st->posixly_correct = requiredSize != 0;
 #else
-		posixly_correct = (getenv("POSIXLY_CORRECT") != NULL);
+		st->posixly_correct = (getenv("POSIXLY_CORRECT") != NULL);
 #endif
 	}
 
 	if (*options == '-')
 		flags |= FLAG_ALLARGS;
-	else if (posixly_correct || *options == '+')
+	else if (st->posixly_correct || *options == '+')
 		flags &= ~FLAG_PERMUTE;
 	if (*options == '+' || *options == '-')
 		options++;
 
-	optarg = NULL;
-	if (optreset)
-		nonopt_start = nonopt_end = -1;
+	st->optarg = NULL;
+	if (st->optreset)
+		st->nonopt_start = st->nonopt_end = -1;
 start:
-	if (optreset || !*place) {		/* update scanning pointer */
-		optreset = 0;
-		if (optind >= nargc) {          /* end of argument vector */
-			place = EMSG;
-			if (nonopt_end != -1) {
+	if (st->optreset || !*st->place) {		/* update scanning pointer */
+		st->optreset = 0;
+		if (st->optind >= nargc) {          /* end of argument vector */
+			st->place = EMSG;
+			if (st->nonopt_end != -1) {
 				/* do permutation, if we have to */
-				permute_args(nonopt_start, nonopt_end,
-				    optind, nargv);
-				optind -= nonopt_end - nonopt_start;
+				permute_args(st->nonopt_start, st->nonopt_end,
+				    st->optind, nargv);
+				st->optind -= st->nonopt_end - st->nonopt_start;
 			}
-			else if (nonopt_start != -1) {
+			else if (st->nonopt_start != -1) {
 				/*
 				 * If we skipped non-options, set optind
 				 * to the first of them.
 				 */
-				optind = nonopt_start;
+				st->optind = st->nonopt_start;
 			}
-			nonopt_start = nonopt_end = -1;
+			st->nonopt_start = st->nonopt_end = -1;
 			return (-1);
 		}
-		if (*(place = nargv[optind]) != '-' ||
+		if (*(st->place = nargv[st->optind]) != '-' ||
 #ifdef GNU_COMPATIBLE
-		    place[1] == '\0') {
+		    st->place[1] == '\0') {
 #else
-		    (place[1] == '\0' && strchr(options, '-') == NULL)) {
+		    (st->place[1] == '\0' && strchr(options, '-') == NULL)) {
 #endif
-			place = EMSG;		/* found non-option */
+			st->place = EMSG;		/* found non-option */
 			if (flags & FLAG_ALLARGS) {
 				/*
 				 * GNU extension:
 				 * return non-option as argument to option 1
 				 */
-				optarg = nargv[optind++];
+				st->optarg = nargv[st->optind++];
 				return (INORDER);
 			}
 			if (!(flags & FLAG_PERMUTE)) {
@@ -479,38 +495,38 @@ start:
 				return (-1);
 			}
 			/* do permutation */
-			if (nonopt_start == -1)
-				nonopt_start = optind;
-			else if (nonopt_end != -1) {
-				permute_args(nonopt_start, nonopt_end,
-				    optind, nargv);
-				nonopt_start = optind -
-				    (nonopt_end - nonopt_start);
-				nonopt_end = -1;
+			if (st->nonopt_start == -1)
+				st->nonopt_start = st->optind;
+			else if (st->nonopt_end != -1) {
+				permute_args(st->nonopt_start, st->nonopt_end,
+				    st->optind, nargv);
+				st->nonopt_start = st->optind -
+				    (st->nonopt_end - st->nonopt_start);
+				st->nonopt_end = -1;
 			}
-			optind++;
+			st->optind++;
 			/* process next argument */
 			goto start;
 		}
-		if (nonopt_start != -1 && nonopt_end == -1)
-			nonopt_end = optind;
+		if (st->nonopt_start != -1 && st->nonopt_end == -1)
+			st->nonopt_end = st->optind;
 
 		/*
 		 * If we have "-" do nothing, if "--" we are done.
 		 */
-		if (place[1] != '\0' && *++place == '-' && place[1] == '\0') {
-			optind++;
-			place = EMSG;
+		if (st->place[1] != '\0' && *++st->place == '-' && st->place[1] == '\0') {
+			st->optind++;
+			st->place = EMSG;
 			/*
 			 * We found an option (--), so if we skipped
 			 * non-options, we have to permute.
 			 */
-			if (nonopt_end != -1) {
-				permute_args(nonopt_start, nonopt_end,
-				    optind, nargv);
-				optind -= nonopt_end - nonopt_start;
+			if (st->nonopt_end != -1) {
+				permute_args(st->nonopt_start, st->nonopt_end,
+				    st->optind, nargv);
+				st->optind -= st->nonopt_end - st->nonopt_start;
 			}
-			nonopt_start = nonopt_end = -1;
+			st->nonopt_start = st->nonopt_end = -1;
 			return (-1);
 		}
 	}
@@ -521,97 +537,125 @@ start:
 	 *  2) the arg is not just "-"
 	 *  3) either the arg starts with -- we are getopt_long_only()
 	 */
-	if (long_options != NULL && place != nargv[optind] &&
-	    (*place == '-' || (flags & FLAG_LONGONLY))) {
+	if (long_options != NULL && st->place != nargv[st->optind] &&
+	    (*st->place == '-' || (flags & FLAG_LONGONLY))) {
 		short_too = 0;
 #ifdef GNU_COMPATIBLE
-		dash_prefix = D_PREFIX;
+		st->dash_prefix = D_PREFIX;
 #endif
-		if (*place == '-') {
-			place++;		/* --foo long option */
-			if (*place == '\0')
+		if (*st->place == '-') {
+			st->place++;		/* --foo long option */
+			if (*st->place == '\0')
 				return (BADARG);	/* malformed option */
 #ifdef GNU_COMPATIBLE
-			dash_prefix = DD_PREFIX;
+			st->dash_prefix = DD_PREFIX;
 #endif
-		} else if (*place != ':' && strchr(options, *place) != NULL)
+		} else if (*st->place != ':' && strchr(options, *st->place) != NULL)
 			short_too = 1;		/* could be short option too */
 
 		optchar = parse_long_options(nargv, options, long_options,
-		    idx, short_too, flags);
+		    idx, short_too, flags, st);
 		if (optchar != -1) {
-			place = EMSG;
+			st->place = EMSG;
 			return (optchar);
 		}
 	}
 
-	if ((optchar = (int)*place++) == (int)':' ||
-	    (optchar == (int)'-' && *place != '\0') ||
+	if ((optchar = (int)*st->place++) == (int)':' ||
+	    (optchar == (int)'-' && *st->place != '\0') ||
 	    (oli = strchr(options, optchar)) == NULL) {
 		/*
 		 * If the user specified "-" and  '-' isn't listed in
 		 * options, return -1 (non-option) as per POSIX.
 		 * Otherwise, it is an unknown option character (or ':').
 		 */
-		if (optchar == (int)'-' && *place == '\0')
+		if (optchar == (int)'-' && *st->place == '\0')
 			return (-1);
-		if (!*place)
-			++optind;
+		if (!*st->place)
+			++st->optind;
 #ifdef GNU_COMPATIBLE
 		if (PRINT_ERROR)
-			warnx(posixly_correct ? illoptchar : gnuoptchar,
+			warnx(st->posixly_correct ? illoptchar : gnuoptchar,
 			      optchar);
 #else
 		if (PRINT_ERROR)
 			warnx(illoptchar, optchar);
 #endif
-		optopt = optchar;
+		st->optopt = optchar;
 		return (BADCH);
 	}
 	if (long_options != NULL && optchar == 'W' && oli[1] == ';') {
 		/* -W long-option */
-		if (*place)			/* no space */
+		if (*st->place)			/* no space */
 			/* NOTHING */;
-		else if (++optind >= nargc) {	/* no arg */
-			place = EMSG;
+		else if (++st->optind >= nargc) {	/* no arg */
+			st->place = EMSG;
 			if (PRINT_ERROR)
 				warnx(recargchar, optchar);
-			optopt = optchar;
+			st->optopt = optchar;
 			return (BADARG);
 		} else				/* white space */
-			place = nargv[optind];
+			st->place = nargv[st->optind];
 #ifdef GNU_COMPATIBLE
-		dash_prefix = W_PREFIX;
+		st->dash_prefix = W_PREFIX;
 #endif
 		optchar = parse_long_options(nargv, options, long_options,
-		    idx, 0, flags);
-		place = EMSG;
+		    idx, 0, flags, st);
+		st->place = EMSG;
 		return (optchar);
 	}
 	if (*++oli != ':') {			/* doesn't take argument */
-		if (!*place)
-			++optind;
+		if (!*st->place)
+			++st->optind;
 	} else {				/* takes (optional) argument */
-		optarg = NULL;
-		if (*place)			/* no white space */
-			optarg = place;
+		st->optarg = NULL;
+		if (*st->place)			/* no white space */
+			st->optarg = st->place;
 		else if (oli[1] != ':') {	/* arg not optional */
-			if (++optind >= nargc) {	/* no arg */
-				place = EMSG;
+			if (++st->optind >= nargc) {	/* no arg */
+				st->place = EMSG;
 				if (PRINT_ERROR)
 					warnx(recargchar, optchar);
-				optopt = optchar;
+				st->optopt = optchar;
 				return (BADARG);
 			} else
-				optarg = nargv[optind];
+				st->optarg = nargv[st->optind];
 		}
-		place = EMSG;
-		++optind;
+		st->place = EMSG;
+		++st->optind;
 	}
 	/* dump back option letter */
 	return (optchar);
 }
 
+/*
+ * getopt_global --
+ *	Run getopt_internal() on the state behind the getopt(3) external
+ *	variables.
+ */
+static int
+getopt_global(int nargc, char * const *nargv, const char *options,
+	const struct option *long_options, int *idx, int flags)
+{
+	int ret;
+
+	global_state.optind = optind;
+	global_state.opterr = opterr;
+	global_state.optopt = optopt;
+	global_state.optreset = optreset;
+	global_state.optarg = optarg;
+
+	ret = getopt_internal(nargc, nargv, options, long_options, idx,
+	    flags, &global_state);
+
+	optind = global_state.optind;
+	optopt = global_state.optopt;
+	optreset = global_state.optreset;
+	optarg = global_state.optarg;
+
+	return (ret);
+}
+
 /*
  * getopt --
  *	Parse argc/argv argument vector.
@@ -630,7 +674,7 @@ getopt(int nargc, char * const *nargv, const char *options)
 	 * before dropping privileges it makes sense to keep things
 	 * as simple (and bug-free) as possible.
 	 */
-	return (getopt_internal(nargc, nargv, options, NULL, NULL, 0));
+	return (getopt_global(nargc, nargv, options, NULL, NULL, 0));
 }
 
 /*
@@ -642,7 +686,7 @@ getopt_long(int nargc, char * const *nargv, const char *options,
 	const struct option *long_options, int *idx)
 {
 
-	return (getopt_internal(nargc, nargv, options, long_options, idx,
+	return (getopt_global(nargc, nargv, options, long_options, idx,
 	    FLAG_PERMUTE));
 }
 
@@ -655,8 +699,55 @@ getopt_long_only(int nargc, char * const *nargv, const char *options,
 	const struct option *long_options, int *idx)
 {
 
-	return (getopt_internal(nargc, nargv, options, long_options, idx,
+	return (getopt_global(nargc, nargv, options, long_options, idx,
 	    FLAG_PERMUTE|FLAG_LONGONLY));
 }
 
+/*
+ * arg_getopt_init --
+ *	Reset a caller owned scanner state before the first call of
+ *	getopt_long_r() or getopt_long_only_r().
+ */
+void
+arg_getopt_init(struct arg_parse_ctx *st)
+{
+
+	st->optind = 0;
+	st->opterr = 0;
+	st->optopt = '?';
+	st->optreset = 0;
+	st->optarg = NULL;
+	st->place = EMSG;
+	st->nonopt_start = -1;
+	st->nonopt_end = -1;
+	st->dash_prefix = -1;		/* NO_PREFIX */
+	st->posixly_correct = -1;
+}
+
+/*
+ * getopt_long_r --
+ *	Reentrant getopt_long(), all scanner state lives in *st.
+ */
+int
+getopt_long_r(int nargc, char * const *nargv, const char *options,
+	const struct option *long_options, int *idx, struct arg_parse_ctx *st)
+{
+
+	return (getopt_internal(nargc, nargv, options, long_options, idx,
+	    FLAG_PERMUTE, st));
+}
+
+/*
+ * getopt_long_only_r --
+ *	Reentrant getopt_long_only(), all scanner state lives in *st.
+ */
+int
+getopt_long_only_r(int nargc, char * const *nargv, const char *options,
+	const struct option *long_options, int *idx, struct arg_parse_ctx *st)
+{
+
+	return (getopt_internal(nargc, nargv, options, long_options, idx,
+	    FLAG_PERMUTE|FLAG_LONGONLY, st));
+}
+
 #endif /* ARG_REPLACE_GETOPT == 1 */
@@ -90,6 +90,15 @@ extern "C" {
 
 typedef unsigned int TRexBool;
 typedef struct TRex TRex;
+typedef struct TRexInst TRexInst;
+
+/* instruction of the linear time program, see trex_linearcompile */
+struct TRexInst {
+    int op;
+    int arg; /* character, class node, character class or word boundary kind */
+    short x; /* jump target */
+    short y; /* second jump target of a split */
+};
 
 typedef struct {
     const TRexChar* begin;
@@ -105,6 +114,7 @@ TREX_API TRex* trex_compile(const TRexChar* pattern, const TRexChar** error, int
 #endif
 TREX_API void trex_free(TRex* exp);
 TREX_API TRexBool trex_match(TRex* exp, const TRexChar* text);
+TREX_API TRexBool trex_match_r(const TRex* exp, const TRexChar* text, TRexMatch* matches);
 TREX_API TRexBool trex_search(TRex* exp, const TRexChar* text, const TRexChar** out_begin, const TRexChar** out_end);
 TREX_API TRexBool
 trex_searchrange(TRex* exp, const TRexChar* text_begin, const TRexChar* text_end, const TRexChar** out_begin, const TRexChar** out_end);
@@ -117,9 +127,16 @@ TREX_API TRexBool trex_getsubexp(TRex* exp, int n, TRexMatch* subexp);
 
 #endif
 
+static size_t trex_progsize(const TRex* exp);
+static TRex* trex_progcopy(const TRex* exp, void* mem);
+static int trex_linearcompile(const TRex* exp, TRexInst* insts, int cap);
+static TRexBool trex_linearmatch(const TRex* exp, const TRexInst* insts, const TRexChar* text);
+
 struct privhdr {
     const char* pattern;
     int flags;
+    const TRex* rex;       /* compiled program, NULL if the pattern is invalid */
+    const TRexInst* insts; /* linear time program if ARG_REX_LINEAR is set */
 };
 
 static void arg_rex_resetfn(struct arg_rex* parent) {
@@ -129,8 +146,6 @@ static void arg_rex_resetfn(struct arg_rex* parent) {
 
 static int arg_rex_scanfn(struct arg_rex* parent, const char* argval) {
     int errorcode = 0;
-    const TRexChar* error = NULL;
-    TRex* rex = NULL;
     TRexBool is_match = TRex_False;
 
     if (parent->count == parent->hdr.maxcount) {
@@ -146,15 +161,16 @@ static int arg_rex_scanfn(struct arg_rex* parent, const char* argval) {
 
         /* test the current argument value for a match with the regular expression */
         /* if a match is detected, record the argument value in the arg_rex struct */
+        /* the program was compiled once by arg_rexn, matching does not allocate */
 
-        rex = trex_compile(priv->pattern, &error, priv->flags);
-        is_match = trex_match(rex, argval);
+        if (priv->insts)
+            is_match = trex_linearmatch(priv->rex, priv->insts, argval);
+        else if (priv->rex)
+            is_match = trex_match_r(priv->rex, argval, NULL);
         if (!is_match)
             errorcode = ARG_ERR_REGNOMATCH;
         else
             parent->sval[parent->count++] = argval;
-
-        trex_free(rex);
     }
 
     ARG_TRACE(("%s:scanfn(%p) returns %d\n", __FILE__, parent, errorcode));
@@ -226,6 +242,8 @@ struct arg_rex* arg_rexn(const char* shortopts,
                          int flags,
                          const char* glossary) {
     size_t nbytes;
+    size_t progbytes = 0;
+    int ninsts = 0;
     struct arg_rex* result;
     struct privhdr* priv;
     int i;
@@ -241,9 +259,35 @@ struct arg_rex* arg_rexn(const char* shortopts,
     /* foolproof things by ensuring maxcount is not less than mincount */
     maxcount = (maxcount < mincount) ? mincount : maxcount;
 
+    /* compile the regular expression once, the program is kept for all later
+     * calls of arg_rex_scanfn. Compiling now also traps any regex errors here
+     * rather than later when an argument is actually parsed.
+     */
+    rex = trex_compile(pattern, &error, flags);
+    if (rex == NULL) {
+        ARG_LOG(("argtable: %s \"%s\"\n", error ? error : _TREXC("undefined"), pattern));
+        ARG_LOG(("argtable: Bad argument table.\n"));
+    } else {
+        progbytes = trex_progsize(rex);
+        if (flags & ARG_REX_LINEAR) {
+            ninsts = trex_linearcompile(rex, NULL, ARG_REX_LINEAR_MAX_INSTS);
+            if (ninsts < 0) {
+                ARG_LOG(("argtable: pattern too large for linear matching \"%s\"\n", pattern));
+                ARG_LOG(("argtable: Bad argument table.\n"));
+                trex_free(rex);
+                rex = NULL;
+                progbytes = 0;
+                ninsts = 0;
+            } else {
+                progbytes += (size_t)ninsts * sizeof(TRexInst);
+            }
+        }
+    }
+
     nbytes = sizeof(struct arg_rex)      /* storage for struct arg_rex */
              + sizeof(struct privhdr)    /* storage for private arg_rex data */
-             + (size_t)maxcount * sizeof(char*); /* storage for sval[maxcount] array */
+             + (size_t)maxcount * sizeof(char*) /* storage for sval[maxcount] array */
+             + progbytes;                /* storage for the compiled program */
 
     /* init the arg_hdr struct */
     result = (struct arg_rex*)xmalloc(nbytes);
@@ -265,6 +309,8 @@ struct arg_rex* arg_rexn(const char* shortopts,
     priv = (struct privhdr*)(result->hdr.priv);
     priv->pattern = pattern;
     priv->flags = flags;
+    priv->rex = NULL;
+    priv->insts = NULL;
 
     /* store the sval[maxcount] array immediately after the arg_rex_priv struct */
     result->sval = (const char**)(priv + 1);
@@ -274,16 +320,15 @@ struct arg_rex* arg_rexn(const char* shortopts,
     for (i = 0; i < maxcount; i++)
         result->sval[i] = "";
 
-    /* here we construct and destroy a regex representation of the regular
-     * expression for no other reason than to force any regex errors to be
-     * trapped now rather than later. If we don't, then errors may go undetected
-     * until an argument is actually parsed.
-     */
-
-    rex = trex_compile(priv->pattern, &error, priv->flags);
-    if (rex == NULL) {
-        ARG_LOG(("argtable: %s \"%s\"\n", error ? error : _TREXC("undefined"), priv->pattern));
-        ARG_LOG(("argtable: Bad argument table.\n"));
+    /* store the compiled program immediately after the sval[maxcount] array, it is
+     * released together with the arg_rex struct by arg_free/arg_freetable */
+    if (rex != NULL) {
+        priv->rex = trex_progcopy(rex, result->sval + maxcount);
+        if (ninsts > 0) {
+            TRexInst* insts = (TRexInst*)((const char*)priv->rex + trex_progsize(rex));
+            trex_linearcompile(rex, insts, ninsts);
+            priv->insts = insts;
+        }
     }
 
     trex_free(rex);
@@ -350,9 +395,20 @@ typedef struct tagTRexNode {
     int next;
 } TRexNode;
 
-struct TRex {
+/*
+ * Scratch state of one match run. It is kept apart from the compiled
+ * program so a program can be matched by several callers at once.
+ * _matches may be NULL if the caller is not interested in subexpressions.
+ */
+typedef struct {
     const TRexChar* _eol;
     const TRexChar* _bol;
+    TRexMatch* _matches;
+    int _currsubexp;
+} TRexState;
+
+struct TRex {
+    TRexState _state;
     const TRexChar* _p;
     int _first;
     int _op;
@@ -360,8 +416,6 @@ struct TRex {
     int _nallocated;
     int _nsize;
     int _nsubexpr;
-    TRexMatch* _matches;
-    int _currsubexp;
     void* _jmpbuf;
     const TRexChar** _error;
     int _flags;
@@ -503,7 +557,7 @@ static int trex_class(TRex* exp) {
     if (*exp->_p == ']')
         trex_error(exp, _SC("empty class"));
     chain = ret;
-    while (*exp->_p != ']' && exp->_p != exp->_eol) {
+    while (*exp->_p != ']' && exp->_p != exp->_state._eol) {
         if (*exp->_p == '-' && first != -1) {
             int r, t;
             if (*exp->_p++ == ']')
@@ -717,7 +771,7 @@ static TRexBool trex_matchcclass(int cclass, TRexChar c) {
     return TRex_False; /*cannot happen*/
 }
 
-static TRexBool trex_matchclass(TRex* exp, TRexNode* node, TRexChar c) {
+static TRexBool trex_matchclass(const TRex* exp, TRexNode* node, TRexChar c) {
     do {
         switch (node->type) {
             case OP_RANGE:
@@ -748,7 +802,7 @@ static TRexBool trex_matchclass(TRex* exp, TRexNode* node, TRexChar c) {
     return TRex_False;
 }
 
-static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar* str, TRexNode* next) {
+static const TRexChar* trex_matchnode(const TRex* exp, TRexState* st, TRexNode* node, const TRexChar* str, TRexNode* next) {
     TRexNodeType type = node->type;
     switch (type) {
         case OP_GREEDY: {
@@ -765,7 +819,7 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
 
             while ((nmaches == 0xFFFF || nmaches < p1)) {
                 const TRexChar* stop;
-                if ((s = trex_matchnode(exp, &exp->_nodes[node->left], s, greedystop)) == NULL)
+                if ((s = trex_matchnode(exp, st, &exp->_nodes[node->left], s, greedystop)) == NULL)
                     break;
                 nmaches++;
                 good = s;
@@ -779,7 +833,7 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
                         } else if (next && next->next != -1) {
                             gnext = &exp->_nodes[next->next];
                         }
-                        stop = trex_matchnode(exp, greedystop, s, gnext);
+                        stop = trex_matchnode(exp, st, greedystop, s, gnext);
                         if (stop) {
                             /* if satisfied stop it */
                             if (p0 == p1 && p0 == nmaches)
@@ -792,7 +846,7 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
                     }
                 }
 
-                if (s >= exp->_eol)
+                if (s >= st->_eol)
                     break;
             }
             if (p0 == p1 && p0 == nmaches)
@@ -806,7 +860,7 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
         case OP_OR: {
             const TRexChar* asd = str;
             TRexNode* temp = &exp->_nodes[node->left];
-            while ((asd = trex_matchnode(exp, temp, asd, NULL)) != NULL) {
+            while ((asd = trex_matchnode(exp, st, temp, asd, NULL)) != NULL) {
                 if (temp->next != -1)
                     temp = &exp->_nodes[temp->next];
                 else
@@ -814,7 +868,7 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
             }
             asd = str;
             temp = &exp->_nodes[node->right];
-            while ((asd = trex_matchnode(exp, temp, asd, NULL)) != NULL) {
+            while ((asd = trex_matchnode(exp, st, temp, asd, NULL)) != NULL) {
                 if (temp->next != -1)
                     temp = &exp->_nodes[temp->next];
                 else
@@ -828,10 +882,11 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
             TRexNode* n = &exp->_nodes[node->left];
             const TRexChar* cur = str;
             int capture = -1;
-            if (node->type != OP_NOCAPEXPR && node->right == exp->_currsubexp) {
-                capture = exp->_currsubexp;
-                exp->_matches[capture].begin = cur;
-                exp->_currsubexp++;
+            if (node->type != OP_NOCAPEXPR && node->right == st->_currsubexp) {
+                capture = st->_currsubexp;
+                if (st->_matches)
+                    st->_matches[capture].begin = cur;
+                st->_currsubexp++;
             }
 
             do {
@@ -841,31 +896,31 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
                 } else {
                     subnext = next;
                 }
-                if ((cur = trex_matchnode(exp, n, cur, subnext)) == NULL) {
-                    if (capture != -1) {
-                        exp->_matches[capture].begin = 0;
-                        exp->_matches[capture].len = 0;
+                if ((cur = trex_matchnode(exp, st, n, cur, subnext)) == NULL) {
+                    if (capture != -1 && st->_matches) {
+                        st->_matches[capture].begin = 0;
+                        st->_matches[capture].len = 0;
                     }
                     return NULL;
                 }
             } while ((n->next != -1) && ((n = &exp->_nodes[n->next]) != NULL));
 
-            if (capture != -1)
-                exp->_matches[capture].len = (int)(cur - exp->_matches[capture].begin);
+            if (capture != -1 && st->_matches)
+                st->_matches[capture].len = (int)(cur - st->_matches[capture].begin);
             return cur;
         }
         case OP_WB:
-            if ((str == exp->_bol && !isspace((int)(*str))) || (str == exp->_eol && !isspace((int)(*(str - 1)))) || (!isspace((int)(*str)) && isspace((int)(*(str + 1)))) ||
+            if ((str == st->_bol && !isspace((int)(*str))) || (str == st->_eol && !isspace((int)(*(str - 1)))) || (!isspace((int)(*str)) && isspace((int)(*(str + 1)))) ||
                 (isspace((int)(*str)) && !isspace((int)(*(str + 1))))) {
                 return (node->left == 'b') ? str : NULL;
             }
             return (node->left == 'b') ? NULL : str;
         case OP_BOL:
-            if (str == exp->_bol)
+            if (str == st->_bol)
                 return str;
             return NULL;
         case OP_EOL:
-            if (str == exp->_eol)
+            if (str == st->_eol)
                 return str;
             return NULL;
         case OP_DOT: {
@@ -899,15 +954,262 @@ static const TRexChar* trex_matchnode(TRex* exp, TRexNode* node, const TRexChar*
     }
 }
 
+/*
+ * Linear time matcher (ARG_REX_LINEAR)
+ *
+ * The node graph of a compiled TRex is translated into a Thompson NFA program
+ * which is simulated one input character at a time with a set of active
+ * states, see R. Cox, "Regular Expression Matching Can Be Simple And Fast".
+ * Matching is O(strlen(text) * program size) and uses a fixed amount of stack,
+ * there is no backtracking and no recursion. Counted repetitions are unrolled,
+ * patterns whose program exceeds ARG_REX_LINEAR_MAX_INSTS are rejected.
+ * Only the whole text is matched, subexpressions are not recorded.
+ */
+enum { TREX_I_CHAR, TREX_I_ANY, TREX_I_CLASS, TREX_I_NCLASS, TREX_I_CCLASS, TREX_I_SPLIT, TREX_I_JMP, TREX_I_BOL, TREX_I_EOL, TREX_I_WB, TREX_I_MATCH };
+
+typedef struct {
+    TRexInst* insts; /* NULL while the program size is counted */
+    int n;
+    int cap;
+} TRexEmit;
+
+static int trex_emit(TRexEmit* e, int op, int arg) {
+    int pc = e->n++;
+    if (e->insts && pc < e->cap) {
+        e->insts[pc].op = op;
+        e->insts[pc].arg = arg;
+        e->insts[pc].x = e->insts[pc].y = -1;
+    }
+    return pc;
+}
+
+static void trex_patch(TRexEmit* e, int pc, int x, int y) {
+    if (e->insts && pc < e->cap) {
+        e->insts[pc].x = (short)x;
+        e->insts[pc].y = (short)y;
+    }
+}
+
+static void trex_emitseq(const TRex* exp, TRexEmit* e, int node);
+
+static void trex_emitnode(const TRex* exp, TRexEmit* e, int node) {
+    const TRexNode* n = &exp->_nodes[node];
+    int i, split, jmp;
+
+    if (e->n > e->cap)
+        return;
+
+    switch (n->type) {
+        case OP_EXPR:
+        case OP_NOCAPEXPR:
+            trex_emitseq(exp, e, n->left);
+            break;
+        case OP_OR:
+            split = trex_emit(e, TREX_I_SPLIT, 0);
+            trex_emitseq(exp, e, n->left);
+            jmp = trex_emit(e, TREX_I_JMP, 0);
+            trex_patch(e, split, split + 1, e->n);
+            trex_emitseq(exp, e, n->right);
+            trex_patch(e, jmp, e->n, -1);
+            break;
+        case OP_GREEDY: {
+            int p0 = (n->right >> 16) & 0x0000FFFF, p1 = n->right & 0x0000FFFF;
+            for (i = 0; i < p0 && e->n <= e->cap; i++)
+                trex_emitnode(exp, e, n->left);
+            if (p1 == 0xFFFF) {
+                split = trex_emit(e, TREX_I_SPLIT, 0);
+                trex_emitnode(exp, e, n->left);
+                jmp = trex_emit(e, TREX_I_JMP, 0);
+                trex_patch(e, jmp, split, -1);
+                trex_patch(e, split, split + 1, e->n);
+            } else {
+                for (i = p0; i < p1 && e->n <= e->cap; i++) {
+                    split = trex_emit(e, TREX_I_SPLIT, 0);
+                    trex_emitnode(exp, e, n->left);
+                    trex_patch(e, split, split + 1, e->n);
+                }
+            }
+        } break;
+        case OP_BOL:
+            trex_emit(e, TREX_I_BOL, 0);
+            break;
+        case OP_EOL:
+            trex_emit(e, TREX_I_EOL, 0);
+            break;
+        case OP_WB:
+            trex_emit(e, TREX_I_WB, n->left);
+            break;
+        case OP_DOT:
+            trex_emit(e, TREX_I_ANY, 0);
+            break;
+        case OP_CLASS:
+            trex_emit(e, TREX_I_CLASS, n->left);
+            break;
+        case OP_NCLASS:
+            trex_emit(e, TREX_I_NCLASS, n->left);
+            break;
+        case OP_CCLASS:
+            trex_emit(e, TREX_I_CCLASS, n->left);
+            break;
+        default: /* char */
+            trex_emit(e, TREX_I_CHAR, n->type);
+            break;
+    }
+}
+
+static void trex_emitseq(const TRex* exp, TRexEmit* e, int node) {
+    while (node != -1 && e->n <= e->cap) {
+        trex_emitnode(exp, e, node);
+        node = exp->_nodes[node].next;
+    }
+}
+
+/*
+ * Translates exp into insts[cap] and returns the number of instructions, or -1
+ * if the program needs more than cap instructions. With insts == NULL only the
+ * size is computed.
+ */
+static int trex_linearcompile(const TRex* exp, TRexInst* insts, int cap) {
+    TRexEmit e;
+    e.insts = insts;
+    e.n = 0;
+    e.cap = cap;
+    trex_emitnode(exp, &e, exp->_first);
+    trex_emit(&e, TREX_I_MATCH, 0);
+    return (e.n > cap) ? -1 : e.n;
+}
+
+static TRexBool trex_iswordb(const TRexChar* bol, const TRexChar* eol, const TRexChar* str) {
+    if (str == eol)
+        return (str != bol && !isspace((int)(*(str - 1)))) ? TRex_True : TRex_False;
+    if (str == bol && !isspace((int)(*str)))
+        return TRex_True;
+    if (!isspace((int)(*str)) && isspace((int)(*(str + 1))))
+        return TRex_True;
+    return (isspace((int)(*str)) && !isspace((int)(*(str + 1)))) ? TRex_True : TRex_False;
+}
+
+typedef struct {
+    int n;
+    short pc[ARG_REX_LINEAR_MAX_INSTS];
+} TRexThreads;
+
+/*
+ * Adds pc and every state reachable from it without consuming a character to
+ * the list, assertions are evaluated at the position str. Each state is added
+ * only once per step, marked with the step number gen.
+ */
+static void trex_addthread(const TRexInst* insts,
+                           TRexThreads* list,
+                           unsigned int* mark,
+                           unsigned int gen,
+                           int pc,
+                           const TRexChar* bol,
+                           const TRexChar* eol,
+                           const TRexChar* str) {
+    short stack[ARG_REX_LINEAR_MAX_INSTS];
+    int sp = 0;
+
+    stack[sp++] = (short)pc;
+    while (sp > 0) {
+        pc = stack[--sp];
+        if (mark[pc] == gen)
+            continue;
+        mark[pc] = gen;
+        switch (insts[pc].op) {
+            case TREX_I_JMP:
+                stack[sp++] = insts[pc].x;
+                break;
+            case TREX_I_SPLIT:
+                stack[sp++] = insts[pc].y;
+                stack[sp++] = insts[pc].x;
+                break;
+            case TREX_I_BOL:
+                if (str == bol)
+                    stack[sp++] = (short)(pc + 1);
+                break;
+            case TREX_I_EOL:
+                if (str == eol)
+                    stack[sp++] = (short)(pc + 1);
+                break;
+            case TREX_I_WB:
+                if (trex_iswordb(bol, eol, str) == (insts[pc].arg == 'b' ? TRex_True : TRex_False))
+                    stack[sp++] = (short)(pc + 1);
+                break;
+            default:
+                list->pc[list->n++] = (short)pc;
+                break;
+        }
+    }
+}
+
+static TRexBool trex_linearstep(const TRex* exp, const TRexInst* inst, TRexChar c) {
+    switch (inst->op) {
+        case TREX_I_ANY:
+            return TRex_True;
+        case TREX_I_CLASS:
+            return trex_matchclass(exp, &exp->_nodes[inst->arg], c);
+        case TREX_I_NCLASS:
+            return trex_matchclass(exp, &exp->_nodes[inst->arg], c) ? TRex_False : TRex_True;
+        case TREX_I_CCLASS:
+            return trex_matchcclass(inst->arg, c);
+        case TREX_I_CHAR:
+            if (exp->_flags & TREX_ICASE)
+                return (c == tolower(inst->arg) || c == toupper(inst->arg)) ? TRex_True : TRex_False;
+            return (c == inst->arg) ? TRex_True : TRex_False;
+    }
+    return TRex_False;
+}
+
+/*
+ * Returns TRex_True if the whole text matches the program insts of exp.
+ */
+static TRexBool trex_linearmatch(const TRex* exp, const TRexInst* insts, const TRexChar* text) {
+    TRexThreads lists[2];
+    TRexThreads *clist = &lists[0], *nlist = &lists[1], *tmp;
+    unsigned int mark[ARG_REX_LINEAR_MAX_INSTS];
+    unsigned int gen = 1;
+    const TRexChar* bol = text;
+    const TRexChar* eol = text + scstrlen(text);
+    const TRexChar* str;
+    int i;
+
+    memset(mark, 0, sizeof(mark));
+    clist->n = 0;
+    trex_addthread(insts, clist, mark, gen, 0, bol, eol, bol);
+
+    for (str = bol; clist->n > 0; str++) {
+        if (str == eol) {
+            for (i = 0; i < clist->n; i++) {
+                if (insts[clist->pc[i]].op == TREX_I_MATCH)
+                    return TRex_True;
+            }
+            return TRex_False;
+        }
+
+        gen++;
+        nlist->n = 0;
+        for (i = 0; i < clist->n; i++) {
+            int pc = clist->pc[i];
+            if (insts[pc].op != TREX_I_MATCH && trex_linearstep(exp, &insts[pc], *str))
+                trex_addthread(insts, nlist, mark, gen, pc + 1, bol, eol, str + 1);
+        }
+        tmp = clist;
+        clist = nlist;
+        nlist = tmp;
+    }
+    return TRex_False;
+}
+
 /* public api */
 TRex* trex_compile(const TRexChar* pattern, const TRexChar** error, int flags) {
     TRex* exp = (TRex*)xmalloc(sizeof(TRex));
-    exp->_eol = exp->_bol = NULL;
+    exp->_state._eol = exp->_state._bol = NULL;
     exp->_p = pattern;
     exp->_nallocated = (int)(scstrlen(pattern) * sizeof(TRexChar));
     exp->_nodes = (TRexNode*)xmalloc((size_t)exp->_nallocated * sizeof(TRexNode));
     exp->_nsize = 0;
-    exp->_matches = 0;
+    exp->_state._matches = 0;
     exp->_nsubexpr = 0;
     exp->_first = trex_newnode(exp, OP_EXPR);
     exp->_error = error;
@@ -933,8 +1235,8 @@ TRex* trex_compile(const TRexChar* pattern, const TRexChar** error, int flags) {
             scprintf(_SC("\n"));
         }
 #endif
-        exp->_matches = (TRexMatch*)xmalloc((size_t)exp->_nsubexpr * sizeof(TRexMatch));
-        memset(exp->_matches, 0, (size_t)exp->_nsubexpr * sizeof(TRexMatch));
+        exp->_state._matches = (TRexMatch*)xmalloc((size_t)exp->_nsubexpr * sizeof(TRexMatch));
+        memset(exp->_state._matches, 0, (size_t)exp->_nsubexpr * sizeof(TRexMatch));
     } else {
         trex_free(exp);
         return NULL;
@@ -946,34 +1248,48 @@ void trex_free(TRex* exp) {
     if (exp) {
         xfree(exp->_nodes);
         xfree(exp->_jmpbuf);
-        xfree(exp->_matches);
+        xfree(exp->_state._matches);
         xfree(exp);
     }
 }
 
-TRexBool trex_match(TRex* exp, const TRexChar* text) {
+static TRexBool trex_matchstate(const TRex* exp, TRexState* st, const TRexChar* text) {
     const TRexChar* res = NULL;
-    exp->_bol = text;
-    exp->_eol = text + scstrlen(text);
-    exp->_currsubexp = 0;
-    res = trex_matchnode(exp, exp->_nodes, text, NULL);
-    if (res == NULL || res != exp->_eol)
+    st->_bol = text;
+    st->_eol = text + scstrlen(text);
+    st->_currsubexp = 0;
+    res = trex_matchnode(exp, st, exp->_nodes, text, NULL);
+    if (res == NULL || res != st->_eol)
         return TRex_False;
     return TRex_True;
 }
 
+TRexBool trex_match(TRex* exp, const TRexChar* text) {
+    return trex_matchstate(exp, &exp->_state, text);
+}
+
+/*
+ * Reentrant match, the program is not modified. The subexpressions are
+ * stored in matches[trex_getsubexpcount(exp)] unless matches is NULL.
+ */
+TRexBool trex_match_r(const TRex* exp, const TRexChar* text, TRexMatch* matches) {
+    TRexState st;
+    st._matches = matches;
+    return trex_matchstate(exp, &st, text);
+}
+
 TRexBool trex_searchrange(TRex* exp, const TRexChar* text_begin, const TRexChar* text_end, const TRexChar** out_begin, const TRexChar** out_end) {
     const TRexChar* cur = NULL;
     int node = exp->_first;
     if (text_begin >= text_end)
         return TRex_False;
-    exp->_bol = text_begin;
-    exp->_eol = text_end;
+    exp->_state._bol = text_begin;
+    exp->_state._eol = text_end;
     do {
         cur = text_begin;
         while (node != -1) {
-            exp->_currsubexp = 0;
-            cur = trex_matchnode(exp, &exp->_nodes[node], cur, NULL);
+            exp->_state._currsubexp = 0;
+            cur = trex_matchnode(exp, &exp->_state, &exp->_nodes[node], cur, NULL);
             if (!cur)
                 break;
             node = exp->_nodes[node].next;
@@ -993,6 +1309,31 @@ TRexBool trex_searchrange(TRex* exp, const TRexChar* text_begin, const TRexChar*
     return TRex_True;
 }
 
+/*
+ * Size of the read only part of a compiled program, see trex_progcopy.
+ */
+static size_t trex_progsize(const TRex* exp) {
+    return sizeof(TRex) + (size_t)exp->_nsize * sizeof(TRexNode);
+}
+
+/*
+ * Copies the read only part of a compiled program to mem, which must provide
+ * trex_progsize(exp) bytes with pointer alignment. The copy is used with
+ * trex_match_r only and must not be passed to trex_free.
+ */
+static TRex* trex_progcopy(const TRex* exp, void* mem) {
+    TRex* prog = (TRex*)mem;
+    memset(prog, 0, sizeof(TRex));
+    prog->_first = exp->_first;
+    prog->_nsize = exp->_nsize;
+    prog->_nallocated = exp->_nsize;
+    prog->_nsubexpr = exp->_nsubexpr;
+    prog->_flags = exp->_flags;
+    prog->_nodes = (TRexNode*)(prog + 1);
+    memcpy(prog->_nodes, exp->_nodes, (size_t)exp->_nsize * sizeof(TRexNode));
+    return prog;
+}
+
 TRexBool trex_search(TRex* exp, const TRexChar* text, const TRexChar** out_begin, const TRexChar** out_end) {
     return trex_searchrange(exp, text, text + scstrlen(text), out_begin, out_end);
 }
@@ -1004,6 +1345,6 @@ int trex_getsubexpcount(TRex* exp) {
 TRexBool trex_getsubexp(TRex* exp, int n, TRexMatch* subexp) {
     if (n < 0 || n >= exp->_nsubexpr)
         return TRex_False;
-    *subexp = exp->_matches[n];
+    *subexp = exp->_state._matches[n];
     return TRex_True;
 }
@@ -44,6 +44,18 @@
 static void panic(const char* fmt, ...);
 static arg_panicfn* s_panic = panic;
 
+/* number of heap allocations made by the library on the calling thread, see
+ * arg_alloc_count() */
+#if defined(_MSC_VER)
+static __declspec(thread) unsigned long s_alloc_count = 0;
+#elif defined(__GNUC__)
+static __thread unsigned long s_alloc_count = 0;
+#else
+static _Thread_local unsigned long s_alloc_count = 0;
+#endif
+
+#define arg_count_alloc() (s_alloc_count++)
+
 void dbg_printf(const char* fmt, ...) {
     va_list args;
     va_start(args, fmt);
@@ -79,8 +91,13 @@ void arg_set_panic(arg_panicfn* proc) {
     s_panic = proc;
 }
 
+unsigned long arg_alloc_count(void) {
+    return s_alloc_count;
+}
+
 void* xmalloc(size_t size) {
     void* ret = malloc(size);
+    arg_count_alloc();
     if (!ret) {
         s_panic("Out of memory!\n");
     }
@@ -91,6 +108,7 @@ void* xcalloc(size_t count, size_t size) {
     size_t allocated_count = count && size ? count : 1;
     size_t allocated_size = count && size ? size : 1;
     void* ret = calloc(allocated_count, allocated_size);
+    arg_count_alloc();
     if (!ret) {
         s_panic("Out of memory!\n");
     }
@@ -100,6 +118,7 @@ void* xcalloc(size_t count, size_t size) {
 void* xrealloc(void* ptr, size_t size) {
     size_t allocated_size = size ? size : 1;
     void* ret = realloc(ptr, allocated_size);
+    arg_count_alloc();
     if (!ret) {
         s_panic("Out of memory!\n");
     }
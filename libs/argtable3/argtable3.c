@@ -57,6 +57,39 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if ARG_REPLACE_GETOPT == 0
+/*
+ * The system getopt(3) has no reentrant interface. Its global scanner
+ * state is mirrored into the context, so arg_parse_r() is only reentrant
+ * with the embedded getopt (ARG_REPLACE_GETOPT == 1).
+ */
+static void arg_getopt_init(struct arg_parse_ctx* ctx) {
+    memset(ctx, 0, sizeof(*ctx));
+    optind = 0;
+    opterr = 0;
+}
+
+static void arg_getopt_mirror(struct arg_parse_ctx* ctx) {
+    ctx->optind = optind;
+    ctx->optopt = optopt;
+    ctx->optarg = optarg;
+}
+
+static int getopt_long_r(int argc, char* const* argv, const char* shortopts, const struct option* longopts, int* idx, struct arg_parse_ctx* ctx) {
+    int copt = getopt_long(argc, argv, shortopts, longopts, idx);
+    arg_getopt_mirror(ctx);
+    return copt;
+}
+
+#ifdef ARG_LONG_ONLY
+static int getopt_long_only_r(int argc, char* const* argv, const char* shortopts, const struct option* longopts, int* idx, struct arg_parse_ctx* ctx) {
+    int copt = getopt_long_only(argc, argv, shortopts, longopts, idx);
+    arg_getopt_mirror(ctx);
+    return copt;
+}
+#endif
+#endif
+
 static void arg_register_error(struct arg_end* end, void* parent, int error, const char* argval) {
     /* printf("arg_register_error(%p,%p,%d,%s)\n",end,parent,error,argval); */
     if (end->count < end->hdr.maxcount) {
@@ -90,6 +123,19 @@ struct longoptions {
     struct option* options;
 };
 
+/*
+ * Option tables of an argtable, built once by arg_compile() and kept in
+ * the private data of the table's arg_end entry. shortindex[] maps each
+ * short option char to the index of the first table entry accepting it
+ * (or -1), replacing the strchr() scan of find_shortoption().
+ */
+struct arg_compiled {
+    struct arg_hdr** table;
+    struct longoptions* longoptions;
+    char* shortoptions;
+    int shortindex[256];
+};
+
 #if 0
 static
 void dump_longoptions(struct longoptions * longoptions)
@@ -232,50 +278,110 @@ static int arg_endindex(struct arg_hdr** table) {
     return tabindex;
 }
 
-static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, struct arg_end* endtable) {
+static struct arg_compiled* arg_get_compiled(struct arg_hdr** table, struct arg_end* endtable) {
+    struct arg_compiled* compiled = (struct arg_compiled*)endtable->hdr.priv;
+    if (compiled && compiled->table == table)
+        return compiled;
+    return NULL;
+}
+
+static void arg_free_compiled(struct arg_hdr* hdr) {
+    struct arg_compiled* compiled = (struct arg_compiled*)hdr->priv;
+    if (compiled) {
+        xfree(compiled->shortoptions);
+        xfree(compiled->longoptions);
+        xfree(compiled);
+        hdr->priv = NULL;
+    }
+}
+
+int arg_compile(void** argtable) {
+    struct arg_hdr** table = (struct arg_hdr**)argtable;
+    struct arg_end* endtable;
+    struct arg_compiled* compiled;
+    int tabindex;
+    int i;
+
+    endtable = (struct arg_end*)table[arg_endindex(table)];
+
+    /* drop the tables of a previous compilation */
+    arg_free_compiled(&endtable->hdr);
+
+    compiled = (struct arg_compiled*)xmalloc(sizeof(struct arg_compiled));
+    compiled->table = table;
+    compiled->longoptions = alloc_longoptions(table);
+    compiled->shortoptions = alloc_shortoptions(table);
+
+    for (i = 0; i < 256; i++)
+        compiled->shortindex[i] = -1;
+    for (tabindex = 0; !(table[tabindex]->flag & ARG_TERMINATOR); tabindex++) {
+        const char* shortopts = table[tabindex]->shortopts;
+        while (shortopts && *shortopts) {
+            unsigned char c = (unsigned char)*shortopts++;
+            if (compiled->shortindex[c] == -1)
+                compiled->shortindex[c] = tabindex;
+        }
+    }
+
+    endtable->hdr.priv = compiled;
+    return 0;
+}
+
+void arg_uncompile(void** argtable) {
+    struct arg_hdr** table = (struct arg_hdr**)argtable;
+    arg_free_compiled(table[arg_endindex(table)]);
+}
+
+static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, struct arg_end* endtable, struct arg_parse_ctx* ctx) {
+    struct arg_compiled* compiled;
     struct longoptions* longoptions;
     char* shortoptions;
     int copt;
 
     /*printf("arg_parse_tagged(%d,%p,%p,%p)\n",argc,argv,table,endtable);*/
 
-    /* allocate short and long option arrays for the given opttable[].   */
-    /* if the allocs fail then put an error msg in the last table entry. */
-    longoptions = alloc_longoptions(table);
-    shortoptions = alloc_shortoptions(table);
+    /* use the option arrays built by arg_compile() if there are any,   */
+    /* else allocate short and long option arrays for the given table. */
+    compiled = arg_get_compiled(table, endtable);
+    if (compiled) {
+        longoptions = compiled->longoptions;
+        shortoptions = compiled->shortoptions;
+    } else {
+        longoptions = alloc_longoptions(table);
+        shortoptions = alloc_shortoptions(table);
+    }
 
     /*dump_longoptions(longoptions);*/
 
     /* reset getopts internal option-index to zero, and disable error reporting */
-    optind = 0;
-    opterr = 0;
+    arg_getopt_init(ctx);
 
     /* fetch and process args using getopt_long */
 #ifdef ARG_LONG_ONLY
-    while ((copt = getopt_long_only(argc, argv, shortoptions, longoptions->options, NULL)) != -1) {
+    while ((copt = getopt_long_only_r(argc, argv, shortoptions, longoptions->options, NULL, ctx)) != -1) {
 #else
-    while ((copt = getopt_long(argc, argv, shortoptions, longoptions->options, NULL)) != -1) {
+    while ((copt = getopt_long_r(argc, argv, shortoptions, longoptions->options, NULL, ctx)) != -1) {
 #endif
         /*
-           printf("optarg='%s'\n",optarg);
-           printf("optind=%d\n",optind);
+           printf("ctx->optarg='%s'\n",ctx->optarg);
+           printf("ctx->optind=%d\n",ctx->optind);
            printf("copt=%c\n",(char)copt);
-           printf("optopt=%c (%d)\n",optopt, (int)(optopt));
+           printf("ctx->optopt=%c (%d)\n",ctx->optopt, (int)(ctx->optopt));
          */
         switch (copt) {
             case 0: {
                 int tabindex = longoptions->getoptval;
                 void* parent = table[tabindex]->parent;
                 /*printf("long option detected from argtable[%d]\n", tabindex);*/
-                if (optarg && optarg[0] == 0 && (table[tabindex]->flag & ARG_HASVALUE)) {
-                    /* printf(": long option %s requires an argument\n",argv[optind-1]); */
-                    arg_register_error(endtable, endtable, ARG_EMISSARG, argv[optind - 1]);
+                if (ctx->optarg && ctx->optarg[0] == 0 && (table[tabindex]->flag & ARG_HASVALUE)) {
+                    /* printf(": long option %s requires an argument\n",argv[ctx->optind-1]); */
+                    arg_register_error(endtable, endtable, ARG_EMISSARG, argv[ctx->optind - 1]);
                     /* continue to scan the (empty) argument value to enforce argument count checking */
                 }
                 if (table[tabindex]->scanfn) {
-                    int errorcode = table[tabindex]->scanfn(parent, optarg);
+                    int errorcode = table[tabindex]->scanfn(parent, ctx->optarg);
                     if (errorcode != 0)
-                        arg_register_error(endtable, parent, errorcode, optarg);
+                        arg_register_error(endtable, parent, errorcode, ctx->optarg);
                 }
             } break;
 
@@ -285,14 +391,14 @@ static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, stru
                  * if it was a short option its value is in optopt
                  * if it was a long option then optopt=0
                  */
-                switch (optopt) {
+                switch (ctx->optopt) {
                     case 0:
-                        /*printf("?0 unrecognised long option %s\n",argv[optind-1]);*/
-                        arg_register_error(endtable, endtable, ARG_ELONGOPT, argv[optind - 1]);
+                        /*printf("?0 unrecognised long option %s\n",argv[ctx->optind-1]);*/
+                        arg_register_error(endtable, endtable, ARG_ELONGOPT, argv[ctx->optind - 1]);
                         break;
                     default:
-                        /*printf("?* unrecognised short option '%c'\n",optopt);*/
-                        arg_register_error(endtable, endtable, optopt, NULL);
+                        /*printf("?* unrecognised short option '%c'\n",ctx->optopt);*/
+                        arg_register_error(endtable, endtable, ctx->optopt, NULL);
                         break;
                 }
                 break;
@@ -301,13 +407,13 @@ static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, stru
                 /*
                  * getopt_long() found an option with its argument missing.
                  */
-                /*printf(": option %s requires an argument\n",argv[optind-1]); */
-                arg_register_error(endtable, endtable, ARG_EMISSARG, argv[optind - 1]);
+                /*printf(": option %s requires an argument\n",argv[ctx->optind-1]); */
+                arg_register_error(endtable, endtable, ARG_EMISSARG, argv[ctx->optind - 1]);
                 break;
 
             default: {
                 /* getopt_long() found a valid short option */
-                int tabindex = find_shortoption(table, (char)copt);
+                int tabindex = compiled ? compiled->shortindex[(unsigned char)copt] : find_shortoption(table, (char)copt);
                 /*printf("short option detected from argtable[%d]\n", tabindex);*/
                 if (tabindex == -1) {
                     /* should never get here - but handle it just in case */
@@ -316,9 +422,9 @@ static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, stru
                 } else {
                     if (table[tabindex]->scanfn) {
                         void* parent = table[tabindex]->parent;
-                        int errorcode = table[tabindex]->scanfn(parent, optarg);
+                        int errorcode = table[tabindex]->scanfn(parent, ctx->optarg);
                         if (errorcode != 0)
-                            arg_register_error(endtable, parent, errorcode, optarg);
+                            arg_register_error(endtable, parent, errorcode, ctx->optarg);
                     }
                 }
                 break;
@@ -326,11 +432,13 @@ static void arg_parse_tagged(int argc, char** argv, struct arg_hdr** table, stru
         }
     }
 
-    xfree(shortoptions);
-    xfree(longoptions);
+    if (!compiled) {
+        xfree(shortoptions);
+        xfree(longoptions);
+    }
 }
 
-static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, struct arg_end* endtable) {
+static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, struct arg_end* endtable, struct arg_parse_ctx* ctx) {
     int tabindex = 0;
     int errorlast = 0;
     const char* optarglast = NULL;
@@ -342,7 +450,7 @@ static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, st
         int errorcode;
 
         /* if we have exhausted our argv[optind] entries then we have finished */
-        if (optind >= argc) {
+        if (ctx->optind >= argc) {
             /*printf("arg_parse_untagged(): argv[] exhausted\n");*/
             return;
         }
@@ -365,11 +473,11 @@ static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, st
         /* table[tabindex] entry. If it succeeds then keep it, otherwise */
         /* try again with the next table[] entry.                        */
         parent = table[tabindex]->parent;
-        errorcode = table[tabindex]->scanfn(parent, argv[optind]);
+        errorcode = table[tabindex]->scanfn(parent, argv[ctx->optind]);
         if (errorcode == 0) {
             /* success, move onto next argv[optind] but stay with same table[tabindex] */
             /*printf("arg_parse_untagged(): argtable[%d] successfully matched\n",tabindex);*/
-            optind++;
+            ctx->optind++;
 
             /* clear the last tentative error */
             errorlast = 0;
@@ -380,7 +488,7 @@ static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, st
 
             /* remember this as a tentative error we may wish to reinstate later */
             errorlast = errorcode;
-            optarglast = argv[optind];
+            optarglast = argv[ctx->optind];
             parentlast = parent;
         }
     }
@@ -388,14 +496,14 @@ static void arg_parse_untagged(int argc, char** argv, struct arg_hdr** table, st
     /* if a tenative error still remains at this point then register it as a proper error */
     if (errorlast) {
         arg_register_error(endtable, parentlast, errorlast, optarglast);
-        optind++;
+        ctx->optind++;
     }
 
     /* only get here when not all argv[] entries were consumed */
     /* register an error for each unused argv[] entry */
-    while (optind < argc) {
-        /*printf("arg_parse_untagged(): argv[%d]=\"%s\" not consumed\n",optind,argv[optind]);*/
-        arg_register_error(endtable, endtable, ARG_ENOMATCH, argv[optind++]);
+    while (ctx->optind < argc) {
+        /*printf("arg_parse_untagged(): argv[%d]=\"%s\" not consumed\n",ctx->optind,argv[ctx->optind]);*/
+        arg_register_error(endtable, endtable, ARG_ENOMATCH, argv[ctx->optind++]);
     }
 
     return;
@@ -425,9 +533,19 @@ static void arg_reset(void** argtable) {
 }
 
 int arg_parse(int argc, char** argv, void** argtable) {
+    struct arg_parse_ctx ctx;
+    return arg_parse_r(argc, argv, argtable, &ctx);
+}
+
+int arg_parse_r(int argc, char** argv, void** argtable, arg_parse_ctx_t* ctx) {
+    return arg_parse_rbuf(argc, argv, argtable, ctx, NULL, 0);
+}
+
+int arg_parse_rbuf(int argc, char** argv, void** argtable, arg_parse_ctx_t* ctx, char** argvbuf, int argvbuflen) {
     struct arg_hdr** table = (struct arg_hdr**)argtable;
     struct arg_end* endtable;
     int endindex;
+    char* argvstack[ARG_PARSE_STACK_ARGC + 1];
     char** argvcopy = NULL;
     int i;
 
@@ -451,7 +569,14 @@ int arg_parse(int argc, char** argv, void** argtable) {
         return endtable->count;
     }
 
-    argvcopy = (char**)xmalloc(sizeof(char*) * (size_t)(argc + 1));
+    /* the copy goes to the caller's buffer if it fits, short command lines */
+    /* are copied on the stack, so parsing does not allocate                */
+    if (argvbuf != NULL && argc < argvbuflen)
+        argvcopy = argvbuf;
+    else if (argc <= ARG_PARSE_STACK_ARGC)
+        argvcopy = argvstack;
+    else
+        argvcopy = (char**)xmalloc(sizeof(char*) * (size_t)(argc + 1));
 
     /*
         Fill in the local copy of argv[]. We need a local copy
@@ -464,17 +589,18 @@ int arg_parse(int argc, char** argv, void** argtable) {
     argvcopy[argc] = NULL;
 
     /* parse the command line (local copy) for tagged options */
-    arg_parse_tagged(argc, argvcopy, table, endtable);
+    arg_parse_tagged(argc, argvcopy, table, endtable, ctx);
 
     /* parse the command line (local copy) for untagged options */
-    arg_parse_untagged(argc, argvcopy, table, endtable);
+    arg_parse_untagged(argc, argvcopy, table, endtable, ctx);
 
     /* if no errors so far then perform post-parse checks otherwise dont bother */
     if (endtable->count == 0)
         arg_parse_check(table, endtable);
 
     /* release the local copt of argv[] */
-    xfree(argvcopy);
+    if (argvcopy != argvstack && argvcopy != argvbuf)
+        xfree(argvcopy);
 
     return endtable->count;
 }
@@ -852,10 +978,22 @@ void arg_print_glossary_ds(arg_dstr_t ds, void** argtable, const char* format) {
 }
 
 void arg_print_glossary(FILE* fp, void** argtable, const char* format) {
-    arg_dstr_t ds = arg_dstr_create();
-    arg_print_glossary_ds(ds, argtable, format);
-    fputs(arg_dstr_cstr(ds), fp);
-    arg_dstr_destroy(ds);
+    struct arg_hdr** table = (struct arg_hdr**)argtable;
+    int tabindex;
+
+    /* printed entry by entry to fp, so no dynamic string is allocated */
+    format = format ? format : "  %-20s %s\n";
+    for (tabindex = 0; !(table[tabindex]->flag & ARG_TERMINATOR); tabindex++) {
+        if (table[tabindex]->glossary) {
+            char syntax[200] = "";
+            const char* shortopts = table[tabindex]->shortopts;
+            const char* longopts = table[tabindex]->longopts;
+            const char* datatype = table[tabindex]->datatype;
+            const char* glossary = table[tabindex]->glossary;
+            arg_cat_optionv(syntax, sizeof(syntax) - 1, shortopts, longopts, datatype, table[tabindex]->flag & ARG_HASOPTVALUE, ", ");
+            fprintf(fp, format, syntax, glossary);
+        }
+    }
 }
 
 /**
@@ -866,7 +1004,22 @@ void arg_print_glossary(FILE* fp, void** argtable, const char* format) {
  *
  * See description of arg_print_formatted below.
  */
-static void arg_print_formatted_ds(arg_dstr_t ds, const unsigned lmargin, const unsigned rmargin, const char* text) {
+/* output of arg_print_formatted_out(), either the dynamic string ds or the stream fp */
+static void arg_out_cat(arg_dstr_t ds, FILE* fp, const char* str) {
+    if (ds)
+        arg_dstr_cat(ds, str);
+    else
+        fputs(str, fp);
+}
+
+static void arg_out_catc(arg_dstr_t ds, FILE* fp, char c) {
+    if (ds)
+        arg_dstr_catc(ds, c);
+    else
+        fputc(c, fp);
+}
+
+static void arg_print_formatted_out(arg_dstr_t ds, FILE* fp, const unsigned lmargin, const unsigned rmargin, const char* text) {
     const unsigned int textlen = (unsigned int)strlen(text);
     unsigned int line_start = 0;
     unsigned int line_end = textlen;
@@ -876,7 +1029,8 @@ static void arg_print_formatted_ds(arg_dstr_t ds, const unsigned lmargin, const
 
     /* Someone doesn't like us... */
     if (line_end < line_start) {
-        arg_dstr_catf(ds, "%s\n", text);
+        arg_out_cat(ds, fp, text);
+        arg_out_cat(ds, fp, "\n");
     }
 
     while (line_end > line_start) {
@@ -920,17 +1074,17 @@ static void arg_print_formatted_ds(arg_dstr_t ds, const unsigned lmargin, const
                 break;
             }
 
-            arg_dstr_catc(ds, c);
+            arg_out_catc(ds, fp, c);
             line_start++;
         }
-        arg_dstr_cat(ds, "\n");
+        arg_out_cat(ds, fp, "\n");
 
         /* Initialize another line */
         if (line_end < textlen) {
             unsigned i;
 
             for (i = 0; i < lmargin; i++) {
-                arg_dstr_cat(ds, " ");
+                arg_out_cat(ds, fp, " ");
             }
 
             line_end = textlen;
@@ -971,10 +1125,7 @@ static void arg_print_formatted_ds(arg_dstr_t ds, const unsigned lmargin, const
  * Author: Uli Fouquet
  */
 void arg_print_formatted(FILE* fp, const unsigned lmargin, const unsigned rmargin, const char* text) {
-    arg_dstr_t ds = arg_dstr_create();
-    arg_print_formatted_ds(ds, lmargin, rmargin, text);
-    fputs(arg_dstr_cstr(ds), fp);
-    arg_dstr_destroy(ds);
+    arg_print_formatted_out(NULL, fp, lmargin, rmargin, text);
 }
 
 /**
@@ -1013,7 +1164,7 @@ void arg_print_glossary_gnu_ds(arg_dstr_t ds, void** argtable) {
             }
 
             arg_dstr_catf(ds, "  %-25s ", syntax);
-            arg_print_formatted_ds(ds, 28, 79, glossary);
+            arg_print_formatted_out(ds, NULL, 28, 79, glossary);
         }
     } /* for each table entry */
 
@@ -1076,6 +1227,8 @@ void arg_free(void** argtable) {
             break;
 
         flag = table[tabindex]->flag;
+        if (flag & ARG_TERMINATOR)
+            arg_free_compiled(table[tabindex]);
         xfree(table[tabindex]);
         table[tabindex++] = NULL;
 
@@ -1091,6 +1244,8 @@ void arg_freetable(void** argtable, size_t n) {
         if (table[tabindex] == NULL)
             continue;
 
+        if (table[tabindex]->flag & ARG_TERMINATOR)
+            arg_free_compiled(table[tabindex]);
         xfree(table[tabindex]);
         table[tabindex] = NULL;
     };
@@ -41,6 +41,17 @@ extern "C" {
 #endif
 
 #define ARG_REX_ICASE 1
+#define ARG_REX_LINEAR 2
+
+/* Number of arguments arg_parse() copies on the stack instead of the heap */
+#ifndef ARG_PARSE_STACK_ARGC
+#define ARG_PARSE_STACK_ARGC 16
+#endif /* ARG_PARSE_STACK_ARGC */
+
+/* Maximum program size of a regular expression matched with ARG_REX_LINEAR */
+#ifndef ARG_REX_LINEAR_MAX_INSTS
+#define ARG_REX_LINEAR_MAX_INSTS 256
+#endif /* ARG_REX_LINEAR_MAX_INSTS */
 
 /* Maximum length of the command name */
 #ifndef ARG_CMD_NAME_LEN
@@ -168,6 +179,26 @@ typedef struct arg_end {
     const char** argval; /* Array of pointers to offending argv[] string */
 } arg_end_t;
 
+/*
+ * The arg_parse_ctx struct holds the complete option scanner state of one
+ * arg_parse_r() call, i.e. what getopt(3) otherwise keeps in the global
+ * optind, opterr, optopt and optarg variables. It is owned by the caller,
+ * so several threads can parse their own argtables concurrently.
+ * The members are private to the library, arg_parse_r() initialises them.
+ */
+typedef struct arg_parse_ctx {
+    int optind;         /* index into parent argv vector */
+    int opterr;         /* if error message should be printed */
+    int optopt;         /* character checked for validity */
+    int optreset;       /* reset getopt */
+    char* optarg;       /* argument associated with option */
+    char* place;        /* option letter processing */
+    int nonopt_start;   /* first non option argument (for permute) */
+    int nonopt_end;     /* first option after non options (for permute) */
+    int dash_prefix;    /* prefix of the current long option */
+    int posixly_correct; /* POSIXLY_CORRECT set in the environment */
+} arg_parse_ctx_t;
+
 typedef struct arg_cmd_info {
     char name[ARG_CMD_NAME_LEN];
     char description[ARG_CMD_DESCRIPTION_LEN];
@@ -221,7 +252,13 @@ ARG_EXTERN struct arg_end* arg_end(int maxcount);
 
 /**** other functions *******************************************/
 ARG_EXTERN int arg_nullcheck(void** argtable);
+ARG_EXTERN int arg_compile(void** argtable);
+ARG_EXTERN void arg_uncompile(void** argtable);
 ARG_EXTERN int arg_parse(int argc, char** argv, void** argtable);
+ARG_EXTERN int arg_parse_r(int argc, char** argv, void** argtable, arg_parse_ctx_t* ctx);
+/* as arg_parse_r(), argv is copied to argvbuf if it holds argc + 1 entries */
+ARG_EXTERN int arg_parse_rbuf(int argc, char** argv, void** argtable, arg_parse_ctx_t* ctx, char** argvbuf, int argvbuflen);
+ARG_EXTERN unsigned long arg_alloc_count(void);
 ARG_EXTERN void arg_print_option(FILE* fp, const char* shortopts, const char* longopts, const char* datatype, const char* suffix);
 ARG_EXTERN void arg_print_syntax(FILE* fp, void** argtable, const char* suffix);
 ARG_EXTERN void arg_print_syntaxv(FILE* fp, void** argtable, const char* suffix);
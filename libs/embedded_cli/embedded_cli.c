@@ -4,6 +4,7 @@
  *    https://en.wikipedia.org/wiki/ANSI_escape_code
  */
 
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -14,21 +15,60 @@
 #define CLEAR_EOL "\x1b[0K"
 #define MOVE_BOL "\x1b[1G"
 
-static void cli_putchar(struct embedded_cli *cli, char ch, bool is_last)
+static void cli_flush(struct embedded_cli *cli)
 {
-    if (cli->put_char) {
+    if (cli->out_len == 0)
+        return;
+    if (cli->write) {
+        cli->write(cli->cb_data, cli->out_buf, cli->out_len);
+    } else if (cli->put_char) {
+        for (int i = 0; i < cli->out_len; i++)
+            cli->put_char(cli->cb_data, cli->out_buf[i],
+                          i == cli->out_len - 1);
+    }
+    cli->out_len = 0;
+}
+
+static void cli_write(struct embedded_cli *cli, const char *s, size_t len)
+{
+    if (!cli->write && !cli->put_char)
+        return;
+    while (len > 0) {
+        size_t space = sizeof(cli->out_buf) - cli->out_len;
+        size_t count = 0;
+
+        if (space < 2) {
+            cli_flush(cli);
+            continue;
+        }
+        // Copy everything up to the next newline in one go
+        while (count < len && count < space - 1 && s[count] != '\n')
+            count++;
+        memcpy(&cli->out_buf[cli->out_len], s, count);
+        cli->out_len += count;
+        s += count;
+        len -= count;
+        if (len > 0 && *s == '\n') {
+            if (sizeof(cli->out_buf) - cli->out_len < 2)
+                cli_flush(cli);
 #if EMBEDDED_CLI_SERIAL_XLATE
-        if (ch == '\n')
-            cli->put_char(cli->cb_data, '\r', false);
+            cli->out_buf[cli->out_len++] = '\r';
 #endif
-        cli->put_char(cli->cb_data, ch, is_last);
+            cli->out_buf[cli->out_len++] = '\n';
+            s++;
+            len--;
+        }
     }
 }
 
+static void cli_putchar(struct embedded_cli *cli, char ch)
+{
+    cli_write(cli, &ch, 1);
+}
+
 static void cli_puts(struct embedded_cli *cli, const char *s)
 {
-    for (; *s; s++)
-        cli_putchar(cli, *s, s[1] == '\0');
+    cli_write(cli, s, strlen(s));
 }
 
 static void embedded_cli_reset_line(struct embedded_cli *cli)
@@ -40,6 +80,7 @@ static void embedded_cli_reset_line(struct embedded_cli *cli)
 #if EMBEDDED_CLI_HISTORY_LEN
     cli->history_pos = -1;
     cli->searching = false;
+    cli->search_pos = 0;
 #endif
 }
 
@@ -55,9 +96,50 @@ void embedded_cli_init(struct embedded_cli *cli, const char *prompt,
         cli->prompt[sizeof(cli->prompt) - 1] = '\0';
     }
 
+    embedded_cli_set_buffers(cli, NULL, 0, NULL, 0);
+}
+
+void embedded_cli_set_buffers(struct embedded_cli *cli, char *line,
+                              size_t line_size, char **argv, int max_argc)
+{
+    if (line && line_size >= 2 && line_size <= INT_MAX) {
+        cli->buffer = line;
+        cli->buffer_size = line_size;
+    } else {
+        cli->buffer = cli->line_buffer;
+        cli->buffer_size = sizeof(cli->line_buffer);
+    }
+    if (argv && max_argc >= 1) {
+        cli->argv = argv;
+        cli->max_argc = max_argc;
+    } else {
+        cli->argv = cli->argv_buffer;
+        cli->max_argc = EMBEDDED_CLI_MAX_ARGC;
+    }
+
+    cli->buffer[0] = '\0';
+    cli->done = false;
     embedded_cli_reset_line(cli);
 }
 
+void embedded_cli_set_write(struct embedded_cli *cli,
+                            void (*write)(void *data, const char *buf,
+                                          size_t len))
+{
+    cli_flush(cli);
+    cli->write = write;
+}
+
+void embedded_cli_set_complete(struct embedded_cli *cli,
+                               void (*complete)(void *data,
+                                                struct embedded_cli *cli,
+                                                const char *line, int cursor),
+                               void *data)
+{
+    cli->complete = complete;
+    cli->complete_data = data;
+}
+
 static void cli_ansi(struct embedded_cli *cli, int n, char code)
 {
     char buffer[5] = {'\x1b', '[', '0' + (n % 10), code, '\0'};
@@ -87,27 +169,70 @@ static void term_backspace(struct embedded_cli *cli, int n)
 {
     // printf("backspace %d ('%s': %d)\n", n, cli->buffer, cli->done);
     while (n--)
-        cli_putchar(cli, '\b', n == 0);
+        cli_putchar(cli, '\b');
 }
 
+#if EMBEDDED_CLI_HISTORY_SIGNATURE
+/**
+ * One bit per hashed pair of neighbouring characters. Every entry holding
+ * the query has all bits of the query signature set.
+ */
+static uint32_t embedded_cli_signature(const char *s)
+{
+    uint32_t sig = 0;
+
+    for (; s[0] && s[1]; s++)
+        sig |= 1UL << ((((unsigned char)s[0] * 31U) ^ (unsigned char)s[1]) & 31U);
+    return sig;
+}
+#endif
+
 static const char *embedded_cli_get_history_search(struct embedded_cli *cli)
 {
-    for (int i = 0;; i++) {
-        const char *h = embedded_cli_get_history(cli, i);
-        if (!h)
-            return NULL;
-        if (strstr(h, cli->buffer))
+    return embedded_cli_get_history(cli, cli->search_pos);
+}
+
+/**
+ * Finds the newest entry from history position `start` on which holds the
+ * search query. search_pos is left alone if there is none.
+ */
+static const char *embedded_cli_search_from(struct embedded_cli *cli,
+                                            int start)
+{
+#if EMBEDDED_CLI_HISTORY_SIGNATURE
+    uint32_t sig = embedded_cli_signature(cli->buffer);
+#endif
+
+    for (int i = start; i < cli->history_count; i++) {
+        int slot = (cli->history_first + cli->history_count - 1 - i) %
+                   EMBEDDED_CLI_HISTORY_MAX;
+#if EMBEDDED_CLI_HISTORY_SIGNATURE
+        if ((cli->history_sig[slot] & sig) != sig)
+            continue;
+#endif
+        const char *h = &cli->history[cli->history_index[slot]];
+        if (strstr(h, cli->buffer)) {
+            cli->search_pos = i;
             return h;
+        }
     }
     return NULL;
 }
+
+static void embedded_cli_show_search(struct embedded_cli *cli)
+{
+    cli_puts(cli, MOVE_BOL CLEAR_EOL "search:");
+    const char *h = embedded_cli_get_history_search(cli);
+    if (h)
+        cli_puts(cli, h);
+}
 #endif
 
 static void embedded_cli_insert_default_char(struct embedded_cli *cli,
                                              char ch)
 {
     // If the buffer is full, there's nothing we can do
-    if (cli->len >= (int)sizeof(cli->buffer) - 1)
+    if (cli->len >= (int)cli->buffer_size - 1)
         return;
     // Insert a gap in the buffer for the new character
     memmove(&cli->buffer[cli->cursor + 1], &cli->buffer[cli->cursor],
@@ -119,11 +244,11 @@ static void embedded_cli_insert_default_char(struct embedded_cli *cli,
 
 #if EMBEDDED_CLI_HISTORY_LEN
     if (cli->searching) {
-        cli_puts(cli, MOVE_BOL CLEAR_EOL "search:");
-        const char *h = embedded_cli_get_history_search(cli);
-        if (h)
-            cli_puts(cli, h);
-
+        // Newer entries did not hold the shorter query, so they cannot hold
+        // this one either
+        if (!embedded_cli_search_from(cli, cli->search_pos))
+            cli->search_pos = cli->history_count;
+        embedded_cli_show_search(cli);
     } else
 #endif
     {
@@ -136,22 +261,13 @@ const char *embedded_cli_get_history(struct embedded_cli *cli,
                                      int history_pos)
 {
 #if EMBEDDED_CLI_HISTORY_LEN
-    int pos = 0;
-
-    if (history_pos < 0)
+    if (history_pos < 0 || history_pos >= cli->history_count)
         return NULL;
 
-    // Search back through the history buffer for `history_pos` entry
-    for (int i = 0; i < history_pos; i++) {
-        int len = strlen(&cli->history[pos]);
-        if (len == 0)
-            return NULL;
-        pos += len + 1;
-        if (pos == sizeof(cli->history))
-            return NULL;
-    }
-
-    return &cli->history[pos];
+    // The newest entry is the last one of the index ring
+    int slot = (cli->history_first + cli->history_count - 1 - history_pos) %
+               EMBEDDED_CLI_HISTORY_MAX;
+    return &cli->history[cli->history_index[slot]];
 #else
     (void)cli;
     (void)history_pos;
@@ -160,28 +276,71 @@ const char *embedded_cli_get_history(struct embedded_cli *cli,
 }
 
 #if EMBEDDED_CLI_HISTORY_LEN
-static void embedded_cli_extend_history(struct embedded_cli *cli)
-{
-    int len = strlen(cli->buffer);
-    if (len > 0) {
-        // If the new entry is the same as the most recent history entry,
-        // then don't insert it
-        if (strcmp(cli->buffer, cli->history) == 0)
-            return;
-        memmove(&cli->history[len + 1], &cli->history[0],
-                sizeof(cli->history) - len + 1);
-        memcpy(cli->history, cli->buffer, len + 1);
-        // Make sure it's always nul terminated
-        cli->history[sizeof(cli->history) - 1] = '\0';
+static void embedded_cli_drop_history(struct embedded_cli *cli)
+{
+    cli->history_first = (cli->history_first + 1) % EMBEDDED_CLI_HISTORY_MAX;
+    cli->history_count--;
+}
+
+static void embedded_cli_extend_history(struct embedded_cli *cli,
+                                        const char *line)
+{
+    int len = strlen(line);
+    int size = len + 1;
+    int pos;
+
+    if (len == 0 || size > (int)sizeof(cli->history))
+        return;
+    // If the new entry is the same as the most recent history entry,
+    // then don't insert it
+    const char *newest = embedded_cli_get_history(cli, 0);
+    if (newest && strcmp(line, newest) == 0)
+        return;
+
+    if (cli->history_count == EMBEDDED_CLI_HISTORY_MAX)
+        embedded_cli_drop_history(cli);
+
+    // Drop the oldest entries until the new one fits in one piece, either
+    // behind the newest entry or at the start of the ring
+    for (;;) {
+        if (cli->history_count == 0) {
+            pos = 0;
+            break;
+        }
+        int tail = cli->history_index[cli->history_first];
+        if (cli->history_head > tail) {
+            if ((int)sizeof(cli->history) - cli->history_head >= size) {
+                pos = cli->history_head;
+                break;
+            }
+            if (tail >= size) {
+                pos = 0;
+                break;
+            }
+        } else if (tail - cli->history_head >= size) {
+            pos = cli->history_head;
+            break;
+        }
+        embedded_cli_drop_history(cli);
     }
+
+    int slot = (cli->history_first + cli->history_count) %
+               EMBEDDED_CLI_HISTORY_MAX;
+    memcpy(&cli->history[pos], line, size);
+    cli->history_index[slot] = (embedded_cli_history_off_t)pos;
+#if EMBEDDED_CLI_HISTORY_SIGNATURE
+    cli->history_sig[slot] = embedded_cli_signature(line);
+#endif
+    cli->history_count++;
+    cli->history_head = pos + size;
 }
 
 static void embedded_cli_stop_search(struct embedded_cli *cli, bool print)
 {
     const char *h = embedded_cli_get_history_search(cli);
     if (h) {
-        strncpy(cli->buffer, h, sizeof(cli->buffer));
-        cli->buffer[sizeof(cli->buffer) - 1] = '\0';
+        strncpy(cli->buffer, h, cli->buffer_size);
+        cli->buffer[cli->buffer_size - 1] = '\0';
     } else
         cli->buffer[0] = '\0';
     cli->len = cli->cursor = strlen(cli->buffer);
@@ -194,7 +353,20 @@ static void embedded_cli_stop_search(struct embedded_cli *cli, bool print)
 }
 #endif
 
-bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
+void embedded_cli_add_history(struct embedded_cli *cli, const char *line)
+{
+#if EMBEDDED_CLI_HISTORY_LEN
+    // Entries are limited to what can be recalled into the line buffer
+    if (strlen(line) >= cli->buffer_size)
+        return;
+    embedded_cli_extend_history(cli, line);
+#else
+    (void)cli;
+    (void)line;
+#endif
+}
+
+static bool embedded_cli_process_char(struct embedded_cli *cli, char ch)
 {
     // If we're inserting a character just after a finished line, clear things
     // up
@@ -222,8 +394,8 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
                     cli->history_pos++;
                     // printf("history up %d = '%s'\n", cli->history_pos,
                     // line);
-                    strncpy(cli->buffer, line, sizeof(cli->buffer));
-                    cli->buffer[sizeof(cli->buffer) - 1] = '\0';
+                    strncpy(cli->buffer, line, cli->buffer_size);
+                    cli->buffer[cli->buffer_size - 1] = '\0';
                     cli->len = len;
                     cli->cursor = len;
                     cli_puts(cli, cli->buffer);
@@ -250,8 +422,8 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
                     cli->history_pos--;
                     // printf("history down %d = '%s'\n",
                     // cli->history_pos, line);
-                    strncpy(cli->buffer, line, sizeof(cli->buffer));
-                    cli->buffer[sizeof(cli->buffer) - 1] = '\0';
+                    strncpy(cli->buffer, line, cli->buffer_size);
+                    cli->buffer[cli->buffer_size - 1] = '\0';
                     cli->len = len;
                     cli->cursor = len;
                     cli_puts(cli, cli->buffer);
@@ -360,9 +532,25 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
             if (!cli->searching) {
                 cli_puts(cli, "\nsearch:");
                 cli->searching = true;
+                if (!embedded_cli_search_from(cli, 0))
+                    cli->search_pos = cli->history_count;
+            } else if (embedded_cli_search_from(cli, cli->search_pos + 1)) {
+                // Repeated Ctrl-R cycles to the next older match
+                embedded_cli_show_search(cli);
             }
 #endif
             break;
+        case '\t':
+            if (!cli->complete) {
+                embedded_cli_insert_default_char(cli, ch);
+                break;
+            }
+#if EMBEDDED_CLI_HISTORY_LEN
+            if (cli->searching)
+                embedded_cli_stop_search(cli, true);
+#endif
+            cli->complete(cli->complete_data, cli, cli->buffer, cli->cursor);
+            break;
         case '\x1b':
 #if EMBEDDED_CLI_HISTORY_LEN
             if (cli->searching)
@@ -384,7 +572,7 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
 #endif
             // fallthrough
         case '\n':
-            cli_putchar(cli, '\n', true);
+            cli_putchar(cli, '\n');
             break;
         default:
             if (ch > 0)
@@ -397,7 +585,7 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
 #if EMBEDDED_CLI_HISTORY_LEN
         if (cli->searching)
             embedded_cli_stop_search(cli, false);
-        embedded_cli_extend_history(cli);
+        embedded_cli_extend_history(cli, cli->buffer);
 #endif
         embedded_cli_reset_line(cli);
     }
@@ -405,6 +593,106 @@ bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
     return cli->done;
 }
 
+bool embedded_cli_insert_char(struct embedded_cli *cli, char ch)
+{
+    bool done = embedded_cli_process_char(cli, ch);
+    cli_flush(cli);
+    return done;
+}
+
+static bool is_printable(char ch)
+{
+    return (ch >= ' ' && ch <= '~');
+}
+
+static void embedded_cli_append_run(struct embedded_cli *cli, const char *s,
+                                    size_t len)
+{
+    int start = cli->len;
+    int space = (int)cli->buffer_size - 1 - cli->len;
+
+    if (cli->done) {
+        cli->buffer[0] = '\0';
+        cli->done = false;
+    }
+    // Characters which don't fit are dropped, same as in
+    // embedded_cli_insert_default_char
+    if ((int)len < space)
+        space = (int)len;
+    if (space <= 0)
+        return;
+    memcpy(&cli->buffer[cli->len], s, space);
+    cli->len += space;
+    cli->cursor = cli->len;
+    cli->buffer[cli->len] = '\0';
+    cli_puts(cli, &cli->buffer[start]);
+}
+
+size_t embedded_cli_insert_buffer(struct embedded_cli *cli, const char *buf,
+                                  size_t len)
+{
+    size_t pos = 0;
+
+    while (pos < len) {
+        size_t run = 0;
+
+        // Plain typing at the end of the line can be appended in one block,
+        // everything else goes through the character state machine
+        if (!cli->have_escape && !cli->have_csi && cli->cursor == cli->len
+#if EMBEDDED_CLI_HISTORY_LEN
+            && !cli->searching
+#endif
+        ) {
+            while (pos + run < len && is_printable(buf[pos + run]))
+                run++;
+        }
+
+        if (run > 0) {
+            embedded_cli_append_run(cli, &buf[pos], run);
+            pos += run;
+        } else if (embedded_cli_process_char(cli, buf[pos++])) {
+            break;
+        }
+    }
+    // All echo of this block goes out as one update
+    cli_flush(cli);
+    return pos;
+}
+
+void embedded_cli_insert_text(struct embedded_cli *cli, const char *s,
+                              size_t len)
+{
+    int space = (int)cli->buffer_size - 1 - cli->len;
+
+    if (len < (size_t)space)
+        space = (int)len;
+    if (space <= 0)
+        return;
+    // Open a gap at the cursor and echo the rest of the line once
+    memmove(&cli->buffer[cli->cursor + space], &cli->buffer[cli->cursor],
+            cli->len - cli->cursor);
+    memcpy(&cli->buffer[cli->cursor], s, space);
+    cli->len += space;
+    cli->buffer[cli->len] = '\0';
+    cli_puts(cli, &cli->buffer[cli->cursor]);
+    cli->cursor += space;
+    term_cursor_back(cli, cli->len - cli->cursor);
+}
+
+void embedded_cli_print(struct embedded_cli *cli, const char *s, size_t len)
+{
+    cli_write(cli, s, len);
+}
+
+void embedded_cli_redraw(struct embedded_cli *cli)
+{
+    // A finished line is still in the buffer, but its length is reset
+    cli_puts(cli, cli->prompt);
+    cli_write(cli, cli->buffer, cli->len);
+    term_cursor_back(cli, cli->len - cli->cursor);
+    cli_flush(cli);
+}
+
 const char *embedded_cli_get_line(const struct embedded_cli *cli)
 {
     if (!cli->done)
@@ -417,85 +705,137 @@ static bool is_whitespace(char ch)
     return (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r');
 }
 
-int embedded_cli_argc(struct embedded_cli *cli, char ***argv)
+int embedded_cli_tokenize_spans(char *buffer, size_t size, char **argv,
+                                struct embedded_cli_token *tokens,
+                                int max_argc)
 {
+    // Quotes and escapes are dropped by copying each kept character from the
+    // read cursor r down to the write cursor w, so the line is only passed
+    // once. w never overtakes r.
+    size_t r = 0;
+    size_t w = 0;
     int pos = 0;
     bool in_arg = false;
-    bool in_escape = false;
     char in_string = '\0';
-    if (!cli->done)
+
+    if (max_argc < 1)
         return 0;
-    for (size_t i = 0; i < sizeof(cli->buffer) && cli->buffer[i] != '\0';
-         i++) {
 
-        // If we're escaping this character, just absorb it regardless
-        if (in_escape) {
-            in_escape = false;
-            continue;
-        }
+    for (; r < size && buffer[r] != '\0'; r++) {
+        char ch = buffer[r];
 
         if (in_string) {
-            // If we're finishing a string, blank it out
-            if (cli->buffer[i] == in_string) {
-                memmove(&cli->buffer[i], &cli->buffer[i + 1],
-                        sizeof(cli->buffer) - i - 1);
+            // The closing quote is dropped, anything else is kept as it is
+            if (ch == in_string)
                 in_string = '\0';
-                i--;
-            }
+            else
+                buffer[w++] = ch;
             continue;
         }
 
-        // Skip over whitespace, and replace it with nul terminators so
-        // each argv is nul terminated
-        if (is_whitespace(cli->buffer[i])) {
-            if (in_arg)
-                cli->buffer[i] = '\0';
+        // Whitespace ends the current argument, the first whitespace after
+        // it becomes its nul terminator
+        if (is_whitespace(ch)) {
+            if (in_arg) {
+                if (tokens)
+                    tokens[pos - 1].len = w - tokens[pos - 1].offset;
+                buffer[w++] = '\0';
+            }
             in_arg = false;
             continue;
         }
 
         if (!in_arg) {
-            if (pos >= EMBEDDED_CLI_MAX_ARGC) {
+            // Keep one entry for the terminating NULL
+            if (pos >= max_argc - 1)
                 break;
+            argv[pos] = &buffer[w];
+            if (tokens) {
+                tokens[pos].offset = w;
+                tokens[pos].quoted = false;
             }
-            cli->argv[pos] = &cli->buffer[i];
             pos++;
             in_arg = true;
         }
 
-        if (cli->buffer[i] == '\\') {
-            // Absorb the escape character
-            memmove(&cli->buffer[i], &cli->buffer[i + 1],
-                    sizeof(cli->buffer) - i - 1);
-            i--;
-            in_escape = true;
+        if (ch == '\\') {
+            // Drop the escape character and keep the next one, whatever it is
+            if (r + 1 < size && buffer[r + 1] != '\0')
+                buffer[w++] = buffer[++r];
+            if (tokens)
+                tokens[pos - 1].quoted = true;
+        } else if (ch == '\'' || ch == '"') {
+            in_string = ch;
+            if (tokens)
+                tokens[pos - 1].quoted = true;
+        } else {
+            buffer[w++] = ch;
         }
+    }
 
-        // If we're starting a new string, absorb the character and shuffle
-        // things back
-        if (cli->buffer[i] == '\'' || cli->buffer[i] == '"') {
-            in_string = cli->buffer[i];
-            memmove(&cli->buffer[i], &cli->buffer[i + 1],
-                    sizeof(cli->buffer) - i - 1);
-            i--;
-        }
+    if (in_arg) {
+        // A line filling the whole buffer without a nul has no room left
+        if (w >= size)
+            w = size - 1;
+        if (tokens)
+            tokens[pos - 1].len = w - tokens[pos - 1].offset;
+        buffer[w] = '\0';
     }
+
     // Traditionally, there is a NULL entry at argv[argc].
-    if (pos >= EMBEDDED_CLI_MAX_ARGC) {
-        pos--;
-    }
-    cli->argv[pos] = NULL;
+    argv[pos] = NULL;
 
-    *argv = cli->argv;
     return pos;
 }
 
+int embedded_cli_tokenize(char *buffer, size_t size, char **argv)
+{
+    return embedded_cli_tokenize_spans(buffer, size, argv, NULL,
+                                       EMBEDDED_CLI_MAX_ARGC);
+}
+
+int embedded_cli_argc(struct embedded_cli *cli, char ***argv)
+{
+    return embedded_cli_argc_spans(cli, argv, NULL);
+}
+
+int embedded_cli_argc_spans(struct embedded_cli *cli, char ***argv,
+                            struct embedded_cli_token *tokens)
+{
+    if (!cli->done)
+        return 0;
+
+    *argv = cli->argv;
+    return embedded_cli_tokenize_spans(cli->buffer, cli->buffer_size,
+                                       cli->argv, tokens, cli->max_argc);
+}
+
 void embedded_cli_prompt(struct embedded_cli *cli)
 {
     cli_puts(cli, cli->prompt);
+    cli_flush(cli);
 }
 
 void embedded_cli_response(struct embedded_cli *cli, const char *s)
 {
-    cli_puts(cli, s);
-}
\ No newline at end of file
+    embedded_cli_response_write(cli, s, strlen(s));
+}
+
+void embedded_cli_response_write(struct embedded_cli *cli, const char *s,
+                                 size_t len)
+{
+    cli_write(cli, s, len);
+    cli_flush(cli);
+}
+
+void embedded_cli_response_raw(struct embedded_cli *cli, const char *s,
+                               size_t len)
+{
+    cli_flush(cli);
+    if (cli->write) {
+        cli->write(cli->cb_data, s, len);
+    } else if (cli->put_char) {
+        for (size_t i = 0; i < len; i++)
+            cli->put_char(cli->cb_data, s[i], i == len - 1);
+    }
+}
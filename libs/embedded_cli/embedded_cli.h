@@ -2,6 +2,8 @@
 #define EMBEDDED_CLI
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 
 #ifndef EMBEDDED_CLI_MAX_LINE
 /**
@@ -18,6 +20,49 @@
 #define EMBEDDED_CLI_HISTORY_LEN 1000
 #endif
 
+#if EMBEDDED_CLI_HISTORY_LEN
+#ifndef EMBEDDED_CLI_HISTORY_MAX
+/**
+ * Maximum number of history entries. The entry index is taken from the
+ * EMBEDDED_CLI_HISTORY_LEN bytes, the rest holds the text of the entries.
+ * The default of one entry per 8 bytes, 125 entries for the default
+ * length, leaves about 6 bytes of text per entry, so a history of short
+ * commands is limited by the text and not by the index. Define a smaller
+ * value if the commands are long and the index shall take less memory.
+ */
+#define EMBEDDED_CLI_HISTORY_MAX (EMBEDDED_CLI_HISTORY_LEN / 8)
+#endif
+
+#if EMBEDDED_CLI_HISTORY_MAX < 1
+#error "EMBEDDED_CLI_HISTORY_LEN is too small for the history index"
+#endif
+
+#ifndef EMBEDDED_CLI_HISTORY_SIGNATURE
+/**
+ * Keep a 32 bit bigram signature per history entry, so the reverse search
+ * (Ctrl-R) skips most entries without a string compare. Costs 4 bytes per
+ * entry of the EMBEDDED_CLI_HISTORY_LEN budget, worth it for large
+ * histories.
+ */
+#define EMBEDDED_CLI_HISTORY_SIGNATURE 0
+#endif
+
+#if EMBEDDED_CLI_HISTORY_LEN > UINT16_MAX
+typedef uint32_t embedded_cli_history_off_t;
+#else
+typedef uint16_t embedded_cli_history_off_t;
+#endif
+
+/**
+ * Number of bytes for the text of the history entries
+ */
+#define EMBEDDED_CLI_HISTORY_TEXT_LEN                                          \
+    (EMBEDDED_CLI_HISTORY_LEN -                                                \
+     EMBEDDED_CLI_HISTORY_MAX *                                                \
+         (sizeof(embedded_cli_history_off_t) +                                 \
+          (EMBEDDED_CLI_HISTORY_SIGNATURE ? sizeof(uint32_t) : 0)))
+#endif
+
 #ifndef EMBEDDED_CLI_MAX_ARGC
 /**
  * What is the maximum number of arguments we reserve space for
@@ -25,6 +70,13 @@
 #define EMBEDDED_CLI_MAX_ARGC 16
 #endif
 
+/**
+ * Number of argv entries, including the terminating NULL entry, which is
+ * enough for any line of size bytes. Arguments are never cut off with an
+ * argv of this size.
+ */
+#define EMBEDDED_CLI_ARGC_FOR_LINE(size) ((size) / 2 + 1)
+
 #ifndef EMBEDDED_CLI_MAX_PROMPT_LEN
 /**
  * Maximum number of bytes in the prompt
@@ -40,6 +92,14 @@
 #define EMBEDDED_CLI_SERIAL_XLATE 1
 #endif
 
+#ifndef EMBEDDED_CLI_OUT_BUF_LEN
+/**
+ * Number of output bytes collected before they are passed to the output
+ * callback. Output is also passed on at the end of every update.
+ */
+#define EMBEDDED_CLI_OUT_BUF_LEN 128
+#endif
+
 /**
  * This is the structure which defines the current state of the CLI
  * NOTE: Although this structure is exposed here, it is not recommended
@@ -49,16 +109,46 @@
  */
 struct embedded_cli {
     /**
-     * Internal buffer. This should not be accessed directly, use the
-     * access functions below
+     * Line buffer of buffer_size bytes, line_buffer or the memory passed to
+     * embedded_cli_set_buffers. This should not be accessed directly, use
+     * the access functions below
+     */
+    char *buffer;
+    size_t buffer_size;
+
+    /**
+     * Argument vector of max_argc entries, argv_buffer or the memory passed
+     * to embedded_cli_set_buffers
      */
-    char buffer[EMBEDDED_CLI_MAX_LINE];
+    char **argv;
+    int max_argc;
 
 #if EMBEDDED_CLI_HISTORY_LEN
     /**
-     * List of history entries
+     * Text of the history entries, a ring of nul terminated strings. An
+     * entry never wraps, it starts at the beginning of the ring instead.
+     */
+    char history[EMBEDDED_CLI_HISTORY_TEXT_LEN];
+
+    /**
+     * Ring of the entry offsets into history, oldest entry first
+     */
+    embedded_cli_history_off_t history_index[EMBEDDED_CLI_HISTORY_MAX];
+
+    /**
+     * Position of the oldest entry in history_index, number of entries and
+     * the offset behind the newest entry
      */
-    char history[EMBEDDED_CLI_HISTORY_LEN];
+    int history_first;
+    int history_count;
+    int history_head;
+
+#if EMBEDDED_CLI_HISTORY_SIGNATURE
+    /**
+     * Bigram signature of every entry, same slots as history_index
+     */
+    uint32_t history_sig[EMBEDDED_CLI_HISTORY_MAX];
+#endif
 
     /**
      * Are we searching through the history?
@@ -69,6 +159,13 @@ struct embedded_cli {
      * How far back in the history are we?
      */
     int history_pos;
+
+    /**
+     * History position of the current search match, history_count if
+     * nothing matches. A longer query continues from here, Ctrl-R goes on
+     * with the older entries.
+     */
+    int search_pos;
 #endif
 
     /**
@@ -94,10 +191,30 @@ struct embedded_cli {
     void (*put_char)(void *data, char ch, bool is_last);
 
     /**
-     * Data to provide to the put_char callback
+     * Optional callback function to output a block of characters to the
+     * user. If set, it is used instead of put_char.
+     */
+    void (*write)(void *data, const char *buf, size_t len);
+
+    /**
+     * Data to provide to the put_char/write callback
      */
     void *cb_data;
 
+    /**
+     * Optional callback to complete the line when Tab is pressed, see
+     * @ref embedded_cli_set_complete
+     */
+    void (*complete)(void *data, struct embedded_cli *cli, const char *line,
+                     int cursor);
+    void *complete_data;
+
+    /**
+     * Output collected during the current update
+     */
+    char out_buf[EMBEDDED_CLI_OUT_BUF_LEN];
+    int out_len;
+
     bool have_escape;
     bool have_csi;
 
@@ -106,9 +223,14 @@ struct embedded_cli {
      */
     int counter;
 
-    char *argv[EMBEDDED_CLI_MAX_ARGC];
-
     char prompt[EMBEDDED_CLI_MAX_PROMPT_LEN];
+
+    /**
+     * Internal line buffer and argument vector, used unless larger ones are
+     * passed in
+     */
+    char line_buffer[EMBEDDED_CLI_MAX_LINE];
+    char *argv_buffer[EMBEDDED_CLI_MAX_ARGC];
 };
 
 /**
@@ -118,6 +240,66 @@ void embedded_cli_init(struct embedded_cli *, const char *prompt,
                        void (*put_char)(void *data, char ch, bool is_last),
                        void *cb_data);
 
+/**
+ * Replaces the line buffer and the argument vector, e.g. to accept long
+ * lines with many arguments on some instances only, without sizing
+ * EMBEDDED_CLI_MAX_LINE for the worst case. The memory must stay valid
+ * while the CLI is used, the current line is discarded.
+ * @param line line buffer of line_size bytes, NULL selects the internal
+ * buffer of EMBEDDED_CLI_MAX_LINE bytes
+ * @param argv argument vector of max_argc entries, see
+ * EMBEDDED_CLI_ARGC_FOR_LINE, NULL selects the internal one of
+ * EMBEDDED_CLI_MAX_ARGC entries
+ */
+void embedded_cli_set_buffers(struct embedded_cli *cli, char *line,
+                              size_t line_size, char **argv, int max_argc);
+
+/**
+ * Sets the block output callback. All output of one update (echo, ANSI
+ * sequences, prompt, response) is collected and passed to this callback
+ * instead of calling put_char once per character.
+ */
+void embedded_cli_set_write(struct embedded_cli *cli,
+                            void (*write)(void *data, const char *buf,
+                                          size_t len));
+
+/**
+ * Sets the completion callback. It is called when Tab is pressed and
+ * completes the line with @ref embedded_cli_insert_text, candidates can be
+ * shown with @ref embedded_cli_print followed by @ref embedded_cli_redraw.
+ * Without a callback Tab is inserted like any other character.
+ * @param complete called with the line and the cursor position, the line
+ * must not be changed directly
+ * @param data passed to the callback
+ */
+void embedded_cli_set_complete(struct embedded_cli *cli,
+                               void (*complete)(void *data,
+                                                struct embedded_cli *cli,
+                                                const char *line, int cursor),
+                               void *data);
+
+/**
+ * Inserts text at the cursor and echoes it, as if it was typed. Characters
+ * which do not fit into the line buffer are dropped.
+ */
+void embedded_cli_insert_text(struct embedded_cli *cli, const char *s,
+                              size_t len);
+
+/**
+ * Outputs text while a line is edited, e.g. the candidates of a
+ * completion. The text is passed on with the rest of the update, the line
+ * is shown again with @ref embedded_cli_redraw.
+ */
+void embedded_cli_print(struct embedded_cli *cli, const char *s, size_t len);
+
+/**
+ * Outputs the prompt and the line being edited and moves the terminal
+ * cursor to the cursor position, e.g. after @ref embedded_cli_print or
+ * when a command which ran while the line was edited is done. After a
+ * finished line only the prompt is shown.
+ */
+void embedded_cli_redraw(struct embedded_cli *cli);
+
 /**
  * Adds a new character into the buffer. Returns true if
  * the buffer should now be processed
@@ -125,18 +307,84 @@ void embedded_cli_init(struct embedded_cli *, const char *prompt,
  */
 bool embedded_cli_insert_char(struct embedded_cli *cli, char ch);
 
+/**
+ * Adds a block of characters into the buffer. Processing stops after the
+ * first completed line, so the line can be processed before the remaining
+ * bytes are passed in again. Runs of printable characters typed at the end
+ * of the line are appended and echoed in one go.
+ * Note: This function should not be called from an interrupt handler.
+ * @return number of bytes consumed from buf, the line is complete if
+ * @ref embedded_cli_get_line returns non NULL afterwards
+ */
+size_t embedded_cli_insert_buffer(struct embedded_cli *cli, const char *buf,
+                                  size_t len);
+
 /**
  * Returns the nul terminated internal buffer. This will
  * return NULL if the buffer is not yet complete
  */
 const char *embedded_cli_get_line(const struct embedded_cli *cli);
 
+/**
+ * Position of one argument in the tokenized line
+ */
+struct embedded_cli_token {
+    /**
+     * Offset of the first character in the line, the argument is nul
+     * terminated after tokenizing
+     */
+    size_t offset;
+    /**
+     * Number of characters of the argument after removing quotes and escapes
+     */
+    size_t len;
+    /**
+     * The argument contained quotes or escapes, e.g. "" is an empty but
+     * quoted argument
+     */
+    bool quoted;
+};
+
 /**
  * Parses the internal buffer and returns it as an argc/argc combo
- * @return number of values in argv (maximum of EMBEDDED_CLI_MAX_ARGC)
+ * @return number of values in argv (maximum of EMBEDDED_CLI_MAX_ARGC - 1,
+ * or of the argv size passed to @ref embedded_cli_set_buffers minus one)
  */
 int embedded_cli_argc(struct embedded_cli *cli, char ***argv);
 
+/**
+ * Splits a nul terminated line into arguments in place, with the same
+ * quoting and escaping rules as @ref embedded_cli_argc. The line does not
+ * need to come from the line editor.
+ * @param buffer line to split, modified in place
+ * @param size size of buffer
+ * @param argv receives the arguments, room for EMBEDDED_CLI_MAX_ARGC entries
+ * @return number of values in argv (maximum of EMBEDDED_CLI_MAX_ARGC - 1)
+ */
+int embedded_cli_tokenize(char *buffer, size_t size, char **argv);
+
+/**
+ * Parses the internal buffer like @ref embedded_cli_argc and also returns
+ * the position of each argument
+ * @param tokens receives one entry per argument, room for as many entries
+ * as argv has, may be NULL
+ * @return number of values in argv
+ */
+int embedded_cli_argc_spans(struct embedded_cli *cli, char ***argv,
+                            struct embedded_cli_token *tokens);
+
+/**
+ * Splits a line like @ref embedded_cli_tokenize in one pass, quotes and
+ * escapes are removed by moving the rest of the argument down in place
+ * @param tokens receives the position of each argument, may be NULL
+ * @param max_argc number of entries of argv, including the terminating
+ * NULL entry, and of tokens
+ * @return number of values in argv (maximum of max_argc - 1)
+ */
+int embedded_cli_tokenize_spans(char *buffer, size_t size, char **argv,
+                                struct embedded_cli_token *tokens,
+                                int max_argc);
+
 /**
  * Outputs the CLI prompt
  * This should be called after @ref embedded_cli_argc or @ref
@@ -151,6 +399,22 @@ void embedded_cli_prompt(struct embedded_cli *cli);
  */
 void embedded_cli_response(struct embedded_cli *cli, const char *s);
 
+/**
+ * Outputs a chunk of the CLI response with a known length
+ * The chunk is passed on immediately, so a long response can be sent in
+ * several pieces while the command is still processed
+ */
+void embedded_cli_response_write(struct embedded_cli *cli, const char *s,
+                                 size_t len);
+
+/**
+ * Outputs a chunk of the CLI response as it is, without the newline
+ * translation of the terminal output. Used when the output is not a
+ * terminal, e.g. in batch mode.
+ */
+void embedded_cli_response_raw(struct embedded_cli *cli, const char *s,
+                               size_t len);
+
 /**
  * Retrieve a history command line
  * @param history_pos 0 is the most recent command, 1 is the one before that
@@ -160,4 +424,12 @@ void embedded_cli_response(struct embedded_cli *cli, const char *s);
 const char *embedded_cli_get_history(struct embedded_cli *cli,
                                      int history_pos);
 
+/**
+ * Adds a line to the history as if it was entered, e.g. to restore a saved
+ * history at start up. Empty lines, lines which do not fit into the line
+ * buffer and a repeat of the most recent entry are ignored.
+ * @param line nul terminated line without line feed
+ */
+void embedded_cli_add_history(struct embedded_cli *cli, const char *line);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,422 @@
+/****************************************************************************************
+* FILENAME :        wscmdgen.c
+*
+* SHORT DESCRIPTION:
+*   Build time generator of the perfect hash of a command table
+*
+* DETAILED DESCRIPTION :
+*   Reads the WSCMD lines of a command definition file and writes a header with the
+*   slot of every command and the seeds of the minimal perfect hash, see wscmdtab.h.
+*   The commands are grouped into buckets by their name hash, the largest buckets
+*   are placed first and each bucket gets the first seed which moves all of its
+*   commands to free slots. The program runs on the build host.
+*
+*   usage: wscmdgen <commands.def> <commands_hash.h>
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "wscmdtab.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Longest accepted line of the definition file and command name
+ */
+#define MAX_LINE 4096
+#define MAX_NAME 256
+
+/**
+ * The seeds and slots of the table are stored as 16 bit values
+ */
+#define MAX_COMMANDS 65535U
+#define MAX_SEED 65535U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Command of the definition file
+ */
+typedef struct genCmd_tag
+{
+    char name_ca[MAX_NAME];
+    uint32_t hash_u32;
+    size_t bucket_u;
+    size_t slot_u;
+}genCmd_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static bool ReadDefinition_bol(const char *path_cpc);
+static bool Search_bol(size_t buckets_u);
+static bool PlaceBucket_bol(size_t bucket_u, uint16_t *seed_pu16);
+static int CompareBuckets_i(const void *a_pv, const void *b_pv);
+static bool WriteHeader_bol(const char *path_cpc, const char *defPath_cpc, size_t buckets_u);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Commands in the order of the definition file
+ */
+static genCmd_t *cmds_psts = NULL;
+static size_t cmdCount_us = 0;
+
+/**
+ * Search state: seed and size of every bucket, the bucket order and the used slots
+ */
+static uint16_t *seeds_pu16s = NULL;
+static size_t *bucketSize_pus = NULL;
+static size_t *bucketOrder_pus = NULL;
+static bool *slotUsed_pbols = NULL;
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Entry point of the generator
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    size_t buckets_u;
+
+    if(argc != 3)
+    {
+        fprintf(stderr, "usage: %s <commands.def> <commands_hash.h>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if(!ReadDefinition_bol(argv[1]))
+        return EXIT_FAILURE;
+
+    /* about two commands per bucket, more buckets are used if no seed is found */
+    for(buckets_u = (cmdCount_us + 1U) / 2U; buckets_u <= cmdCount_us; buckets_u++)
+    {
+        if(Search_bol(buckets_u))
+            break;
+    }
+
+    if(buckets_u > cmdCount_us)
+    {
+        fprintf(stderr, "%s: no perfect hash found\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    if(!WriteHeader_bol(argv[2], argv[1], buckets_u))
+        return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads the command names of the WSCMD lines of the definition file
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    path of the definition file
+ * @return  true if at least one command was read and all names are valid and unique
+*//*------------------------------------------------------------------------------------*/
+static bool ReadDefinition_bol(const char *path_cpc)
+{
+    char line_ca[MAX_LINE];
+    size_t lineNo_u = 0;
+    size_t capacity_u = 0;
+    size_t len_u;
+    size_t idx_u;
+    char *pos_pc;
+    genCmd_t *grow_pst;
+    FILE *def_fp = fopen(path_cpc, "r");
+
+    if(def_fp == NULL)
+    {
+        perror(path_cpc);
+        return false;
+    }
+
+    while(fgets(line_ca, sizeof(line_ca), def_fp) != NULL)
+    {
+        lineNo_u++;
+        pos_pc = line_ca;
+        while(isspace((unsigned char)*pos_pc))
+            pos_pc++;
+
+        /* comments, blank lines and other preprocessor lines are left to the compiler */
+        if(strncmp(pos_pc, "WSCMD(", 6) != 0)
+            continue;
+
+        pos_pc += 6;
+        while(isspace((unsigned char)*pos_pc))
+            pos_pc++;
+
+        len_u = 0;
+        while(isalnum((unsigned char)pos_pc[len_u]) || (pos_pc[len_u] == '_'))
+            len_u++;
+
+        if((len_u == 0) || (len_u >= MAX_NAME) || isdigit((unsigned char)pos_pc[0]))
+        {
+            fprintf(stderr, "%s:%zu: command name must be a C identifier\n",
+                        path_cpc, lineNo_u);
+            fclose(def_fp);
+            return false;
+        }
+
+        if(cmdCount_us >= MAX_COMMANDS)
+        {
+            fprintf(stderr, "%s:%zu: too many commands\n", path_cpc, lineNo_u);
+            fclose(def_fp);
+            return false;
+        }
+
+        if(cmdCount_us == capacity_u)
+        {
+            capacity_u = (capacity_u == 0) ? 64U : (2U * capacity_u);
+            grow_pst = realloc(cmds_psts, capacity_u * sizeof(genCmd_t));
+            if(grow_pst == NULL)
+            {
+                fprintf(stderr, "out of memory\n");
+                fclose(def_fp);
+                return false;
+            }
+            cmds_psts = grow_pst;
+        }
+
+        memcpy(cmds_psts[cmdCount_us].name_ca, pos_pc, len_u);
+        cmds_psts[cmdCount_us].name_ca[len_u] = '\0';
+        cmds_psts[cmdCount_us].hash_u32 = wscmdtab_Hash_u32(cmds_psts[cmdCount_us].name_ca);
+
+        for(idx_u = 0; idx_u < cmdCount_us; idx_u++)
+        {
+            if(strcmp(cmds_psts[idx_u].name_ca, cmds_psts[cmdCount_us].name_ca) == 0)
+            {
+                fprintf(stderr, "%s:%zu: command %s is defined twice\n",
+                            path_cpc, lineNo_u, cmds_psts[idx_u].name_ca);
+                fclose(def_fp);
+                return false;
+            }
+        }
+        cmdCount_us++;
+    }
+    fclose(def_fp);
+
+    if(cmdCount_us == 0)
+    {
+        fprintf(stderr, "%s: no WSCMD line found\n", path_cpc);
+        return false;
+    }
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Searches the seeds of all buckets for the given number of buckets
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   buckets_u   number of buckets
+ * @return  true if every command got its own slot
+*//*------------------------------------------------------------------------------------*/
+static bool Search_bol(size_t buckets_u)
+{
+    size_t idx_u;
+
+    free(seeds_pu16s);
+    free(bucketSize_pus);
+    free(bucketOrder_pus);
+    free(slotUsed_pbols);
+    seeds_pu16s = calloc(buckets_u, sizeof(uint16_t));
+    bucketSize_pus = calloc(buckets_u, sizeof(size_t));
+    bucketOrder_pus = calloc(buckets_u, sizeof(size_t));
+    slotUsed_pbols = calloc(cmdCount_us, sizeof(bool));
+    if((seeds_pu16s == NULL) || (bucketSize_pus == NULL) || (bucketOrder_pus == NULL)
+        || (slotUsed_pbols == NULL))
+    {
+        fprintf(stderr, "out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+
+    for(idx_u = 0; idx_u < cmdCount_us; idx_u++)
+    {
+        cmds_psts[idx_u].bucket_u = wscmdtab_Mix_u32(cmds_psts[idx_u].hash_u32, 0U)
+                                        % (uint32_t)buckets_u;
+        bucketSize_pus[cmds_psts[idx_u].bucket_u]++;
+    }
+
+    /* the large buckets are placed while most slots are still free */
+    for(idx_u = 0; idx_u < buckets_u; idx_u++)
+    {
+        bucketOrder_pus[idx_u] = idx_u;
+    }
+    qsort(bucketOrder_pus, buckets_u, sizeof(size_t), CompareBuckets_i);
+
+    for(idx_u = 0; idx_u < buckets_u; idx_u++)
+    {
+        if(bucketSize_pus[bucketOrder_pus[idx_u]] == 0)
+            break;
+        if(!PlaceBucket_bol(bucketOrder_pus[idx_u], &seeds_pu16s[bucketOrder_pus[idx_u]]))
+            return false;
+    }
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Finds the first seed which moves all commands of the bucket to free and
+ *              distinct slots and marks the slots as used
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   bucket_u    bucket to place
+ * @param   seed_pu16   found seed
+ * @return  true if a seed was found
+*//*------------------------------------------------------------------------------------*/
+static bool PlaceBucket_bol(size_t bucket_u, uint16_t *seed_pu16)
+{
+    uint32_t seed_u32;
+    size_t idx_u;
+    size_t other_u;
+    bool fits_bol;
+
+    for(seed_u32 = 1U; seed_u32 <= MAX_SEED; seed_u32++)
+    {
+        fits_bol = true;
+        for(idx_u = 0; fits_bol && (idx_u < cmdCount_us); idx_u++)
+        {
+            if(cmds_psts[idx_u].bucket_u != bucket_u)
+                continue;
+
+            cmds_psts[idx_u].slot_u = wscmdtab_Mix_u32(cmds_psts[idx_u].hash_u32, seed_u32)
+                                        % (uint32_t)cmdCount_us;
+            if(slotUsed_pbols[cmds_psts[idx_u].slot_u])
+                fits_bol = false;
+
+            /* the commands of the bucket must not collide with each other */
+            for(other_u = 0; fits_bol && (other_u < idx_u); other_u++)
+            {
+                if((cmds_psts[other_u].bucket_u == bucket_u)
+                    && (cmds_psts[other_u].slot_u == cmds_psts[idx_u].slot_u))
+                    fits_bol = false;
+            }
+        }
+
+        if(fits_bol)
+        {
+            for(idx_u = 0; idx_u < cmdCount_us; idx_u++)
+            {
+                if(cmds_psts[idx_u].bucket_u == bucket_u)
+                    slotUsed_pbols[cmds_psts[idx_u].slot_u] = true;
+            }
+            *seed_pu16 = (uint16_t)seed_u32;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sorts the buckets by size, largest first
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static int CompareBuckets_i(const void *a_pv, const void *b_pv)
+{
+    size_t sizeA_u = bucketSize_pus[*(const size_t *)a_pv];
+    size_t sizeB_u = bucketSize_pus[*(const size_t *)b_pv];
+
+    if(sizeA_u != sizeB_u)
+        return((sizeA_u > sizeB_u) ? -1 : 1);
+
+    /* keep the result independent of the qsort implementation */
+    return((*(const size_t *)a_pv < *(const size_t *)b_pv) ? -1 : 1);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Writes the header with the hash parameters and the slot of every command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    path of the generated header
+ * @param   defPath_cpc path of the definition file, for the comment only
+ * @param   buckets_u   number of buckets
+ * @return  true on success
+*//*------------------------------------------------------------------------------------*/
+static bool WriteHeader_bol(const char *path_cpc, const char *defPath_cpc, size_t buckets_u)
+{
+    size_t idx_u;
+    FILE *out_fp = fopen(path_cpc, "w");
+
+    if(out_fp == NULL)
+    {
+        perror(path_cpc);
+        return false;
+    }
+
+    fprintf(out_fp, "/* Generated by wscmdgen from %s, do not edit. */\n", defPath_cpc);
+    fprintf(out_fp, "#ifndef WSCMDTAB_GENERATED_H\n#define WSCMDTAB_GENERATED_H\n\n");
+    fprintf(out_fp, "#define WSCMDTAB_COUNT %zu\n", cmdCount_us);
+    fprintf(out_fp, "#define WSCMDTAB_BUCKETS %zu\n\n", buckets_u);
+
+    fprintf(out_fp, "#define WSCMDTAB_SEEDS { \\\n");
+    for(idx_u = 0; idx_u < buckets_u; idx_u++)
+    {
+        fprintf(out_fp, "%s%uU,%s", (idx_u % 8U == 0) ? "    " : "",
+                    (unsigned)seeds_pu16s[idx_u],
+                    (((idx_u + 1U) % 8U == 0) || (idx_u + 1U == buckets_u)) ? " \\\n" : " ");
+    }
+    fprintf(out_fp, "}\n\n");
+
+    /* the slots in the order of the definition file, used to list the commands */
+    fprintf(out_fp, "#define WSCMDTAB_ORDER { \\\n");
+    for(idx_u = 0; idx_u < cmdCount_us; idx_u++)
+    {
+        fprintf(out_fp, "%s%zuU,%s", (idx_u % 8U == 0) ? "    " : "",
+                    cmds_psts[idx_u].slot_u,
+                    (((idx_u + 1U) % 8U == 0) || (idx_u + 1U == cmdCount_us)) ? " \\\n" : " ");
+    }
+    fprintf(out_fp, "}\n\n");
+
+    for(idx_u = 0; idx_u < cmdCount_us; idx_u++)
+    {
+        fprintf(out_fp, "#define WSCMDTAB_SLOT_%s %zu\n",
+                    cmds_psts[idx_u].name_ca, cmds_psts[idx_u].slot_u);
+    }
+    fprintf(out_fp, "\n#endif\n");
+
+    if(fclose(out_fp) != 0)
+    {
+        perror(path_cpc);
+        return false;
+    }
+    return true;
+}
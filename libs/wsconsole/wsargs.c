@@ -0,0 +1,486 @@
+/****************************************************************************************
+* FILENAME :        wsargs.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the argument table helpers of the console
+*
+* DETAILED DESCRIPTION :
+*   argtable3 keeps the type of an entry only in its callback functions. The scan
+*   function of every supported type is taken once from a probe entry, the entries
+*   of a table are then recognized by their scan function and rebuilt with the
+*   public constructor of their type.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "wsargs.h"
+
+#include "argtable3.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Supported entry types
+ */
+typedef enum argType_tag
+{
+    ARGTYPE_LIT = 0,
+    ARGTYPE_INT,
+    ARGTYPE_DBL,
+    ARGTYPE_STR,
+    ARGTYPE_FILE,
+    ARGTYPE_COUNT,
+    ARGTYPE_REM,
+    ARGTYPE_END,
+    ARGTYPE_UNKNOWN
+}argType_t;
+
+/**
+ * @brief Alignment of the saved values
+ */
+typedef union valueAlign_tag
+{
+    double d;
+    void *p;
+    long l;
+}valueAlign_t;
+
+/**
+ * @brief Values of an argument table, the value arrays of the entries in table
+ *          order, each one aligned to valueAlign_t
+ */
+typedef struct defaults_tag
+{
+    size_t size_u;
+    valueAlign_t data_ua[];
+}defaults_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static void InitProbes_vd(void);
+static argType_t GetType_en(const struct arg_hdr *hdr_pst);
+static struct arg_hdr *CloneEntry_pst(const struct arg_hdr *hdr_pst);
+static size_t CopyValues_u(struct arg_hdr **table_ppst, unsigned char *data_pu,
+                            bool save_bol);
+static size_t CopyArray_u(void *values_pv, size_t len_u, unsigned char *data_pu,
+                            size_t offset_u, bool save_bol);
+
+/***************************************************************************************/
+/* Local variables: */
+/**
+ * Scan functions of the supported types, taken from probe entries
+ */
+static arg_scanfn *probeScan_xsa[ARGTYPE_COUNT];
+static pthread_once_t probeOnce_xs = PTHREAD_ONCE_INIT;
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Creates an independent copy of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void **wsargs_CloneTable_ppv(void **argtable_ppv)
+{
+    struct arg_hdr **table_ppst = (struct arg_hdr **)argtable_ppv;
+    struct arg_hdr **clone_ppst;
+    size_t count_u = 0;
+    size_t idx_u;
+
+    if(table_ppst == NULL)
+        return NULL;
+
+    (void)pthread_once(&probeOnce_xs, InitProbes_vd);
+
+    /* number of entries including the terminating arg_end */
+    while((table_ppst[count_u] != NULL) && !(table_ppst[count_u]->flag & ARG_TERMINATOR))
+        count_u++;
+    if(table_ppst[count_u] == NULL)
+        return NULL;
+    count_u++;
+
+    clone_ppst = calloc(count_u, sizeof(*clone_ppst));
+    if(clone_ppst == NULL)
+        return NULL;
+
+    for(idx_u = 0; idx_u < count_u; idx_u++)
+    {
+        clone_ppst[idx_u] = CloneEntry_pst(table_ppst[idx_u]);
+        if(clone_ppst[idx_u] == NULL)
+        {
+            arg_freetable((void **)clone_ppst, idx_u);
+            free(clone_ppst);
+            return NULL;
+        }
+    }
+
+    if(arg_compile((void **)clone_ppst) != 0)
+    {
+        wsargs_FreeTable_vd((void **)clone_ppst);
+        return NULL;
+    }
+
+    return((void **)clone_ppst);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Releases a copy of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wsargs_FreeTable_vd(void **clone_ppv)
+{
+    if(clone_ppv == NULL)
+        return;
+
+    arg_free(clone_ppv);
+    free(clone_ppv);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Saves the values of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *wsargs_SaveDefaults_pv(void **argtable_ppv)
+{
+    defaults_t *defaults_pst;
+    size_t size_u;
+
+    if(argtable_ppv == NULL)
+        return NULL;
+
+    (void)pthread_once(&probeOnce_xs, InitProbes_vd);
+
+    size_u = CopyValues_u((struct arg_hdr **)argtable_ppv, NULL, true);
+    defaults_pst = malloc(sizeof(defaults_t) + size_u);
+    if(defaults_pst == NULL)
+        return NULL;
+
+    defaults_pst->size_u = size_u;
+    (void)CopyValues_u((struct arg_hdr **)argtable_ppv,
+                        (unsigned char *)defaults_pst->data_ua, true);
+
+    return(defaults_pst);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Restores the saved values of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wsargs_RestoreDefaults_vd(void **argtable_ppv, const void *defaults_pv)
+{
+    const defaults_t *defaults_pcst = defaults_pv;
+
+    if((argtable_ppv == NULL) || (defaults_pcst == NULL))
+        return;
+
+    (void)pthread_once(&probeOnce_xs, InitProbes_vd);
+
+    (void)CopyValues_u((struct arg_hdr **)argtable_ppv,
+                        (unsigned char *)defaults_pcst->data_ua, false);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Releases the saved values of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wsargs_FreeDefaults_vd(void *defaults_pv)
+{
+    free(defaults_pv);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Checks if an entry takes file names
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+bool wsargs_IsFile_bol(const void *entry_pv)
+{
+    if(entry_pv == NULL)
+        return false;
+
+    (void)pthread_once(&probeOnce_xs, InitProbes_vd);
+
+    return(GetType_en((const struct arg_hdr *)entry_pv) == ARGTYPE_FILE);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Takes the scan function of every supported type from a probe entry, the
+ *              probes are released again
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void InitProbes_vd(void)
+{
+    void *probes_apv[ARGTYPE_COUNT];
+    size_t idx_u;
+
+    probes_apv[ARGTYPE_LIT] = arg_lit0(NULL, NULL, NULL);
+    probes_apv[ARGTYPE_INT] = arg_int0(NULL, NULL, NULL, NULL);
+    probes_apv[ARGTYPE_DBL] = arg_dbl0(NULL, NULL, NULL, NULL);
+    probes_apv[ARGTYPE_STR] = arg_str0(NULL, NULL, NULL, NULL);
+    probes_apv[ARGTYPE_FILE] = arg_file0(NULL, NULL, NULL, NULL);
+
+    for(idx_u = 0; idx_u < ARGTYPE_COUNT; idx_u++)
+    {
+        probeScan_xsa[idx_u] = (probes_apv[idx_u] != NULL) ?
+                                ((struct arg_hdr *)probes_apv[idx_u])->scanfn : NULL;
+    }
+    arg_freetable(probes_apv, ARGTYPE_COUNT);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Recognizes the type of an argument table entry
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hdr_pst     entry of an argument table
+ * @return  type of the entry, ARGTYPE_UNKNOWN if it is not supported
+*//*------------------------------------------------------------------------------------*/
+static argType_t GetType_en(const struct arg_hdr *hdr_pst)
+{
+    size_t idx_u;
+
+    if(hdr_pst->flag & ARG_TERMINATOR)
+        return ARGTYPE_END;
+
+    if(hdr_pst->scanfn == NULL)
+        return ARGTYPE_REM;
+
+    for(idx_u = 0; idx_u < ARGTYPE_COUNT; idx_u++)
+    {
+        if(hdr_pst->scanfn == probeScan_xsa[idx_u])
+            return (argType_t)idx_u;
+    }
+
+    return(ARGTYPE_UNKNOWN);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Rebuilds one entry with the constructor of its type, the values are copied
+ *              as they are, the defaults saved with wsargs_SaveDefaults_pv are
+ *              restored into the copy before it is parsed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hdr_pst     entry of an argument table
+ * @return  copy of the entry, NULL if the type is not supported
+*//*------------------------------------------------------------------------------------*/
+static struct arg_hdr *CloneEntry_pst(const struct arg_hdr *hdr_pst)
+{
+    struct arg_hdr *clone_pst = NULL;
+    size_t max_u = (size_t)hdr_pst->maxcount;
+
+    switch(GetType_en(hdr_pst))
+    {
+        case ARGTYPE_LIT:
+            clone_pst = (struct arg_hdr *)arg_litn(hdr_pst->shortopts, hdr_pst->longopts,
+                                    hdr_pst->mincount, hdr_pst->maxcount, hdr_pst->glossary);
+            break;
+
+        case ARGTYPE_INT:
+        {
+            const struct arg_int *src_pst = hdr_pst->parent;
+            struct arg_int *dst_pst = arg_intn(hdr_pst->shortopts, hdr_pst->longopts,
+                                    hdr_pst->datatype, hdr_pst->mincount,
+                                    hdr_pst->maxcount, hdr_pst->glossary);
+            if(dst_pst != NULL)
+                memcpy(dst_pst->ival, src_pst->ival, max_u * sizeof(*dst_pst->ival));
+            clone_pst = (struct arg_hdr *)dst_pst;
+            break;
+        }
+
+        case ARGTYPE_DBL:
+        {
+            const struct arg_dbl *src_pst = hdr_pst->parent;
+            struct arg_dbl *dst_pst = arg_dbln(hdr_pst->shortopts, hdr_pst->longopts,
+                                    hdr_pst->datatype, hdr_pst->mincount,
+                                    hdr_pst->maxcount, hdr_pst->glossary);
+            if(dst_pst != NULL)
+                memcpy(dst_pst->dval, src_pst->dval, max_u * sizeof(*dst_pst->dval));
+            clone_pst = (struct arg_hdr *)dst_pst;
+            break;
+        }
+
+        case ARGTYPE_STR:
+        {
+            const struct arg_str *src_pst = hdr_pst->parent;
+            struct arg_str *dst_pst = arg_strn(hdr_pst->shortopts, hdr_pst->longopts,
+                                    hdr_pst->datatype, hdr_pst->mincount,
+                                    hdr_pst->maxcount, hdr_pst->glossary);
+            if(dst_pst != NULL)
+                memcpy(dst_pst->sval, src_pst->sval, max_u * sizeof(*dst_pst->sval));
+            clone_pst = (struct arg_hdr *)dst_pst;
+            break;
+        }
+
+        case ARGTYPE_FILE:
+        {
+            const struct arg_file *src_pst = hdr_pst->parent;
+            struct arg_file *dst_pst = arg_filen(hdr_pst->shortopts, hdr_pst->longopts,
+                                    hdr_pst->datatype, hdr_pst->mincount,
+                                    hdr_pst->maxcount, hdr_pst->glossary);
+            if(dst_pst != NULL)
+            {
+                memcpy(dst_pst->filename, src_pst->filename,
+                        max_u * sizeof(*dst_pst->filename));
+                memcpy(dst_pst->basename, src_pst->basename,
+                        max_u * sizeof(*dst_pst->basename));
+                memcpy(dst_pst->extension, src_pst->extension,
+                        max_u * sizeof(*dst_pst->extension));
+            }
+            clone_pst = (struct arg_hdr *)dst_pst;
+            break;
+        }
+
+        case ARGTYPE_REM:
+            clone_pst = (struct arg_hdr *)arg_rem(hdr_pst->datatype, hdr_pst->glossary);
+            break;
+
+        case ARGTYPE_END:
+            clone_pst = (struct arg_hdr *)arg_end(hdr_pst->maxcount);
+            break;
+
+        default:
+            break;
+    }
+
+    /* keep modifier flags set by the application, e.g. ARG_HASOPTVALUE */
+    if(clone_pst != NULL)
+        clone_pst->flag = hdr_pst->flag;
+
+    return(clone_pst);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Copies the values of all supported entries between an argument table and
+ *              the saved values
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   table_ppst  argument table terminated by arg_end
+ * @param   data_pu     saved values, NULL to get the size only
+ * @param   save_bol    true copies from the table, false copies into the table
+ * @return  size of the saved values in bytes
+*//*------------------------------------------------------------------------------------*/
+static size_t CopyValues_u(struct arg_hdr **table_ppst, unsigned char *data_pu,
+                            bool save_bol)
+{
+    size_t offset_u = 0;
+    size_t max_u;
+    size_t idx_u;
+
+    for(idx_u = 0; (table_ppst[idx_u] != NULL) && !(table_ppst[idx_u]->flag & ARG_TERMINATOR);
+        idx_u++)
+    {
+        max_u = (size_t)table_ppst[idx_u]->maxcount;
+        switch(GetType_en(table_ppst[idx_u]))
+        {
+            case ARGTYPE_INT:
+            {
+                struct arg_int *int_pst = table_ppst[idx_u]->parent;
+                offset_u = CopyArray_u(int_pst->ival, max_u * sizeof(*int_pst->ival),
+                                        data_pu, offset_u, save_bol);
+                break;
+            }
+
+            case ARGTYPE_DBL:
+            {
+                struct arg_dbl *dbl_pst = table_ppst[idx_u]->parent;
+                offset_u = CopyArray_u(dbl_pst->dval, max_u * sizeof(*dbl_pst->dval),
+                                        data_pu, offset_u, save_bol);
+                break;
+            }
+
+            case ARGTYPE_STR:
+            {
+                struct arg_str *str_pst = table_ppst[idx_u]->parent;
+                offset_u = CopyArray_u(str_pst->sval, max_u * sizeof(*str_pst->sval),
+                                        data_pu, offset_u, save_bol);
+                break;
+            }
+
+            case ARGTYPE_FILE:
+            {
+                struct arg_file *file_pst = table_ppst[idx_u]->parent;
+                offset_u = CopyArray_u(file_pst->filename, max_u * sizeof(*file_pst->filename),
+                                        data_pu, offset_u, save_bol);
+                offset_u = CopyArray_u(file_pst->basename, max_u * sizeof(*file_pst->basename),
+                                        data_pu, offset_u, save_bol);
+                offset_u = CopyArray_u(file_pst->extension,
+                                        max_u * sizeof(*file_pst->extension),
+                                        data_pu, offset_u, save_bol);
+                break;
+            }
+
+            default:
+                break;
+        }
+    }
+
+    return(offset_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Copies one value array between an entry and the saved values
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   values_pv   value array of the entry
+ * @param   len_u       size of the value array in bytes
+ * @param   data_pu     saved values, NULL to get the size only
+ * @param   offset_u    position of the array in the saved values
+ * @param   save_bol    true copies from the entry, false copies into the entry
+ * @return  position of the next array in the saved values
+*//*------------------------------------------------------------------------------------*/
+static size_t CopyArray_u(void *values_pv, size_t len_u, unsigned char *data_pu,
+                            size_t offset_u, bool save_bol)
+{
+    if((data_pu != NULL) && (len_u > 0))
+    {
+        if(save_bol)
+            memcpy(&data_pu[offset_u], values_pv, len_u);
+        else
+            memcpy(values_pv, &data_pu[offset_u], len_u);
+    }
+
+    return(offset_u + ((len_u + sizeof(valueAlign_t) - 1U) / sizeof(valueAlign_t))
+                        * sizeof(valueAlign_t));
+}
@@ -0,0 +1,136 @@
+/*****************************************************************************************
+* FILENAME :        wsargs.h
+*
+* DESCRIPTION :
+*       Header file for the argument table helpers of the console. An argument table
+*       holds the results of the last parse, a copy of the table lets another thread
+*       parse and execute the same command at the same time.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   void **clone_ppv = wsargs_CloneTable_ppv(cmd_pt->argtable);
+*
+*   if(arg_parse(argc_i, argv_ppc, clone_ppv) == 0)
+*       ...
+*
+*   wsargs_FreeTable_vd(clone_ppv);
+*
+*   The built-in types arg_rem, arg_lit, arg_int, arg_dbl, arg_str, arg_file and
+*   arg_end are copied with their options and default values. Tables with other
+*   entries, e.g. arg_rex or arg_date, are not copied.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSARGS_H
+#define WSARGS_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   creates an independent copy of an argument table, the copy is compiled
+ *              with arg_compile and ready for arg_parse
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   argtable_ppv  argument table terminated by arg_end
+ * @return
+ *          - copy of the argument table
+ *          - NULL if the table holds an entry which cannot be copied or if out of
+ *              memory
+*//*------------------------------------------------------------------------------------*/
+extern void **wsargs_CloneTable_ppv(void **argtable_ppv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   releases a copy created by wsargs_CloneTable_ppv
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   clone_ppv     copy of an argument table, may be NULL
+*//*------------------------------------------------------------------------------------*/
+extern void wsargs_FreeTable_vd(void **clone_ppv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   saves the values of an argument table, i.e. the defaults of the optional
+ *              arguments. arg_parse leaves the values of omitted arguments as they are,
+ *              so the saved values are restored before every parse. The values of
+ *              entries not supported by wsargs_CloneTable_ppv are not saved.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   argtable_ppv  argument table terminated by arg_end, not parsed yet
+ * @return  saved values, NULL if out of memory or argtable_ppv is NULL
+*//*------------------------------------------------------------------------------------*/
+extern void *wsargs_SaveDefaults_pv(void **argtable_ppv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   restores the values saved by wsargs_SaveDefaults_pv, also into a copy
+ *              created by wsargs_CloneTable_ppv. Does not use the heap.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   argtable_ppv  argument table the values were saved from, or its copy
+ * @param   defaults_pv   saved values, nothing is restored if NULL
+*//*------------------------------------------------------------------------------------*/
+extern void wsargs_RestoreDefaults_vd(void **argtable_ppv, const void *defaults_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   releases the values saved by wsargs_SaveDefaults_pv
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   defaults_pv   saved values, may be NULL
+*//*------------------------------------------------------------------------------------*/
+extern void wsargs_FreeDefaults_vd(void *defaults_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   checks if an entry of an argument table takes file names, i.e. was created
+ *              with arg_file0, arg_file1 or arg_filen
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   entry_pv      entry of an argument table
+ * @return  true if the entry is an arg_file entry
+*//*------------------------------------------------------------------------------------*/
+extern bool wsargs_IsFile_bol(const void *entry_pv);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSARGS_H
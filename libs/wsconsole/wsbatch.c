@@ -0,0 +1,928 @@
+/****************************************************************************************
+* FILENAME :        wsbatch.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the batch mode of the console
+*
+* DETAILED DESCRIPTION :
+*   A regular file is mapped into memory and split into lines without copying the
+*   file, other inputs like pipes are read in blocks of WSBATCH_READ_BUF_LEN bytes.
+*   Every line is copied into a slot and split with embedded_cli_tokenize_spans. In
+*   pipeline mode the slots form a bounded queue between the reader thread and the
+*   calling thread, so the next lines are read and split while a command executes.
+*   The calling thread takes the lines in script order. Independent commands are
+*   handed to the thread pool when there are workers, every other line waits until
+*   all lines before it are passed on and runs on the calling thread. The response
+*   of a pooled line is collected in its slot and written when the line reaches the
+*   head of the queue, so the output keeps the script order.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "wsbatch.h"
+
+#include "wserr.h"
+#include "wsconsole.h"
+#include "wspool.h"
+#include "embedded_cli.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Queued lines per worker of a parallel run, keeps all workers busy while the
+ * response at the head of the queue is still pending
+ */
+#define SLOTS_PER_WORKER 4U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Line reader of the script, either a mapped file or a read buffer
+ */
+typedef struct reader_tag
+{
+    /**
+     * file descriptor of the script
+     */
+    int fd_i;
+    /**
+     * mapped file and read position, NULL if the buffer is used
+     */
+    const char *map_cpc;
+    size_t mapLen_u;
+    size_t mapPos_u;
+    /**
+     * read buffer and its fill state, the buffer keeps room for the rest of an
+     * incomplete line in front of a full block
+     */
+    char *buf_pc;
+    size_t head_u;
+    size_t tail_u;
+    /**
+     * end of input reached, no further read() calls
+     */
+    bool eof_bol;
+    /**
+     * rest of an over long line is discarded up to the next line feed
+     */
+    bool skip_bol;
+    /**
+     * number of the last returned line
+     */
+    size_t lineNo_u;
+}reader_t;
+
+/**
+ * @brief One split script line
+ */
+typedef struct slot_tag
+{
+    struct batch_tag *batch_pst;
+    size_t lineNo_u;
+    bool tooLong_bol;
+    int argc_i;
+    char *argv_apc[WSBATCH_MAX_ARGC];
+    char line_ca[WSBATCH_MAX_LINE];
+    /**
+     * result of the command, done_bol is protected by the lock of the batch run
+     */
+    wserr_t result_st;
+    bool done_bol;
+    /**
+     * collected response of a pooled line, the buffer is reused by later lines
+     */
+    char *out_pc;
+    size_t outLen_u;
+    size_t outSize_u;
+    bool outLost_bol;
+}slot_t;
+
+/**
+ * @brief Console of a pool worker and the line it executes
+ */
+typedef struct lane_tag
+{
+    wsconsole_tp console_x;
+    slot_t *slot_pst;
+}lane_t;
+
+/**
+ * @brief State of one batch run
+ */
+typedef struct batch_tag
+{
+    wsconsole_tp console_x;
+    const wsbatch_config_t *config_pst;
+    reader_t reader_st;
+    /**
+     * bounded queue of split lines, filled by the reader thread
+     */
+    slot_t *slots_pst;
+    size_t slotCount_u;
+    size_t head_u;
+    size_t count_u;
+    /**
+     * number of queued lines from head_u on which are handed to the pool
+     */
+    size_t issued_u;
+    /**
+     * thread pool and the consoles of its workers, NULL without workers
+     */
+    wspool_tp pool_x;
+    lane_t *lanes_pst;
+    /**
+     * reader finished, stop requested by the executing thread, read error
+     */
+    bool done_bol;
+    bool stop_bol;
+    bool readError_bol;
+    pthread_mutex_t lock_st;
+    /**
+     * signalled for a new line and for a finished pooled line
+     */
+    pthread_cond_t notEmpty_st;
+    pthread_cond_t notFull_st;
+    /**
+     * number of failed lines
+     */
+    size_t failed_u;
+}batch_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static wserr_t OpenReader_t(reader_t *reader_pst, int fd_i);
+static void CloseReader_vd(reader_t *reader_pst);
+static int NextLine_i(reader_t *reader_pst, const char **line_cpc, size_t *len_pu);
+static int FillSlot_i(reader_t *reader_pst, slot_t *slot_pst);
+static bool ReportSlot_bol(batch_t *batch_pst, slot_t *slot_pst);
+static bool IsPooled_bol(batch_t *batch_pst, slot_t *slot_pst);
+static wserr_t RunSequential_t(batch_t *batch_pst);
+static wserr_t RunPipelined_t(batch_t *batch_pst);
+static void *Reader_pv(void *batch_pv);
+static wserr_t StartWorkers_t(batch_t *batch_pst, size_t workers_u);
+static void StopWorkers_vd(batch_t *batch_pst);
+static void RunTask_vd(void *slot_pv, size_t worker_u);
+static size_t NoInput_u(char *buf_pc, size_t size_u);
+static void CaptureWrite_vd(void *lane_pv, const char *buf_pc, size_t len_u);
+static void CapturePutChar_vd(void *lane_pv, char ch_c, bool isLast_bol);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Initializes the configuration with default values
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsbatch_InitParameter_t(wsbatch_config_t *config_stp)
+{
+    if(config_stp == NULL)
+        return wserr_ERR_PARAM;
+
+    config_stp->fd_i = -1;
+    config_stp->stopOnError_bol = false;
+    config_stp->pipeline_bol = true;
+    config_stp->workers_u = 0;
+    config_stp->errStream_fp = stderr;
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Executes the script line by line on the console
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsbatch_Run_t(wsconsole_tp console_x, const wsbatch_config_t *config_stp,
+                        size_t *failed_pu)
+{
+    wserr_t exeResult_st;
+    batch_t batch_st;
+    size_t idx_u;
+
+    if((console_x == NULL) || (config_stp == NULL) || (config_stp->fd_i < 0)
+        || (config_stp->workers_u > WSPOOL_MAX_WORKERS))
+        return wserr_ERR_PARAM;
+
+    memset(&batch_st, 0, sizeof(batch_st));
+    batch_st.console_x = console_x;
+    batch_st.config_pst = config_stp;
+    batch_st.slotCount_u = 1;
+    if(config_stp->pipeline_bol || (config_stp->workers_u > 0))
+    {
+        batch_st.slotCount_u = WSBATCH_QUEUE_LEN;
+        if(batch_st.slotCount_u < SLOTS_PER_WORKER * config_stp->workers_u)
+            batch_st.slotCount_u = SLOTS_PER_WORKER * config_stp->workers_u;
+    }
+
+    batch_st.slots_pst = calloc(batch_st.slotCount_u, sizeof(slot_t));
+    if(batch_st.slots_pst == NULL)
+        return wserr_ERR_NO_MEM;
+    for(idx_u = 0; idx_u < batch_st.slotCount_u; idx_u++)
+        batch_st.slots_pst[idx_u].batch_pst = &batch_st;
+
+    exeResult_st = OpenReader_t(&batch_st.reader_st, config_stp->fd_i);
+    if((wserr_OK == exeResult_st) && (config_stp->workers_u > 0))
+    {
+        exeResult_st = StartWorkers_t(&batch_st, config_stp->workers_u);
+    }
+    if(wserr_OK == exeResult_st)
+    {
+        if(batch_st.slotCount_u > 1)
+        {
+            exeResult_st = RunPipelined_t(&batch_st);
+        }
+        else
+        {
+            exeResult_st = RunSequential_t(&batch_st);
+        }
+    }
+    StopWorkers_vd(&batch_st);
+    CloseReader_vd(&batch_st.reader_st);
+    for(idx_u = 0; idx_u < batch_st.slotCount_u; idx_u++)
+        free(batch_st.slots_pst[idx_u].out_pc);
+    free(batch_st.slots_pst);
+
+    if(failed_pu != NULL)
+        *failed_pu = batch_st.failed_u;
+
+    if((wserr_OK == exeResult_st) && ((batch_st.failed_u > 0) || batch_st.readError_bol))
+        exeResult_st = wserr_ERR_GEN;
+
+    return(exeResult_st);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Prepares the line reader, regular files are mapped into memory, everything
+ *              else gets a read buffer
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   reader_pst    reader to prepare
+ * @param   fd_i          file descriptor of the script
+ * @return  wserr_OK on success, wserr_ERR_NO_MEM if the buffer is not available
+*//*------------------------------------------------------------------------------------*/
+static wserr_t OpenReader_t(reader_t *reader_pst, int fd_i)
+{
+    struct stat stat_st;
+    void *map_pv;
+
+    memset(reader_pst, 0, sizeof(*reader_pst));
+    reader_pst->fd_i = fd_i;
+
+    if((fstat(fd_i, &stat_st) == 0) && S_ISREG(stat_st.st_mode) && (stat_st.st_size > 0))
+    {
+        map_pv = mmap(NULL, (size_t)stat_st.st_size, PROT_READ, MAP_PRIVATE, fd_i, 0);
+        if(map_pv != MAP_FAILED)
+        {
+            (void)madvise(map_pv, (size_t)stat_st.st_size, MADV_SEQUENTIAL);
+            reader_pst->map_cpc = map_pv;
+            reader_pst->mapLen_u = (size_t)stat_st.st_size;
+            return wserr_OK;
+        }
+    }
+
+    /* The file may not be mappable, e.g. on some special file systems, it is read
+     * like a pipe in this case */
+    reader_pst->buf_pc = malloc(WSBATCH_READ_BUF_LEN + WSBATCH_MAX_LINE);
+    if(reader_pst->buf_pc == NULL)
+        return wserr_ERR_NO_MEM;
+
+    return(wserr_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Releases the mapping or the read buffer of the reader
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   reader_pst    reader to release
+*//*------------------------------------------------------------------------------------*/
+static void CloseReader_vd(reader_t *reader_pst)
+{
+    if(reader_pst->map_cpc != NULL)
+    {
+        (void)munmap((void *)reader_pst->map_cpc, reader_pst->mapLen_u);
+        reader_pst->map_cpc = NULL;
+    }
+    free(reader_pst->buf_pc);
+    reader_pst->buf_pc = NULL;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the next line of the script without the line feed. A line of
+ *              WSBATCH_MAX_LINE bytes or more is returned with its first part only,
+ *              the caller detects it by its length.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   reader_pst    line reader
+ * @param   line_cpc      receives the start of the line, valid until the next call
+ * @param   len_pu        receives the length of the line
+ * @return  1 if a line is returned, 0 at the end of the script, -1 on read errors
+*//*------------------------------------------------------------------------------------*/
+static int NextLine_i(reader_t *reader_pst, const char **line_cpc, size_t *len_pu)
+{
+    const char *start_cpc;
+    const char *end_cpc;
+    size_t avail_u;
+    ssize_t read_i;
+
+    if(reader_pst->map_cpc != NULL)
+    {
+        if(reader_pst->mapPos_u >= reader_pst->mapLen_u)
+            return 0;
+
+        start_cpc = &reader_pst->map_cpc[reader_pst->mapPos_u];
+        avail_u = reader_pst->mapLen_u - reader_pst->mapPos_u;
+        end_cpc = memchr(start_cpc, '\n', avail_u);
+        *line_cpc = start_cpc;
+        *len_pu = (end_cpc != NULL) ? (size_t)(end_cpc - start_cpc) : avail_u;
+        reader_pst->mapPos_u += *len_pu + 1;
+        reader_pst->lineNo_u++;
+        return 1;
+    }
+
+    for(;;)
+    {
+        start_cpc = &reader_pst->buf_pc[reader_pst->head_u];
+        avail_u = reader_pst->tail_u - reader_pst->head_u;
+        end_cpc = memchr(start_cpc, '\n', avail_u);
+
+        if(reader_pst->skip_bol)
+        {
+            if(end_cpc != NULL)
+            {
+                reader_pst->head_u += (size_t)(end_cpc - start_cpc) + 1;
+                reader_pst->skip_bol = false;
+                continue;
+            }
+            reader_pst->head_u = reader_pst->tail_u;
+            avail_u = 0;
+        }
+        else if(end_cpc != NULL)
+        {
+            *line_cpc = start_cpc;
+            *len_pu = (size_t)(end_cpc - start_cpc);
+            reader_pst->head_u += *len_pu + 1;
+            reader_pst->lineNo_u++;
+            return 1;
+        }
+        else if(avail_u >= WSBATCH_MAX_LINE)
+        {
+            *line_cpc = start_cpc;
+            *len_pu = avail_u;
+            reader_pst->head_u = reader_pst->tail_u;
+            reader_pst->skip_bol = true;
+            reader_pst->lineNo_u++;
+            return 1;
+        }
+
+        if(reader_pst->eof_bol)
+        {
+            if(avail_u == 0)
+                return 0;
+
+            /* last line without line feed */
+            *line_cpc = start_cpc;
+            *len_pu = avail_u;
+            reader_pst->head_u = reader_pst->tail_u;
+            reader_pst->lineNo_u++;
+            return 1;
+        }
+
+        /* keep the incomplete line and read the next block behind it */
+        memmove(reader_pst->buf_pc, start_cpc, avail_u);
+        reader_pst->head_u = 0;
+        reader_pst->tail_u = avail_u;
+
+        do
+        {
+            read_i = read(reader_pst->fd_i, &reader_pst->buf_pc[avail_u],
+                            WSBATCH_READ_BUF_LEN + WSBATCH_MAX_LINE - avail_u);
+        } while((read_i < 0) && (errno == EINTR));
+
+        if(read_i < 0)
+        {
+            perror("read()");
+            return -1;
+        }
+
+        if(read_i == 0)
+            reader_pst->eof_bol = true;
+
+        reader_pst->tail_u += (size_t)read_i;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads the next line which is not empty or a comment into the slot and
+ *              splits it into arguments
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   reader_pst    line reader
+ * @param   slot_pst      receives the split line
+ * @return  1 if the slot is filled, 0 at the end of the script, -1 on read errors
+*//*------------------------------------------------------------------------------------*/
+static int FillSlot_i(reader_t *reader_pst, slot_t *slot_pst)
+{
+    const char *line_cpc;
+    size_t len_u;
+    size_t idx_u;
+    int next_i;
+
+    for(;;)
+    {
+        next_i = NextLine_i(reader_pst, &line_cpc, &len_u);
+        if(next_i <= 0)
+            return next_i;
+
+        slot_pst->lineNo_u = reader_pst->lineNo_u;
+        slot_pst->argc_i = 0;
+        slot_pst->tooLong_bol = (len_u >= WSBATCH_MAX_LINE);
+        if(slot_pst->tooLong_bol)
+            return 1;
+
+        if((len_u > 0) && (line_cpc[len_u - 1] == '\r'))
+            len_u--;
+
+        for(idx_u = 0; (idx_u < len_u) && isspace((unsigned char)line_cpc[idx_u]); idx_u++)
+            ;
+        if((idx_u == len_u) || (line_cpc[idx_u] == '#'))
+            continue;
+
+        memcpy(slot_pst->line_ca, line_cpc, len_u);
+        slot_pst->line_ca[len_u] = '\0';
+        slot_pst->argc_i = embedded_cli_tokenize_spans(slot_pst->line_ca,
+                                                    sizeof(slot_pst->line_ca),
+                                                    slot_pst->argv_apc, NULL,
+                                                    WSBATCH_MAX_ARGC);
+        if(slot_pst->argc_i > 0)
+            return 1;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Passes on the collected response of a finished line and reports a failure
+ *              with its line number
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+ * @param   slot_pst      finished line
+ * @return  true if the line was executed successfully
+*//*------------------------------------------------------------------------------------*/
+static bool ReportSlot_bol(batch_t *batch_pst, slot_t *slot_pst)
+{
+    FILE *err_fp = batch_pst->config_pst->errStream_fp;
+    bool outLost_bol = slot_pst->outLost_bol;
+
+    slot_pst->outLost_bol = false;
+    if(slot_pst->outLen_u > 0)
+    {
+        (void)wsconsole_WriteRaw_t(batch_pst->console_x, slot_pst->out_pc,
+                                    slot_pst->outLen_u);
+        slot_pst->outLen_u = 0;
+    }
+
+    if(slot_pst->tooLong_bol)
+    {
+        if(err_fp != NULL)
+            fprintf(err_fp, "line %zu: line too long, maximum is %d characters\n",
+                    slot_pst->lineNo_u, WSBATCH_MAX_LINE - 1);
+    }
+    else if(outLost_bol)
+    {
+        if(err_fp != NULL)
+            fprintf(err_fp, "line %zu: response incomplete, out of memory\n",
+                    slot_pst->lineNo_u);
+    }
+    else if(wserr_OK == slot_pst->result_st)
+    {
+        return true;
+    }
+    else if(err_fp != NULL)
+    {
+        fprintf(err_fp, "line %zu: %s failed\n", slot_pst->lineNo_u,
+                slot_pst->argv_apc[0]);
+    }
+
+    batch_pst->failed_u++;
+    return false;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks whether a line is executed by the thread pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+ * @param   slot_pst      queued line
+ * @return  true if there is a pool and the command of the line is independent
+*//*------------------------------------------------------------------------------------*/
+static bool IsPooled_bol(batch_t *batch_pst, slot_t *slot_pst)
+{
+    return((batch_pst->pool_x != NULL) && !slot_pst->tooLong_bol
+            && wsconsole_IsIndependent_bol(batch_pst->console_x, slot_pst->argv_apc[0]));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads, splits and executes the lines one after the other on the calling
+ *              thread
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+ * @return  wserr_OK when the run is finished
+*//*------------------------------------------------------------------------------------*/
+static wserr_t RunSequential_t(batch_t *batch_pst)
+{
+    slot_t *slot_pst = batch_pst->slots_pst;
+    int fill_i;
+
+    while((fill_i = FillSlot_i(&batch_pst->reader_st, slot_pst)) > 0)
+    {
+        if(!slot_pst->tooLong_bol)
+            slot_pst->result_st = wsconsole_ExecuteArgv_t(batch_pst->console_x,
+                                                            slot_pst->argc_i,
+                                                            slot_pst->argv_apc);
+        if(!ReportSlot_bol(batch_pst, slot_pst) && batch_pst->config_pst->stopOnError_bol)
+            break;
+    }
+    batch_pst->readError_bol = (fill_i < 0);
+
+    return(wserr_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Takes the lines in script order while the reader thread fills the queue
+ *              with the next split lines. Independent lines are handed to the pool,
+ *              other lines run on the calling thread when all lines before them are
+ *              passed on.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+ * @return  wserr_OK when the run is finished, wserr_ERR_NO_MEM if the reader thread
+ *              could not be started
+*//*------------------------------------------------------------------------------------*/
+static wserr_t RunPipelined_t(batch_t *batch_pst)
+{
+    pthread_t reader_st;
+    slot_t *slot_pst;
+    bool ok_bol;
+
+    (void)pthread_mutex_init(&batch_pst->lock_st, NULL);
+    (void)pthread_cond_init(&batch_pst->notEmpty_st, NULL);
+    (void)pthread_cond_init(&batch_pst->notFull_st, NULL);
+
+    if(pthread_create(&reader_st, NULL, Reader_pv, batch_pst) != 0)
+    {
+        (void)pthread_cond_destroy(&batch_pst->notFull_st);
+        (void)pthread_cond_destroy(&batch_pst->notEmpty_st);
+        (void)pthread_mutex_destroy(&batch_pst->lock_st);
+        return wserr_ERR_NO_MEM;
+    }
+
+    (void)pthread_mutex_lock(&batch_pst->lock_st);
+    for(;;)
+    {
+        slot_pst = &batch_pst->slots_pst[batch_pst->head_u];
+
+        if((batch_pst->issued_u > 0) && slot_pst->done_bol)
+        {
+            /* the pooled line at the head is finished, its response is next */
+            batch_pst->issued_u--;
+        }
+        else if(batch_pst->issued_u < batch_pst->count_u)
+        {
+            slot_pst = &batch_pst->slots_pst[(batch_pst->head_u + batch_pst->issued_u) %
+                                                batch_pst->slotCount_u];
+            if(IsPooled_bol(batch_pst, slot_pst))
+            {
+                slot_pst->done_bol = false;
+                batch_pst->issued_u++;
+                (void)pthread_mutex_unlock(&batch_pst->lock_st);
+                if(wserr_OK != wspool_Submit_t(batch_pst->pool_x, RunTask_vd, slot_pst))
+                {
+                    slot_pst->result_st = wserr_ERR_NO_MEM;
+                    (void)pthread_mutex_lock(&batch_pst->lock_st);
+                    slot_pst->done_bol = true;
+                    continue;
+                }
+                (void)pthread_mutex_lock(&batch_pst->lock_st);
+                continue;
+            }
+            if(batch_pst->issued_u > 0)
+            {
+                /* the line waits for the pooled lines before it */
+                (void)pthread_cond_wait(&batch_pst->notEmpty_st, &batch_pst->lock_st);
+                continue;
+            }
+
+            /* the slot stays owned by this thread until it is released below */
+            (void)pthread_mutex_unlock(&batch_pst->lock_st);
+            if(!slot_pst->tooLong_bol)
+                slot_pst->result_st = wsconsole_ExecuteArgv_t(batch_pst->console_x,
+                                                                slot_pst->argc_i,
+                                                                slot_pst->argv_apc);
+            (void)pthread_mutex_lock(&batch_pst->lock_st);
+        }
+        else if((batch_pst->count_u == 0) && batch_pst->done_bol)
+        {
+            break;
+        }
+        else
+        {
+            (void)pthread_cond_wait(&batch_pst->notEmpty_st, &batch_pst->lock_st);
+            continue;
+        }
+
+        /* pass on the head line and release its slot */
+        (void)pthread_mutex_unlock(&batch_pst->lock_st);
+        ok_bol = ReportSlot_bol(batch_pst, slot_pst);
+        (void)pthread_mutex_lock(&batch_pst->lock_st);
+        batch_pst->head_u = (batch_pst->head_u + 1) % batch_pst->slotCount_u;
+        batch_pst->count_u--;
+        if(!ok_bol && batch_pst->config_pst->stopOnError_bol)
+            batch_pst->stop_bol = true;
+        (void)pthread_cond_signal(&batch_pst->notFull_st);
+
+        if(batch_pst->stop_bol)
+            break;
+    }
+    (void)pthread_mutex_unlock(&batch_pst->lock_st);
+
+    /* pooled lines behind a failed line may still run, their responses are dropped */
+    if(batch_pst->pool_x != NULL)
+        (void)wspool_Wait_t(batch_pst->pool_x);
+
+    (void)pthread_join(reader_st, NULL);
+    (void)pthread_cond_destroy(&batch_pst->notFull_st);
+    (void)pthread_cond_destroy(&batch_pst->notEmpty_st);
+    (void)pthread_mutex_destroy(&batch_pst->lock_st);
+
+    return(wserr_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reader thread, fills the free slots of the queue with split lines until the
+ *              end of the script or until the run is stopped
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pv      batch run
+ * @return  NULL
+*//*------------------------------------------------------------------------------------*/
+static void *Reader_pv(void *batch_pv)
+{
+    batch_t *batch_pst = batch_pv;
+    slot_t *slot_pst;
+    int fill_i = 0;
+
+    for(;;)
+    {
+        (void)pthread_mutex_lock(&batch_pst->lock_st);
+        while((batch_pst->count_u == batch_pst->slotCount_u) && !batch_pst->stop_bol)
+            (void)pthread_cond_wait(&batch_pst->notFull_st, &batch_pst->lock_st);
+        if(batch_pst->stop_bol)
+        {
+            (void)pthread_mutex_unlock(&batch_pst->lock_st);
+            break;
+        }
+        slot_pst = &batch_pst->slots_pst[(batch_pst->head_u + batch_pst->count_u) %
+                                            batch_pst->slotCount_u];
+        (void)pthread_mutex_unlock(&batch_pst->lock_st);
+
+        /* the free slot is not visible to the executing thread before count_u grows */
+        fill_i = FillSlot_i(&batch_pst->reader_st, slot_pst);
+        if(fill_i <= 0)
+            break;
+
+        (void)pthread_mutex_lock(&batch_pst->lock_st);
+        batch_pst->count_u++;
+        (void)pthread_cond_signal(&batch_pst->notEmpty_st);
+        (void)pthread_mutex_unlock(&batch_pst->lock_st);
+    }
+
+    (void)pthread_mutex_lock(&batch_pst->lock_st);
+    batch_pst->done_bol = true;
+    batch_pst->readError_bol = (fill_i < 0);
+    (void)pthread_cond_signal(&batch_pst->notEmpty_st);
+    (void)pthread_mutex_unlock(&batch_pst->lock_st);
+
+    return NULL;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Starts the thread pool and one console per worker, the consoles share the
+ *              commands of the console of the batch run and collect the responses in
+ *              the executed slot
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+ * @param   workers_u     number of workers
+ * @return  wserr_OK on success, else the error of the console initialization
+*//*------------------------------------------------------------------------------------*/
+static wserr_t StartWorkers_t(batch_t *batch_pst, size_t workers_u)
+{
+    wsconsole_config_t config_st;
+    wserr_t exeResult_st = wserr_OK;
+    lane_t *lane_pst;
+    size_t idx_u;
+
+    batch_pst->lanes_pst = calloc(workers_u, sizeof(lane_t));
+    if(batch_pst->lanes_pst == NULL)
+        return wserr_ERR_NO_MEM;
+
+    for(idx_u = 0; (idx_u < workers_u) && (wserr_OK == exeResult_st); idx_u++)
+    {
+        lane_pst = &batch_pst->lanes_pst[idx_u];
+        lane_pst->console_x = wsconsole_AllocateConsole_t();
+        if(lane_pst->console_x == NULL)
+        {
+            exeResult_st = wserr_ERR_NO_MEM;
+            break;
+        }
+
+        (void)wsconsole_InitParameter_t(&config_st);
+        config_st.getBufferFunc_fp = NoInput_u;
+        config_st.putCharFunc_fp = CapturePutChar_vd;
+        config_st.writeFunc_fp = CaptureWrite_vd;
+        config_st.outData_pv = lane_pst;
+        config_st.registry_x = batch_pst->console_x;
+        exeResult_st = wsconsole_Init_t(lane_pst->console_x, &config_st);
+    }
+
+    if(wserr_OK == exeResult_st)
+    {
+        batch_pst->pool_x = wspool_AllocatePool_t(workers_u);
+        if(batch_pst->pool_x == NULL)
+            exeResult_st = wserr_ERR_NO_MEM;
+    }
+
+    return(exeResult_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Stops the thread pool and releases the consoles of the workers
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   batch_pst     batch run
+*//*------------------------------------------------------------------------------------*/
+static void StopWorkers_vd(batch_t *batch_pst)
+{
+    size_t idx_u;
+
+    if(batch_pst->pool_x != NULL)
+    {
+        (void)wspool_FreePool_t(batch_pst->pool_x);
+        batch_pst->pool_x = NULL;
+    }
+
+    if(batch_pst->lanes_pst != NULL)
+    {
+        for(idx_u = 0; idx_u < batch_pst->config_pst->workers_u; idx_u++)
+        {
+            if(batch_pst->lanes_pst[idx_u].console_x != NULL)
+            {
+                (void)wsconsole_DeInit_t(batch_pst->lanes_pst[idx_u].console_x);
+                (void)wsconsole_FreeConsole_t(batch_pst->lanes_pst[idx_u].console_x);
+            }
+        }
+        free(batch_pst->lanes_pst);
+        batch_pst->lanes_pst = NULL;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Pool task, executes one independent line on the console of the worker
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   slot_pv       line to execute
+ * @param   worker_u      index of the executing worker
+*//*------------------------------------------------------------------------------------*/
+static void RunTask_vd(void *slot_pv, size_t worker_u)
+{
+    slot_t *slot_pst = slot_pv;
+    batch_t *batch_pst = slot_pst->batch_pst;
+    lane_t *lane_pst = &batch_pst->lanes_pst[worker_u];
+
+    slot_pst->outLen_u = 0;
+    slot_pst->outLost_bol = false;
+    lane_pst->slot_pst = slot_pst;
+    slot_pst->result_st = wsconsole_ExecuteArgv_t(lane_pst->console_x, slot_pst->argc_i,
+                                                    slot_pst->argv_apc);
+    lane_pst->slot_pst = NULL;
+
+    (void)pthread_mutex_lock(&batch_pst->lock_st);
+    slot_pst->done_bol = true;
+    (void)pthread_cond_signal(&batch_pst->notEmpty_st);
+    (void)pthread_mutex_unlock(&batch_pst->lock_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Input function of the worker consoles, they never read input
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   buf_pc        unused
+ * @param   size_u        unused
+ * @return  0, end of input
+*//*------------------------------------------------------------------------------------*/
+static size_t NoInput_u(char *buf_pc, size_t size_u)
+{
+    (void)buf_pc;
+    (void)size_u;
+
+    return 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Output function of the worker consoles, appends the response to the slot
+ *              executed by the worker
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   lane_pv       worker console and its slot
+ * @param   buf_pc        response data
+ * @param   len_u         number of characters
+*//*------------------------------------------------------------------------------------*/
+static void CaptureWrite_vd(void *lane_pv, const char *buf_pc, size_t len_u)
+{
+    lane_t *lane_pst = lane_pv;
+    slot_t *slot_pst = lane_pst->slot_pst;
+    size_t size_u;
+    char *out_pc;
+
+    if((slot_pst == NULL) || (len_u == 0))
+        return;
+
+    if(slot_pst->outLen_u + len_u > slot_pst->outSize_u)
+    {
+        size_u = (slot_pst->outSize_u > 0) ? slot_pst->outSize_u : WSBATCH_MAX_LINE;
+        while(size_u < slot_pst->outLen_u + len_u)
+            size_u *= 2U;
+
+        out_pc = realloc(slot_pst->out_pc, size_u);
+        if(out_pc == NULL)
+        {
+            slot_pst->outLost_bol = true;
+            return;
+        }
+        slot_pst->out_pc = out_pc;
+        slot_pst->outSize_u = size_u;
+    }
+
+    memcpy(&slot_pst->out_pc[slot_pst->outLen_u], buf_pc, len_u);
+    slot_pst->outLen_u += len_u;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Character output function of the worker consoles
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   lane_pv       worker console and its slot
+ * @param   ch_c          character to append
+ * @param   isLast_bol    unused
+*//*------------------------------------------------------------------------------------*/
+static void CapturePutChar_vd(void *lane_pv, char ch_c, bool isLast_bol)
+{
+    (void)isLast_bol;
+
+    CaptureWrite_vd(lane_pv, &ch_c, 1);
+}
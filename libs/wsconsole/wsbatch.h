@@ -0,0 +1,170 @@
+/*****************************************************************************************
+* FILENAME :        wsbatch.h
+*
+* DESCRIPTION :
+*       Header file for the batch mode of the console. A command script is read from
+*       a file or a pipe and executed without the interactive line editor, there is
+*       no echo, no terminal control output and no history.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wserr_LOG(wsbatch_InitParameter_t(&batchConfig_sts));
+*   batchConfig_sts.fd_i = open("provision.cli", O_RDONLY);
+*
+*   exeResult_st = wsbatch_Run_t(console_xs, &batchConfig_sts, &failed_u);
+*
+*   Every line of the script is split with embedded_cli_tokenize and executed with
+*   wsconsole_ExecuteArgv_t. Empty lines and lines starting with '#' are skipped.
+*   Regular files are mapped into memory, pipes are read in large blocks. With
+*   pipeline_bol a reader thread reads and splits the next lines while the current
+*   command executes on the calling thread.
+*
+*   With workers_u > 0 the commands registered as independent run in parallel on a
+*   work stealing thread pool, each worker executes them on its own console which
+*   shares the commands of console_x. Their responses are collected and written
+*   in script order. Any other command waits until all lines before it are done
+*   and runs on the calling thread.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSBATCH_H
+#define WSBATCH_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "wserr.h"
+#include "wsconsole.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSBATCH_READ_BUF_LEN
+/**
+ * Number of bytes requested with one read() call if the script is not mapped
+ */
+#define WSBATCH_READ_BUF_LEN 65536
+#endif
+
+#ifndef WSBATCH_MAX_LINE
+/**
+ * Maximum length of a script line including the terminating nul
+ */
+#define WSBATCH_MAX_LINE 1024
+#endif
+
+#ifndef WSBATCH_MAX_ARGC
+/**
+ * Number of argument entries of a script line including the terminating NULL, by
+ * default enough for any line of WSBATCH_MAX_LINE bytes
+ */
+#define WSBATCH_MAX_ARGC (WSBATCH_MAX_LINE / 2 + 1)
+#endif
+
+#ifndef WSBATCH_QUEUE_LEN
+/**
+ * Number of lines the reader thread may split ahead of the executed command
+ */
+#define WSBATCH_QUEUE_LEN 64
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/**
+ * @brief Parameters of a batch run
+ */
+typedef struct wsbatch_config_tag
+{
+    /**
+     * File descriptor of the script, e.g. an opened file or STDIN_FILENO
+     */
+    int fd_i;
+    /**
+     * Stop at the first failed line, else the failure is reported and the run
+     * continues with the next line
+     */
+    bool stopOnError_bol;
+    /**
+     * Read and split the next lines on a reader thread while a command executes
+     */
+    bool pipeline_bol;
+    /**
+     * Number of threads executing independent commands in parallel, 0 executes
+     * every line on the calling thread. Implies pipeline_bol.
+     */
+    size_t workers_u;
+    /**
+     * Stream for the line numbers of failed lines, NULL to suppress them
+     */
+    FILE *errStream_fp;
+} wsbatch_config_t;
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   initializes the configuration with default values
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   config_stp    configuration to initialize
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if config_stp is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsbatch_InitParameter_t(wsbatch_config_t *config_stp);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   executes the script line by line on the console until the end of the input
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     initialized console with the commands
+ * @param   config_stp    configuration of the run
+ * @param   failed_pu     receives the number of failed lines, may be NULL
+ * @return
+ *          - wserr_OK if all lines were executed successfully
+ *          - wserr_ERR_GEN if at least one line failed or the script could not be read
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_NO_MEM if out of memory or threads
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsbatch_Run_t(wsconsole_tp console_x, const wsbatch_config_t *config_stp,
+                                size_t *failed_pu);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSBATCH_H
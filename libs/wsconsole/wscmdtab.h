@@ -0,0 +1,186 @@
+/*****************************************************************************************
+* FILENAME :        wscmdtab.h
+*
+* DESCRIPTION :
+*       Header file for command tables generated at build time. The commands are
+*       listed in a definition file, the generator wscmdgen computes a minimal
+*       perfect hash over the command names and the table is placed in read only
+*       memory. Registering the table needs no allocation per command and a name is
+*       found with one hash and one string compare.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   commands.def, one line per command:
+*       WSCMD(add, AddCommand_t, "Adds two numbers.", NULL, addArgs_apv, false, true)
+*
+*   Build step, creates the hash parameters of the definition file:
+*       wscmdgen commands.def commands_hash.h
+*
+*   Source file defining the table:
+*       #include "wscmdtab.h"
+*       #include "commands_hash.h"
+*
+*       #define WSCMD WSCMDTAB_ITEM
+*       static const wsconsole_cmdItem_t commandItems_cast[WSCMDTAB_COUNT] =
+*       {
+*       #include "commands.def"
+*       };
+*       #undef WSCMD
+*       WSCMDTAB_TABLE(commandTable_cst, commandItems_cast);
+*
+*       wserr_LOG(wsconsole_RegisterTable_t(console_xs, &commandTable_cst));
+*
+*   The parameters of WSCMD are the command name, which must be a C identifier, the
+*   callback, help, hint, argtable, atomic and independent, see wsconsole_cmdItem_t.
+*   The argtable is an array with static storage, its entries are created at run
+*   time before the table is registered.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSCMDTAB_H
+#define WSCMDTAB_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "wsconsole.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+/**
+ * Multiplier spreading the seed of a bucket over the hash value
+ */
+#define WSCMDTAB_SEED_MULT 0x9E3779B9U
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/**
+ * Table entry of one WSCMD line of the definition file, the entry is placed at the
+ * slot the generator assigned to the name
+ */
+#define WSCMDTAB_ITEM(name_, func_, help_, hint_, argtable_, atomic_, independent_) \
+    [WSCMDTAB_SLOT_##name_] =                                                       \
+    {                                                                               \
+        .command = #name_,                                                          \
+        .help = (help_),                                                            \
+        .hint = (hint_),                                                            \
+        .func = (func_),                                                            \
+        .argtable = (argtable_),                                                    \
+        .atomic = (atomic_),                                                        \
+        .independent = (independent_)                                               \
+    },
+
+/**
+ * Defines the command table table_ over the entries items_, with the hash
+ * parameters of the generated header
+ */
+#define WSCMDTAB_TABLE(table_, items_)                                              \
+    static const uint16_t table_##Seeds_cau16[WSCMDTAB_BUCKETS] = WSCMDTAB_SEEDS;   \
+    static const uint16_t table_##Order_cau16[WSCMDTAB_COUNT] = WSCMDTAB_ORDER;     \
+    static const wsconsole_cmdTable_t table_ =                                      \
+    {                                                                               \
+        .items_pcst = (items_),                                                     \
+        .count_u = WSCMDTAB_COUNT,                                                  \
+        .seeds_pcu16 = table_##Seeds_cau16,                                         \
+        .buckets_u = WSCMDTAB_BUCKETS,                                              \
+        .order_pcu16 = table_##Order_cau16                                          \
+    }
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   calculates the FNV-1a hash of a command name, the same hash is used for the
+ *              commands registered at run time
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   name_cpc      nul terminated command name
+ * @return  32 bit hash value
+*//*------------------------------------------------------------------------------------*/
+static inline uint32_t wscmdtab_Hash_u32(const char *name_cpc)
+{
+    uint32_t hash_u32 = 2166136261U;
+
+    while(*name_cpc != '\0')
+    {
+        hash_u32 ^= (uint8_t)*name_cpc++;
+        hash_u32 *= 16777619U;
+    }
+    return hash_u32;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   derives a further hash value from the name hash and a seed, so the name is
+ *              hashed only once for the bucket and the slot
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hash_u32      hash of the name, see wscmdtab_Hash_u32
+ * @param   seed_u32      seed, 0 for the bucket
+ * @return  32 bit hash value
+*//*------------------------------------------------------------------------------------*/
+static inline uint32_t wscmdtab_Mix_u32(uint32_t hash_u32, uint32_t seed_u32)
+{
+    hash_u32 ^= seed_u32 * WSCMDTAB_SEED_MULT;
+    hash_u32 ^= hash_u32 >> 16;
+    hash_u32 *= 0x85EBCA6BU;
+    hash_u32 ^= hash_u32 >> 13;
+    hash_u32 *= 0xC2B2AE35U;
+    hash_u32 ^= hash_u32 >> 16;
+    return hash_u32;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the only table slot a name can be stored in
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   table_pcst    command table
+ * @param   hash_u32      hash of the name, see wscmdtab_Hash_u32
+ * @return  slot index, the caller compares the name stored there
+*//*------------------------------------------------------------------------------------*/
+static inline size_t wscmdtab_Slot_u(const wsconsole_cmdTable_t *table_pcst, uint32_t hash_u32)
+{
+    uint32_t bucket_u32 = wscmdtab_Mix_u32(hash_u32, 0U) % (uint32_t)table_pcst->buckets_u;
+
+    return(wscmdtab_Mix_u32(hash_u32, table_pcst->seeds_pcu16[bucket_u32])
+            % (uint32_t)table_pcst->count_u);
+}
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSCMDTAB_H
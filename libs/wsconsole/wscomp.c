@@ -0,0 +1,1241 @@
+/****************************************************************************************
+* FILENAME :        wscomp.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the argument completion of the console
+*
+* DETAILED DESCRIPTION :
+*   The index of an argument table is built once. A completion scans the words in
+*   front of the cursor once: a long option is looked up in the prefix index, a
+*   short option in the table by character, every other word moves on to the next
+*   positional argument. The cost of a Tab depends on the length of the line, not on
+*   the number of options. File names are completed from a sorted copy of the
+*   directory listing, found with two binary searches.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include <ctype.h>
+#include <pthread.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "wscomp.h"
+
+#include "wserr.h"
+#include "wsargs.h"
+#include "wstrie.h"
+#include "embedded_cli.h"
+#include "argtable3.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Number of characters of a long option name inserted at most with one Tab
+ */
+#define COMMON_LEN 64U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Indexed entry of the argument table
+ */
+typedef struct optEntry_tag
+{
+    const struct arg_hdr *hdr_pcst;
+    /**
+     * the entry takes a value, the value may be omitted
+     */
+    bool value_bol;
+    bool optValue_bol;
+    /**
+     * the value is a file name
+     */
+    bool file_bol;
+}optEntry_t;
+
+/**
+ * @brief One long option name, an entry may have several
+ */
+typedef struct longName_tag
+{
+    const char *name_cpc;
+    size_t len_u;
+    optEntry_t *opt_pst;
+}longName_t;
+
+/**
+ * @brief Completion index of an argument table
+ */
+typedef struct wscomp_tag
+{
+    /**
+     * entries of the table without arg_rem and arg_end
+     */
+    optEntry_t *opts_pst;
+    size_t optCount_u;
+    /**
+     * long option names, the names are stored nul terminated in names_pc
+     */
+    longName_t *longs_pst;
+    char *names_pc;
+    wstrie_t longIndex_st;
+    /**
+     * entry of every short option character, index into opts_pst plus 1
+     */
+    uint16_t short_au16[UCHAR_MAX + 1];
+    /**
+     * entries without option name in table order
+     */
+    optEntry_t **pos_ppst;
+    size_t posCount_u;
+}wscomp_t;
+
+/**
+ * @brief State of the scan over the words in front of the cursor
+ */
+typedef struct scanState_tag
+{
+    /**
+     * option waiting for its value in the next word, else NULL
+     */
+    const optEntry_t *value_pcst;
+    /**
+     * positional entry of the next positional word and the words it holds already
+     */
+    size_t posIdx_u;
+    int posCount_i;
+    /**
+     * "--" ends the options
+     */
+    bool endOpts_bol;
+}scanState_t;
+
+/**
+ * @brief What a Tab does with the word at the cursor
+ */
+typedef enum compKind_tag
+{
+    COMP_NONE,
+    COMP_PATH,
+    COMP_HINT,
+    COMP_LONG
+}compKind_t;
+
+/**
+ * @brief Word at the cursor and how it is completed
+ */
+typedef struct compWord_tag
+{
+    compKind_t kind_en;
+    /**
+     * typed part of the path or of the long option name
+     */
+    const char *word_cpc;
+    size_t len_u;
+    /**
+     * expected entry of a hint, shown in brackets if optional_bol is set
+     */
+    const optEntry_t *opt_pcst;
+    bool optional_bol;
+    /**
+     * dashes printed in front of the listed long option names
+     */
+    const char *prefix_cpc;
+}compWord_t;
+
+/**
+ * @brief Cached listing of a directory, the names of sub directories end with '/'
+ */
+typedef struct dirCache_tag
+{
+    /**
+     * directory as given, NULL if the slot is unused
+     */
+    char *path_pc;
+    dev_t dev_st;
+    ino_t ino_st;
+    off_t size_st;
+    struct timespec mtime_st;
+    /**
+     * names and the sorted pointers to them
+     */
+    char *names_pc;
+    char **sorted_ppc;
+    size_t count_u;
+    /**
+     * time of the last use, the least recently used slot is reused
+     */
+    unsigned long used_u;
+}dirCache_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static size_t NextWord_u(const char *line_cpc, size_t pos_u, size_t end_u, size_t *start_pu);
+static void ScanWord_vd(const wscomp_t *comp_pcst, scanState_t *state_pst,
+                        const char *word_cpc, size_t len_u);
+static const optEntry_t *FindLong_pcst(const wscomp_t *comp_pcst, const char *name_cpc,
+                                        size_t len_u);
+static const optEntry_t *FindShort_pcst(const wscomp_t *comp_pcst, char ch_c);
+static void CompleteLong_vd(const wscomp_t *comp_pcst, struct embedded_cli *cli_pst,
+                            const char *prefix_cpc, size_t len_u, const char *dash_cpc,
+                            size_t listMax_u);
+static bool ListLong_bol(void *list_pv, void *long_pv);
+static bool FindWord_bol(const wscomp_t *comp_pcst, const char *line_cpc, int cursor_i,
+                            compWord_t *word_pst);
+static void CompletePath_vd(struct embedded_cli *cli_pst, const char *word_cpc, size_t len_u,
+                            size_t listMax_u);
+static bool SplitPath_bol(const char *word_cpc, size_t len_u, char *path_pc, char *dir_pc,
+                            size_t *dirLen_pu);
+static void ShowHint_vd(struct embedded_cli *cli_pst, const optEntry_t *opt_pcst,
+                        bool optional_bol);
+static void Print_vd(struct embedded_cli *cli_pst, const char *text_cpc);
+static dirCache_t *GetDir_pst(const char *path_cpc);
+static bool LoadDir_bol(dirCache_t *dir_pst, const char *path_cpc, const struct stat *stat_pcst);
+static void ClearDir_vd(dirCache_t *dir_pst);
+static int CompareNames_i(const void *a_pv, const void *b_pv);
+static size_t LowerBound_u(const dirCache_t *dir_pcst, const char *name_cpc);
+static size_t PrefixEnd_u(const dirCache_t *dir_pcst, const char *prefix_cpc, size_t len_u,
+                            size_t lo_u);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Directory listings shared by all consoles and the lock protecting them
+ */
+static dirCache_t dirCache_sax[WSCOMP_DIR_CACHE_LEN];
+static unsigned long dirTick_us = 0;
+static pthread_mutex_t dirLock_xs = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Listing read by wscomp_Prepare_vd on this thread and its time of use, the next
+ * completion takes it without checking the directory again
+ */
+static __thread dirCache_t *prepared_xspst = NULL;
+static __thread unsigned long preparedTick_xsu = 0;
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Indexes the entries of an argument table
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wscomp_tp wscomp_Build_tp(void **argtable_ppv)
+{
+    struct arg_hdr **table_ppst = (struct arg_hdr **)argtable_ppv;
+    const struct arg_hdr *hdr_pcst;
+    wscomp_t *comp_pst;
+    optEntry_t *opt_pst;
+    size_t count_u = 0;
+    size_t chars_u = 0;
+    size_t longs_u = 0;
+    size_t idx_u;
+    size_t longCount_u = 0;
+    char *name_pc;
+    const char *short_cpc;
+
+    if(table_ppst == NULL)
+        return NULL;
+
+    /* size the arrays: entries and the characters of all long option names */
+    while((table_ppst[count_u] != NULL) && !(table_ppst[count_u]->flag & ARG_TERMINATOR))
+    {
+        if(table_ppst[count_u]->longopts != NULL)
+        {
+            chars_u += strlen(table_ppst[count_u]->longopts) + 1U;
+            for(short_cpc = table_ppst[count_u]->longopts; *short_cpc != '\0'; short_cpc++)
+            {
+                longs_u += (*short_cpc == ',') ? 1U : 0U;
+            }
+            longs_u++;
+        }
+        count_u++;
+    }
+
+    if(count_u >= UINT16_MAX)
+        return NULL;
+
+    comp_pst = calloc(1, sizeof(wscomp_t));
+    if(comp_pst == NULL)
+        return NULL;
+
+    wstrie_Init_vd(&comp_pst->longIndex_st);
+    comp_pst->opts_pst = calloc(count_u + 1U, sizeof(optEntry_t));
+    comp_pst->pos_ppst = calloc(count_u + 1U, sizeof(optEntry_t *));
+    comp_pst->longs_pst = calloc(longs_u + 1U, sizeof(longName_t));
+    comp_pst->names_pc = malloc(chars_u + 1U);
+    if((comp_pst->opts_pst == NULL) || (comp_pst->pos_ppst == NULL)
+        || (comp_pst->longs_pst == NULL) || (comp_pst->names_pc == NULL)
+        || (wstrie_Reserve_t(&comp_pst->longIndex_st, chars_u) != wserr_OK))
+    {
+        wscomp_Free_vd(comp_pst);
+        return NULL;
+    }
+
+    name_pc = comp_pst->names_pc;
+    for(idx_u = 0; idx_u < count_u; idx_u++)
+    {
+        hdr_pcst = table_ppst[idx_u];
+
+        /* arg_rem only adds text to the glossary */
+        if(hdr_pcst->scanfn == NULL)
+            continue;
+
+        opt_pst = &comp_pst->opts_pst[comp_pst->optCount_u++];
+        opt_pst->hdr_pcst = hdr_pcst;
+        opt_pst->value_bol = ((hdr_pcst->flag & ARG_HASVALUE) != 0);
+        opt_pst->optValue_bol = ((hdr_pcst->flag & ARG_HASOPTVALUE) != 0);
+        opt_pst->file_bol = wsargs_IsFile_bol(hdr_pcst);
+
+        if(((hdr_pcst->shortopts == NULL) || (hdr_pcst->shortopts[0] == '\0'))
+            && ((hdr_pcst->longopts == NULL) || (hdr_pcst->longopts[0] == '\0')))
+        {
+            comp_pst->pos_ppst[comp_pst->posCount_u++] = opt_pst;
+            continue;
+        }
+
+        /* the first entry of an option character wins, as in arg_parse */
+        for(short_cpc = hdr_pcst->shortopts; (short_cpc != NULL) && (*short_cpc != '\0');
+            short_cpc++)
+        {
+            if(comp_pst->short_au16[(unsigned char)*short_cpc] == 0)
+                comp_pst->short_au16[(unsigned char)*short_cpc] =
+                                                (uint16_t)comp_pst->optCount_u;
+        }
+
+        if(hdr_pcst->longopts == NULL)
+            continue;
+
+        /* split the comma separated names into nul terminated keys */
+        strcpy(name_pc, hdr_pcst->longopts);
+        while(*name_pc != '\0')
+        {
+            comp_pst->longs_pst[longCount_u].name_cpc = name_pc;
+            comp_pst->longs_pst[longCount_u].len_u = strcspn(name_pc, ",");
+            comp_pst->longs_pst[longCount_u].opt_pst = opt_pst;
+            name_pc += comp_pst->longs_pst[longCount_u].len_u;
+            if(*name_pc == ',')
+                *name_pc++ = '\0';
+
+            /* empty and repeated names are skipped */
+            if(comp_pst->longs_pst[longCount_u].len_u > 0)
+            {
+                (void)wstrie_Insert_t(&comp_pst->longIndex_st,
+                                        comp_pst->longs_pst[longCount_u].name_cpc,
+                                        &comp_pst->longs_pst[longCount_u]);
+            }
+            longCount_u++;
+        }
+        name_pc++;
+    }
+
+    return(comp_pst);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Releases a completion index
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wscomp_Free_vd(wscomp_tp comp_x)
+{
+    if(comp_x == NULL)
+        return;
+
+    wstrie_Free_vd(&comp_x->longIndex_st);
+    free(comp_x->opts_pst);
+    free(comp_x->pos_ppst);
+    free(comp_x->longs_pst);
+    free(comp_x->names_pc);
+    free(comp_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Completes the argument at the cursor
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wscomp_Complete_vd(wscomp_tp comp_x, struct embedded_cli *cli_pst,
+                        const char *line_cpc, int cursor_i, size_t listMax_u)
+{
+    compWord_t word_st;
+
+    if((comp_x == NULL) || (cli_pst == NULL)
+        || !FindWord_bol(comp_x, line_cpc, cursor_i, &word_st))
+        return;
+
+    switch(word_st.kind_en)
+    {
+        case COMP_PATH:
+            CompletePath_vd(cli_pst, word_st.word_cpc, word_st.len_u, listMax_u);
+            break;
+        case COMP_HINT:
+            ShowHint_vd(cli_pst, word_st.opt_pcst, word_st.optional_bol);
+            break;
+        case COMP_LONG:
+            CompleteLong_vd(comp_x, cli_pst, word_st.word_cpc, word_st.len_u,
+                            word_st.prefix_cpc, listMax_u);
+            break;
+        default:
+            break;
+    }
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Reads the directory listing a Tab at the cursor needs
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wscomp_Prepare_vd(wscomp_tp comp_x, const char *line_cpc, int cursor_i)
+{
+    char path_ca[PATH_MAX];
+    char dir_ca[PATH_MAX];
+    compWord_t word_st;
+    size_t dirLen_u;
+
+    prepared_xspst = NULL;
+    if((comp_x == NULL) || !FindWord_bol(comp_x, line_cpc, cursor_i, &word_st)
+        || (word_st.kind_en != COMP_PATH)
+        || !SplitPath_bol(word_st.word_cpc, word_st.len_u, path_ca, dir_ca, &dirLen_u))
+        return;
+
+    (void)pthread_mutex_lock(&dirLock_xs);
+    prepared_xspst = GetDir_pst(dir_ca);
+    if(prepared_xspst != NULL)
+        preparedTick_xsu = prepared_xspst->used_u;
+    (void)pthread_mutex_unlock(&dirLock_xs);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Starts a candidate list
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wscomp_ListBegin_vd(wscomp_list_t *list_pst, struct embedded_cli *cli_pst,
+                            size_t listMax_u)
+{
+    list_pst->cli_pst = cli_pst;
+    list_pst->column_u = 0;
+    list_pst->left_u = listMax_u;
+    list_pst->cut_bol = false;
+    embedded_cli_print(cli_pst, "\n", 1);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Adds a candidate to the list
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+bool wscomp_ListAdd_bol(wscomp_list_t *list_pst, const char *prefix_cpc,
+                        const char *name_cpc, size_t len_u)
+{
+    size_t prefix_u = (prefix_cpc != NULL) ? strlen(prefix_cpc) : 0;
+
+    if(list_pst->left_u == 0)
+    {
+        list_pst->cut_bol = true;
+        return false;
+    }
+
+    if((list_pst->column_u > 0)
+        && (list_pst->column_u + 2U + prefix_u + len_u > WSCOMP_LIST_COLUMNS))
+    {
+        embedded_cli_print(list_pst->cli_pst, "\n", 1);
+        list_pst->column_u = 0;
+    }
+    else if(list_pst->column_u > 0)
+    {
+        embedded_cli_print(list_pst->cli_pst, "  ", 2);
+        list_pst->column_u += 2U;
+    }
+    embedded_cli_print(list_pst->cli_pst, prefix_cpc, prefix_u);
+    embedded_cli_print(list_pst->cli_pst, name_cpc, len_u);
+    list_pst->column_u += prefix_u + len_u;
+    list_pst->left_u--;
+
+    return true;
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Ends the candidate list
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wscomp_ListEnd_vd(wscomp_list_t *list_pst)
+{
+    if(list_pst->cut_bol)
+        embedded_cli_print(list_pst->cli_pst, " ...", 4);
+    embedded_cli_print(list_pst->cli_pst, "\n", 1);
+    embedded_cli_redraw(list_pst->cli_pst);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Finds the next word of the line, blanks inside quotes and escaped blanks
+ *              belong to the word
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   line_cpc    line
+ * @param   pos_u       position to start from
+ * @param   end_u       end of the scanned part of the line
+ * @param   start_pu    receives the start of the word, end_u if there is none
+ * @return  end of the word
+*//*------------------------------------------------------------------------------------*/
+static size_t NextWord_u(const char *line_cpc, size_t pos_u, size_t end_u, size_t *start_pu)
+{
+    char quote_c = '\0';
+
+    while((pos_u < end_u) && isspace((unsigned char)line_cpc[pos_u]))
+        pos_u++;
+
+    *start_pu = pos_u;
+    while(pos_u < end_u)
+    {
+        if(quote_c != '\0')
+        {
+            if(line_cpc[pos_u] == quote_c)
+                quote_c = '\0';
+        }
+        else if(isspace((unsigned char)line_cpc[pos_u]))
+        {
+            break;
+        }
+        else if((line_cpc[pos_u] == '"') || (line_cpc[pos_u] == '\''))
+        {
+            quote_c = line_cpc[pos_u];
+        }
+        else if(line_cpc[pos_u] == '\\')
+        {
+            pos_u++;
+        }
+        pos_u++;
+    }
+
+    return((pos_u < end_u) ? pos_u : end_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Moves the scan state over one complete word in front of the cursor, the
+ *              words are assigned like arg_parse does
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_pcst   completion index
+ * @param   state_pst   scan state
+ * @param   word_cpc    word
+ * @param   len_u       length of the word
+*//*------------------------------------------------------------------------------------*/
+static void ScanWord_vd(const wscomp_t *comp_pcst, scanState_t *state_pst,
+                        const char *word_cpc, size_t len_u)
+{
+    const optEntry_t *opt_pcst;
+    const char *equal_cpc;
+    size_t idx_u;
+
+    if(state_pst->value_pcst != NULL)
+    {
+        state_pst->value_pcst = NULL;
+        return;
+    }
+
+    if(!state_pst->endOpts_bol && (len_u > 1) && (word_cpc[0] == '-'))
+    {
+        if(word_cpc[1] == '-')
+        {
+            if(len_u == 2)
+            {
+                state_pst->endOpts_bol = true;
+                return;
+            }
+            /* --name value, unless the value is attached with = */
+            equal_cpc = memchr(word_cpc, '=', len_u);
+            opt_pcst = FindLong_pcst(comp_pcst, &word_cpc[2],
+                        (equal_cpc != NULL) ? (size_t)(equal_cpc - word_cpc) - 2U : len_u - 2U);
+            if((opt_pcst != NULL) && opt_pcst->value_bol && !opt_pcst->optValue_bol
+                && (equal_cpc == NULL))
+            {
+                state_pst->value_pcst = opt_pcst;
+            }
+            return;
+        }
+
+        /* -abc, the first option taking a value takes the rest or the next word */
+        for(idx_u = 1; idx_u < len_u; idx_u++)
+        {
+            opt_pcst = FindShort_pcst(comp_pcst, word_cpc[idx_u]);
+            if(opt_pcst == NULL)
+                return;
+            if(opt_pcst->value_bol)
+            {
+                if((idx_u == len_u - 1U) && !opt_pcst->optValue_bol)
+                    state_pst->value_pcst = opt_pcst;
+                return;
+            }
+        }
+        return;
+    }
+
+    /* positional word, the entries are filled up to their maximum count in order */
+    if(state_pst->posIdx_u < comp_pcst->posCount_u)
+    {
+        state_pst->posCount_i++;
+        if(state_pst->posCount_i >= comp_pcst->pos_ppst[state_pst->posIdx_u]->hdr_pcst->maxcount)
+        {
+            state_pst->posIdx_u++;
+            state_pst->posCount_i = 0;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Looks up the entry of a long option name
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_pcst   completion index
+ * @param   name_cpc    name without the leading dashes
+ * @param   len_u       length of the name
+ * @return  entry of the option, NULL if unknown
+*//*------------------------------------------------------------------------------------*/
+static const optEntry_t *FindLong_pcst(const wscomp_t *comp_pcst, const char *name_cpc,
+                                        size_t len_u)
+{
+    const longName_t *long_pcst = wstrie_Find_pv(&comp_pcst->longIndex_st, name_cpc, len_u);
+
+    return((long_pcst != NULL) ? long_pcst->opt_pst : NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Looks up the entry of a short option character
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_pcst   completion index
+ * @param   ch_c        option character
+ * @return  entry of the option, NULL if unknown
+*//*------------------------------------------------------------------------------------*/
+static const optEntry_t *FindShort_pcst(const wscomp_t *comp_pcst, char ch_c)
+{
+    uint16_t idx_u16 = comp_pcst->short_au16[(unsigned char)ch_c];
+
+    return((idx_u16 != 0) ? &comp_pcst->opts_pst[idx_u16 - 1U] : NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Completes a long option name, a unique name is finished with '=' if the
+ *              option needs a value, else with a blank
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_pcst   completion index
+ * @param   cli_pst     line editor
+ * @param   prefix_cpc  typed part of the name, without dashes
+ * @param   len_u       length of the typed part
+ * @param   dash_cpc    dashes missing in front of the name
+ * @param   listMax_u   maximum number of listed candidates
+*//*------------------------------------------------------------------------------------*/
+static void CompleteLong_vd(const wscomp_t *comp_pcst, struct embedded_cli *cli_pst,
+                            const char *prefix_cpc, size_t len_u, const char *dash_cpc,
+                            size_t listMax_u)
+{
+    wstrie_match_t match_st;
+    wscomp_list_t list_st;
+    const longName_t *long_pcst;
+    char common_ca[COMMON_LEN];
+    size_t common_u;
+
+    if(wstrie_Match_u(&comp_pcst->longIndex_st, prefix_cpc, len_u, &match_st) == 0)
+        return;
+
+    /* the dashes are inserted only together with a part of the name */
+    common_u = wstrie_Common_u(&comp_pcst->longIndex_st, &match_st, common_ca,
+                                sizeof(common_ca));
+    if((common_u > 0) || (match_st.keys_u == 1))
+        embedded_cli_insert_text(cli_pst, dash_cpc, strlen(dash_cpc));
+    embedded_cli_insert_text(cli_pst, common_ca, common_u);
+
+    if(match_st.keys_u == 1)
+    {
+        long_pcst = match_st.value_pv;
+        embedded_cli_insert_text(cli_pst,
+            (long_pcst->opt_pst->value_bol && !long_pcst->opt_pst->optValue_bol) ? "=" : " ", 1);
+        return;
+    }
+
+    wscomp_ListBegin_vd(&list_st, cli_pst, listMax_u);
+    wstrie_ForEach_vd(&comp_pcst->longIndex_st, &match_st, ListLong_bol, &list_st);
+    wscomp_ListEnd_vd(&list_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Adds a long option name to the candidate list
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   list_pv     candidate list
+ * @param   long_pv     matching long option name
+ * @return  false if the list is full
+*//*------------------------------------------------------------------------------------*/
+static bool ListLong_bol(void *list_pv, void *long_pv)
+{
+    const longName_t *long_pcst = long_pv;
+
+    return(wscomp_ListAdd_bol(list_pv, "--", long_pcst->name_cpc, long_pcst->len_u));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Finds the word at the cursor and how a Tab completes it
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_pcst   completion index
+ * @param   line_cpc    line being edited, the first word is the command name
+ * @param   cursor_i    cursor position in the line
+ * @param   word_pst    receives the word and the kind of completion
+ * @return  false if the cursor is at the command name
+*//*------------------------------------------------------------------------------------*/
+static bool FindWord_bol(const wscomp_t *comp_pcst, const char *line_cpc, int cursor_i,
+                            compWord_t *word_pst)
+{
+    scanState_t state_st = { .value_pcst = NULL, .posIdx_u = 0, .posCount_i = 0,
+                                .endOpts_bol = false };
+    const optEntry_t *opt_pcst;
+    const char *word_cpc;
+    const char *equal_cpc;
+    size_t cursor_u;
+    size_t start_u;
+    size_t end_u;
+    size_t len_u;
+
+    if((line_cpc == NULL) || (cursor_i <= 0))
+        return false;
+
+    /* the command name is completed by the console */
+    cursor_u = (size_t)cursor_i;
+    end_u = NextWord_u(line_cpc, 0, cursor_u, &start_u);
+    if(end_u >= cursor_u)
+        return false;
+
+    /* all words in front of the word at the cursor */
+    while(true)
+    {
+        end_u = NextWord_u(line_cpc, end_u, cursor_u, &start_u);
+        if(end_u == cursor_u)
+            break;
+        ScanWord_vd(comp_pcst, &state_st, &line_cpc[start_u], end_u - start_u);
+    }
+    word_cpc = &line_cpc[start_u];
+    len_u = cursor_u - start_u;
+
+    word_pst->kind_en = COMP_NONE;
+    word_pst->word_cpc = word_cpc;
+    word_pst->len_u = len_u;
+    word_pst->opt_pcst = NULL;
+    word_pst->optional_bol = false;
+    word_pst->prefix_cpc = "";
+
+    /* value of the option in front */
+    if(state_st.value_pcst != NULL)
+    {
+        word_pst->opt_pcst = state_st.value_pcst;
+        if(state_st.value_pcst->file_bol)
+            word_pst->kind_en = COMP_PATH;
+        else if(len_u == 0)
+            word_pst->kind_en = COMP_HINT;
+        return true;
+    }
+
+    if(!state_st.endOpts_bol && (len_u >= 2) && (word_cpc[0] == '-') && (word_cpc[1] == '-'))
+    {
+        /* --name=value completes the value, else the name */
+        equal_cpc = memchr(word_cpc, '=', len_u);
+        if(equal_cpc == NULL)
+        {
+            word_pst->kind_en = COMP_LONG;
+            word_pst->word_cpc = &word_cpc[2];
+            word_pst->len_u = len_u - 2U;
+            return true;
+        }
+        opt_pcst = FindLong_pcst(comp_pcst, &word_cpc[2], (size_t)(equal_cpc - word_cpc) - 2U);
+        if((opt_pcst != NULL) && opt_pcst->file_bol)
+        {
+            word_pst->kind_en = COMP_PATH;
+            word_pst->word_cpc = equal_cpc + 1;
+            word_pst->len_u = len_u - (size_t)(equal_cpc + 1 - word_cpc);
+        }
+        return true;
+    }
+
+    if(!state_st.endOpts_bol && (len_u == 1) && (word_cpc[0] == '-'))
+    {
+        word_pst->kind_en = COMP_LONG;
+        word_pst->len_u = 0;
+        word_pst->prefix_cpc = "-";
+        return true;
+    }
+
+    /* short options are not completed */
+    if(!state_st.endOpts_bol && (len_u > 0) && (word_cpc[0] == '-'))
+        return true;
+
+    opt_pcst = (state_st.posIdx_u < comp_pcst->posCount_u) ?
+                    comp_pcst->pos_ppst[state_st.posIdx_u] : NULL;
+    word_pst->opt_pcst = opt_pcst;
+    if((opt_pcst != NULL) && opt_pcst->file_bol)
+    {
+        word_pst->kind_en = COMP_PATH;
+    }
+    else if((opt_pcst != NULL) && (len_u == 0))
+    {
+        word_pst->kind_en = COMP_HINT;
+        word_pst->optional_bol = (opt_pcst->hdr_pcst->mincount == 0);
+    }
+    else if((len_u == 0) && !state_st.endOpts_bol)
+    {
+        /* no positional argument left, offer the options */
+        word_pst->kind_en = COMP_LONG;
+        word_pst->prefix_cpc = "--";
+    }
+
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Completes a file name from the cached listing of its directory, a unique
+ *              file is finished with a blank, a directory with '/'. Hidden files are
+ *              offered if the typed name starts with a dot.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cli_pst     line editor
+ * @param   word_cpc    typed part of the path
+ * @param   len_u       length of the typed part
+ * @param   listMax_u   maximum number of listed candidates
+*//*------------------------------------------------------------------------------------*/
+static void CompletePath_vd(struct embedded_cli *cli_pst, const char *word_cpc, size_t len_u,
+                            size_t listMax_u)
+{
+    char path_ca[PATH_MAX];
+    char dir_ca[PATH_MAX];
+    const char *base_cpc;
+    const char *first_cpc;
+    const char *last_cpc;
+    dirCache_t *dir_pst;
+    wscomp_list_t list_st;
+    size_t dirLen_u;
+    size_t baseLen_u;
+    size_t lo_u;
+    size_t hi_u;
+    size_t dotLo_u;
+    size_t dotHi_u;
+    size_t common_u;
+    size_t idx_u;
+
+    if(!SplitPath_bol(word_cpc, len_u, path_ca, dir_ca, &dirLen_u))
+        return;
+    base_cpc = &path_ca[dirLen_u];
+    baseLen_u = len_u - dirLen_u;
+
+    /* the listing read by wscomp_Prepare_vd is taken if no other completion used
+     * its slot since, else the directory is checked here */
+    (void)pthread_mutex_lock(&dirLock_xs);
+    dir_pst = prepared_xspst;
+    if((dir_pst == NULL) || (dir_pst->used_u != preparedTick_xsu)
+        || (strcmp(dir_pst->path_pc, dir_ca) != 0))
+        dir_pst = GetDir_pst(dir_ca);
+    else
+        dir_pst->used_u = ++dirTick_us;
+    prepared_xspst = NULL;
+    if(dir_pst == NULL)
+    {
+        (void)pthread_mutex_unlock(&dirLock_xs);
+        return;
+    }
+
+    lo_u = LowerBound_u(dir_pst, base_cpc);
+    hi_u = PrefixEnd_u(dir_pst, base_cpc, baseLen_u, lo_u);
+
+    /* the hidden names are one block of the sorted listing */
+    dotLo_u = lo_u;
+    dotHi_u = lo_u;
+    if(baseLen_u == 0)
+    {
+        dotLo_u = LowerBound_u(dir_pst, ".");
+        dotHi_u = PrefixEnd_u(dir_pst, ".", 1, dotLo_u);
+    }
+
+    if((hi_u - lo_u) > (dotHi_u - dotLo_u))
+    {
+        /* the common part of the sorted names is the common part of the outer two */
+        first_cpc = dir_pst->sorted_ppc[(dotLo_u > lo_u) ? lo_u : dotHi_u];
+        last_cpc = dir_pst->sorted_ppc[(dotHi_u < hi_u) ? (hi_u - 1U) : (dotLo_u - 1U)];
+        common_u = baseLen_u;
+        while((first_cpc[common_u] != '\0') && (first_cpc[common_u] == last_cpc[common_u]))
+            common_u++;
+        embedded_cli_insert_text(cli_pst, &first_cpc[baseLen_u], common_u - baseLen_u);
+
+        if((hi_u - lo_u) - (dotHi_u - dotLo_u) == 1U)
+        {
+            if(first_cpc[common_u - 1U] != '/')
+                embedded_cli_insert_text(cli_pst, " ", 1);
+        }
+        else
+        {
+            wscomp_ListBegin_vd(&list_st, cli_pst, listMax_u);
+            for(idx_u = lo_u; idx_u < hi_u; idx_u++)
+            {
+                if((idx_u >= dotLo_u) && (idx_u < dotHi_u))
+                    continue;
+                if(!wscomp_ListAdd_bol(&list_st, NULL, dir_pst->sorted_ppc[idx_u],
+                                        strlen(dir_pst->sorted_ppc[idx_u])))
+                    break;
+            }
+            wscomp_ListEnd_vd(&list_st);
+        }
+    }
+    (void)pthread_mutex_unlock(&dirLock_xs);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Splits the typed part of a path into the directory to list and the name
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   word_cpc    typed part of the path
+ * @param   len_u       length of the typed part
+ * @param   path_pc     receives the nul terminated path, PATH_MAX bytes
+ * @param   dir_pc      receives the directory, "." for a name without directory,
+ *                      PATH_MAX bytes
+ * @param   dirLen_pu   receives the length of the directory part of the path
+ * @return  false for quoted and escaped names, they are not completed
+*//*------------------------------------------------------------------------------------*/
+static bool SplitPath_bol(const char *word_cpc, size_t len_u, char *path_pc, char *dir_pc,
+                            size_t *dirLen_pu)
+{
+    const char *slash_cpc;
+
+    if((len_u >= PATH_MAX) || (memchr(word_cpc, '"', len_u) != NULL)
+        || (memchr(word_cpc, '\'', len_u) != NULL) || (memchr(word_cpc, '\\', len_u) != NULL))
+        return false;
+
+    memcpy(path_pc, word_cpc, len_u);
+    path_pc[len_u] = '\0';
+    slash_cpc = strrchr(path_pc, '/');
+    *dirLen_pu = (slash_cpc != NULL) ? (size_t)(slash_cpc - path_pc) + 1U : 0;
+    memcpy(dir_pc, path_pc, *dirLen_pu);
+    strcpy(&dir_pc[*dirLen_pu], (*dirLen_pu > 0) ? "" : ".");
+
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Shows the value or argument expected next with its glossary
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cli_pst         line editor
+ * @param   opt_pcst        expected entry
+ * @param   optional_bol    the argument may be omitted, it is shown in brackets
+*//*------------------------------------------------------------------------------------*/
+static void ShowHint_vd(struct embedded_cli *cli_pst, const optEntry_t *opt_pcst,
+                        bool optional_bol)
+{
+    const struct arg_hdr *hdr_pcst = opt_pcst->hdr_pcst;
+
+    embedded_cli_print(cli_pst, "\n", 1);
+    if(optional_bol)
+        Print_vd(cli_pst, "[");
+    Print_vd(cli_pst, (hdr_pcst->datatype != NULL) ? hdr_pcst->datatype : "<value>");
+    if(optional_bol)
+        Print_vd(cli_pst, "]");
+    if(hdr_pcst->glossary != NULL)
+    {
+        Print_vd(cli_pst, "  ");
+        Print_vd(cli_pst, hdr_pcst->glossary);
+    }
+    embedded_cli_print(cli_pst, "\n", 1);
+    embedded_cli_redraw(cli_pst);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Prints a nul terminated text above the line being edited
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cli_pst     line editor
+ * @param   text_cpc    text
+*//*------------------------------------------------------------------------------------*/
+static void Print_vd(struct embedded_cli *cli_pst, const char *text_cpc)
+{
+    embedded_cli_print(cli_pst, text_cpc, strlen(text_cpc));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the listing of a directory, the cached listing is used as long as
+ *              the directory is unchanged. The caller holds dirLock_xs.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    directory
+ * @return  listing, NULL if the directory cannot be read
+*//*------------------------------------------------------------------------------------*/
+static dirCache_t *GetDir_pst(const char *path_cpc)
+{
+    struct stat stat_st;
+    dirCache_t *dir_pst = NULL;
+    size_t idx_u;
+
+    if((stat(path_cpc, &stat_st) != 0) || !S_ISDIR(stat_st.st_mode))
+        return NULL;
+
+    for(idx_u = 0; idx_u < WSCOMP_DIR_CACHE_LEN; idx_u++)
+    {
+        if((dirCache_sax[idx_u].path_pc != NULL)
+            && (strcmp(dirCache_sax[idx_u].path_pc, path_cpc) == 0))
+        {
+            dir_pst = &dirCache_sax[idx_u];
+            break;
+        }
+    }
+
+    if((dir_pst != NULL) && (dir_pst->dev_st == stat_st.st_dev)
+        && (dir_pst->ino_st == stat_st.st_ino) && (dir_pst->size_st == stat_st.st_size)
+        && (dir_pst->mtime_st.tv_sec == stat_st.st_mtim.tv_sec)
+        && (dir_pst->mtime_st.tv_nsec == stat_st.st_mtim.tv_nsec))
+    {
+        dir_pst->used_u = ++dirTick_us;
+        return dir_pst;
+    }
+
+    /* a changed directory is read again into its slot, else the oldest slot is used */
+    if(dir_pst == NULL)
+    {
+        dir_pst = &dirCache_sax[0];
+        for(idx_u = 1; idx_u < WSCOMP_DIR_CACHE_LEN; idx_u++)
+        {
+            if(dirCache_sax[idx_u].used_u < dir_pst->used_u)
+                dir_pst = &dirCache_sax[idx_u];
+        }
+    }
+
+    ClearDir_vd(dir_pst);
+    if(!LoadDir_bol(dir_pst, path_cpc, &stat_st))
+    {
+        ClearDir_vd(dir_pst);
+        return NULL;
+    }
+    dir_pst->used_u = ++dirTick_us;
+
+    return dir_pst;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads and sorts the listing of a directory
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   dir_pst     empty cache slot
+ * @param   path_cpc    directory
+ * @param   stat_pcst   status of the directory, identifies the listing
+ * @return  true on success
+*//*------------------------------------------------------------------------------------*/
+static bool LoadDir_bol(dirCache_t *dir_pst, const char *path_cpc, const struct stat *stat_pcst)
+{
+    DIR *dir_px;
+    struct dirent *entry_pst;
+    struct stat entry_st;
+    size_t *offsets_pu = NULL;
+    size_t capacity_u = 0;
+    size_t used_u = 0;
+    size_t size_u = 0;
+    size_t len_u;
+    size_t idx_u;
+    bool isDir_bol;
+    bool ok_bol = true;
+    void *grow_pv;
+
+    dir_pst->path_pc = strdup(path_cpc);
+    dir_px = opendir(path_cpc);
+    if((dir_pst->path_pc == NULL) || (dir_px == NULL))
+    {
+        if(dir_px != NULL)
+            (void)closedir(dir_px);
+        return false;
+    }
+
+    while(ok_bol && ((entry_pst = readdir(dir_px)) != NULL))
+    {
+        if((strcmp(entry_pst->d_name, ".") == 0) || (strcmp(entry_pst->d_name, "..") == 0))
+            continue;
+
+        isDir_bol = (entry_pst->d_type == DT_DIR);
+        if(((entry_pst->d_type == DT_UNKNOWN) || (entry_pst->d_type == DT_LNK))
+            && (fstatat(dirfd(dir_px), entry_pst->d_name, &entry_st, 0) == 0))
+        {
+            isDir_bol = S_ISDIR(entry_st.st_mode);
+        }
+
+        /* name, '/' of a directory and the nul terminator */
+        len_u = strlen(entry_pst->d_name);
+        if(used_u + len_u + 2U > size_u)
+        {
+            size_u = (size_u == 0) ? 4096U : 2U * size_u;
+            while(used_u + len_u + 2U > size_u)
+                size_u *= 2U;
+            grow_pv = realloc(dir_pst->names_pc, size_u);
+            ok_bol = (grow_pv != NULL);
+            if(ok_bol)
+                dir_pst->names_pc = grow_pv;
+        }
+        if(ok_bol && (dir_pst->count_u == capacity_u))
+        {
+            capacity_u = (capacity_u == 0) ? 64U : 2U * capacity_u;
+            grow_pv = realloc(offsets_pu, capacity_u * sizeof(size_t));
+            ok_bol = (grow_pv != NULL);
+            if(ok_bol)
+                offsets_pu = grow_pv;
+        }
+        if(ok_bol)
+        {
+            offsets_pu[dir_pst->count_u++] = used_u;
+            memcpy(&dir_pst->names_pc[used_u], entry_pst->d_name, len_u);
+            used_u += len_u;
+            if(isDir_bol)
+                dir_pst->names_pc[used_u++] = '/';
+            dir_pst->names_pc[used_u++] = '\0';
+        }
+    }
+    (void)closedir(dir_px);
+
+    /* the names do not move any more, the offsets become pointers */
+    if(ok_bol)
+    {
+        dir_pst->sorted_ppc = malloc((dir_pst->count_u + 1U) * sizeof(char *));
+        ok_bol = (dir_pst->sorted_ppc != NULL);
+    }
+    if(ok_bol)
+    {
+        for(idx_u = 0; idx_u < dir_pst->count_u; idx_u++)
+        {
+            dir_pst->sorted_ppc[idx_u] = &dir_pst->names_pc[offsets_pu[idx_u]];
+        }
+        qsort(dir_pst->sorted_ppc, dir_pst->count_u, sizeof(char *), CompareNames_i);
+
+        dir_pst->dev_st = stat_pcst->st_dev;
+        dir_pst->ino_st = stat_pcst->st_ino;
+        dir_pst->size_st = stat_pcst->st_size;
+        dir_pst->mtime_st = stat_pcst->st_mtim;
+    }
+    free(offsets_pu);
+
+    return(ok_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Releases the listing of a cache slot
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   dir_pst     cache slot
+*//*------------------------------------------------------------------------------------*/
+static void ClearDir_vd(dirCache_t *dir_pst)
+{
+    free(dir_pst->path_pc);
+    free(dir_pst->names_pc);
+    free(dir_pst->sorted_ppc);
+    dir_pst->path_pc = NULL;
+    dir_pst->names_pc = NULL;
+    dir_pst->sorted_ppc = NULL;
+    dir_pst->count_u = 0;
+    dir_pst->used_u = 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sorts the names of a listing
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static int CompareNames_i(const void *a_pv, const void *b_pv)
+{
+    return(strcmp(*(char * const *)a_pv, *(char * const *)b_pv));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the first name of a listing not sorted before the given name
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   dir_pcst    listing
+ * @param   name_cpc    nul terminated name
+ * @return  index of the name, count_u if all names are sorted before
+*//*------------------------------------------------------------------------------------*/
+static size_t LowerBound_u(const dirCache_t *dir_pcst, const char *name_cpc)
+{
+    size_t lo_u = 0;
+    size_t hi_u = dir_pcst->count_u;
+    size_t mid_u;
+
+    while(lo_u < hi_u)
+    {
+        mid_u = lo_u + (hi_u - lo_u) / 2U;
+        if(strcmp(dir_pcst->sorted_ppc[mid_u], name_cpc) < 0)
+            lo_u = mid_u + 1U;
+        else
+            hi_u = mid_u;
+    }
+    return(lo_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the end of the names starting with a prefix
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   dir_pcst    listing
+ * @param   prefix_cpc  prefix
+ * @param   len_u       length of the prefix
+ * @param   lo_u        first name not sorted before the prefix, see LowerBound_u
+ * @return  index behind the last name starting with the prefix
+*//*------------------------------------------------------------------------------------*/
+static size_t PrefixEnd_u(const dirCache_t *dir_pcst, const char *prefix_cpc, size_t len_u,
+                            size_t lo_u)
+{
+    size_t hi_u = dir_pcst->count_u;
+    size_t mid_u;
+
+    while(lo_u < hi_u)
+    {
+        mid_u = lo_u + (hi_u - lo_u) / 2U;
+        if(strncmp(dir_pcst->sorted_ppc[mid_u], prefix_cpc, len_u) <= 0)
+            lo_u = mid_u + 1U;
+        else
+            hi_u = mid_u;
+    }
+    return(lo_u);
+}
@@ -0,0 +1,198 @@
+/*****************************************************************************************
+* FILENAME :        wscomp.h
+*
+* DESCRIPTION :
+*       Header file for the argument completion of the console. The entries of an
+*       argument table are indexed once per command: the long option names in a
+*       prefix index, the short options in a table by character and the positional
+*       arguments in their order. A Tab then completes long option names, file names
+*       of arg_file entries and shows the next positional argument, without going
+*       through the argument table again.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wscomp_tp comp_x = wscomp_Build_tp(cmd_pt->argtable);
+*
+*   called from the completion callback of the line editor, see
+*   embedded_cli_set_complete, once the command name is complete:
+*   wscomp_Complete_vd(comp_x, cli_pst, line_cpc, cursor_i, 100);
+*
+*   a Tab on a file name reads the directory, wscomp_Prepare_vd does this up front,
+*   e.g. outside of the output lock:
+*   wscomp_Prepare_vd(comp_x, line_cpc, cursor_i);
+*
+*   wscomp_Free_vd(comp_x);
+*
+*   Directory listings used for the file name completion are cached per directory
+*   and read again only if the modification time of the directory changes. The
+*   cache is shared by all consoles of the process.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSCOMP_H
+#define WSCOMP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSCOMP_DIR_CACHE_LEN
+/**
+ * Number of directory listings kept for the file name completion
+ */
+#define WSCOMP_DIR_CACHE_LEN 4
+#endif
+
+#ifndef WSCOMP_LIST_COLUMNS
+/**
+ * Width of the candidate list
+ */
+#define WSCOMP_LIST_COLUMNS 78U
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+struct embedded_cli;
+
+/**
+ * @brief Opaque completion index of one argument table
+ */
+typedef struct wscomp_tag *wscomp_tp;
+
+/**
+ * @brief Candidate list printed above the line being edited
+ */
+typedef struct wscomp_list_tag
+{
+    struct embedded_cli *cli_pst;
+    size_t column_u;
+    size_t left_u;
+    bool cut_bol;
+} wscomp_list_t;
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   indexes the entries of an argument table, the table must stay valid as long
+ *              as the index is used
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   argtable_ppv  argument table terminated by arg_end
+ * @return
+ *          - completion index
+ *          - NULL if argtable_ppv is NULL or out of memory
+*//*------------------------------------------------------------------------------------*/
+extern wscomp_tp wscomp_Build_tp(void **argtable_ppv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   releases a completion index
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_x        completion index, may be NULL
+*//*------------------------------------------------------------------------------------*/
+extern void wscomp_Free_vd(wscomp_tp comp_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   completes the argument at the cursor: a long option name, a file name of an
+ *              arg_file entry, or shows the option value or positional argument
+ *              expected next. The first word of the line is the command name.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_x        completion index of the command
+ * @param   cli_pst       line editor, the completion is inserted at its cursor
+ * @param   line_cpc      line being edited
+ * @param   cursor_i      cursor position in the line
+ * @param   listMax_u     maximum number of listed candidates
+*//*------------------------------------------------------------------------------------*/
+extern void wscomp_Complete_vd(wscomp_tp comp_x, struct embedded_cli *cli_pst,
+                                const char *line_cpc, int cursor_i, size_t listMax_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   reads the directory listing a Tab at the cursor completes from, to be
+ *              called before the lock around the line editor is taken. The following
+ *              wscomp_Complete_vd of this thread uses the listing without reading the
+ *              directory.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   comp_x        completion index of the command
+ * @param   line_cpc      line being edited
+ * @param   cursor_i      cursor position in the line
+*//*------------------------------------------------------------------------------------*/
+extern void wscomp_Prepare_vd(wscomp_tp comp_x, const char *line_cpc, int cursor_i);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   starts a candidate list below the line being edited
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   list_pst      list state
+ * @param   cli_pst       line editor
+ * @param   listMax_u     maximum number of listed candidates
+*//*------------------------------------------------------------------------------------*/
+extern void wscomp_ListBegin_vd(wscomp_list_t *list_pst, struct embedded_cli *cli_pst,
+                                    size_t listMax_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   adds a candidate to the list, the candidates are wrapped at
+ *              WSCOMP_LIST_COLUMNS
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   list_pst      list state
+ * @param   prefix_cpc    nul terminated text shown before the candidate, may be NULL
+ * @param   name_cpc      candidate, need not be nul terminated
+ * @param   len_u         length of the candidate
+ * @return  false if the list is full
+*//*------------------------------------------------------------------------------------*/
+extern bool wscomp_ListAdd_bol(wscomp_list_t *list_pst, const char *prefix_cpc,
+                                const char *name_cpc, size_t len_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   ends the candidate list and shows the line being edited again
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   list_pst      list state
+*//*------------------------------------------------------------------------------------*/
+extern void wscomp_ListEnd_vd(wscomp_list_t *list_pst);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSCOMP_H
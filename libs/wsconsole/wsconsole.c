@@ -32,14 +32,28 @@
 
 /***************************************************************************************/
 /* Include Interfaces */
+#define _GNU_SOURCE     /* fopencookie */
 #include <stdio.h>
 #include <string.h>
+#include <ctype.h>
 #include <signal.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <sys/types.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #include "wsconsole.h"
 
 #include "wserr.h"
+#include "wsterm.h"
+#include "wsargs.h"
+#include "wscmdtab.h"
+#include "wstrie.h"
+#include "wscomp.h"
 #include "embedded_cli.h"
 #include "argtable3.h"
 #include "queue.h"
@@ -47,6 +61,28 @@
 /***************************************************************************************/
 /* Local constant defines */
 
+/**
+ * Initial number of slots of the command index, must be a power of two
+ */
+#define CMD_INDEX_INIT_SIZE 16U
+
+/**
+ * Number of line copies in the line memory: line editor, running and queued command
+ */
+#define LINE_COPIES 3U
+
+/**
+ * Number of characters a completion inserts at most with one Tab, longer common
+ * parts are completed with the next Tab
+ */
+#define COMPLETE_LEN 64U
+
+/**
+ * Number of aligned slots of the scratch arena
+ */
+#define SCRATCH_SLOTS ((WSCONSOLE_SCRATCH_LEN + sizeof(scratchAlign_t) - 1U) / \
+                        sizeof(scratchAlign_t))
+
 /***************************************************************************************/
 /* Local function like makros */
 
@@ -63,21 +99,107 @@ typedef enum consoleState_tag
 
 }consoleState_t;
 
+/**
+ * @brief Slot of the scratch arena, aligned for any basic type
+ */
+typedef union scratchAlign_tag
+{
+    long long ll;
+    long double ld;
+    void *p;
+    void (*fp)(void);
+}scratchAlign_t;
+
 /**
  * @brief Command list single item
  */
 typedef struct cmdItem_tag
 {
     /**
-     * this command item
+     * description of the command, the copy of a command registered at run time or
+     * an entry of a command table
      */
-    wsconsole_cmdItem_t thisItem_st;
+    const wsconsole_cmdItem_t *item_pcst;
     /**
      * next list item
      */
-    SLIST_ENTRY(cmdItem_tag) nextItem_st;  //!< next command in the list
+    STAILQ_ENTRY(cmdItem_tag) nextItem_st;  //!< next command in the list
+    /**
+     * hash of the command name
+     */
+    uint32_t hash_u32;
+    /**
+     * console the command is registered to
+     */
+    wsconsole_tp owner_x;
+    /**
+     * Serializes parsing and execution, the argtable holds the parse results and
+     * may be shared by many consoles
+     */
+    pthread_mutex_t argLock_st;
+    /**
+     * values of the argtable at registration, the defaults of the optional
+     * arguments are restored from them before every parse, shared with the copies
+     */
+    void *defaults_pv;
+    /**
+     * completion index of the argtable, built with the first completion of an
+     * argument, protected by compLock_st of the owner
+     */
+    wscomp_tp comp_x;
 }cmdItem_t;
 
+/**
+ * @brief Command registered at run time with the copy of its description
+ */
+typedef struct regItem_tag
+{
+    cmdItem_t item_st;
+    wsconsole_cmdItem_t desc_st;
+}regItem_t;
+
+/**
+ * @brief Copy of an independent command with its own argtable, owned by the
+ *          executing console
+ */
+typedef struct argClone_tag
+{
+    /**
+     * registered command the copy belongs to
+     */
+    cmdItem_t *orig_pst;
+    /**
+     * copy of the command item and its description, NULL argtable if the argtable
+     * cannot be copied
+     */
+    cmdItem_t item_st;
+    wsconsole_cmdItem_t desc_st;
+    struct argClone_tag *next_pst;
+}argClone_t;
+
+/**
+ * @brief Command handed over for the deferred execution, the command line is
+ *          copied so the line editor can take the next line while it runs
+ */
+typedef struct job_tag
+{
+    cmdItem_t *cmd_pst;
+    int argc_i;
+    /**
+     * arguments and line copy, the arrays below or the line memory of the console
+     * for long lines
+     */
+    char **argv_ppc;
+    char *line_pc;
+    size_t lineSize_u;
+    /**
+     * heap allocations of the input thread up to the hand-off
+     */
+    size_t allocs_u;
+    char *argv_apc[EMBEDDED_CLI_MAX_ARGC];
+    char line_ca[EMBEDDED_CLI_MAX_LINE];
+}job_t;
+
 /**
  * @brief Console object implementation
  */
@@ -88,31 +210,200 @@ typedef struct wsconsole_tag
      */
     wsconsole_config_t config_st;
     /**
-     * Linked list of all registered commands
+     * Linked list of all registered commands in registration order
+     */
+    STAILQ_HEAD(cmd_list_, cmdItem_tag) cmdList_st;
+    /**
+     * Open addressing hash index over the command names, the slot count is a
+     * power of two and the index is kept at most half full
      */
-    SLIST_HEAD(cmd_list_, cmdItem_tag) cmdList_st;
+    cmdItem_t **cmdIndex_ppst;
+    size_t indexSize_u;
+    size_t cmdCount_u;
+    /**
+     * Command table built at compile time and the locks and owner of its commands,
+     * NULL if no table is registered
+     */
+    const wsconsole_cmdTable_t *table_pcst;
+    cmdItem_t *tableItems_pst;
+    /**
+     * Prefix index over the names of all commands, used for the completion and to
+     * accept unambiguous prefixes of command names
+     */
+    wstrie_t names_st;
+    /**
+     * Serializes building the completion indexes of the commands, see cmdItem_t
+     */
+    pthread_mutex_t compLock_st;
     /**
      * Command line interface object
      */
     struct embedded_cli cli_st;
+    /**
+     * Input buffer for the block input interface and its fill state
+     */
+    char inBuffer_ca[WSCONSOLE_IN_BUF_LEN];
+    size_t inHead_u;
+    size_t inTail_u;
+    /**
+     * Response stream passed to the command callbacks, opened once at
+     * initialization. Its stdio buffer hands the output on per line.
+     */
+    FILE *respStream_fp;
+    char streamBuffer_ca[WSCONSOLE_STREAM_BUF_LEN];
+    /**
+     * Bounded response buffer of atomic commands and its fill state
+     */
+    char respBuffer_ca[WSCONSOLE_RESP_BUF_LEN];
+    size_t respLen_u;
+    bool respAtomic_bol;
+    /**
+     * Output channel failed or timed out during the current command
+     */
+    bool outError_bol;
+    /**
+     * The first prompt was shown
+     */
+    bool started_bol;
+    /**
+     * The response bypasses the terminal output of the line editor, batch mode
+     */
+    bool rawOut_bol;
+    /**
+     * Serializes the line editor and the command output, the command may run on
+     * the worker thread
+     */
+    pthread_mutex_t outLock_st;
+    /**
+     * Worker thread of the asynchronous execution and its jobs, protected by
+     * jobLock_st. One line entered while a command runs is kept in next_st and
+     * executed afterwards, further lines are rejected.
+     */
+    pthread_t worker_st;
+    pthread_mutex_t jobLock_st;
+    pthread_cond_t jobCond_st;
+    bool workerActive_bol;
+    bool workerQuit_bol;
+    /**
+     * commands are executed by the worker thread or the external executor
+     */
+    bool deferred_bol;
+    bool busy_bol;
+    bool cancel_bol;
+    job_t job_st;
+    job_t next_st;
+    /**
+     * copy of the arguments arg_parse works on, the array below or the line
+     * memory of the console for long lines. The parses of a console run one
+     * after the other, so one copy is enough.
+     */
+    char **parseArgv_ppc;
+    int parseArgc_i;
+    char *parseArgv_apc[EMBEDDED_CLI_MAX_ARGC];
+    /**
+     * Line memory allocated for long lines, NULL if the memory is passed in with
+     * the configuration or the compile time buffers are used
+     */
+    void *lineMem_pv;
+    /**
+     * Scratch arena for the command callbacks and its fill state in slots
+     */
+    scratchAlign_t scratch_ua[SCRATCH_SLOTS];
+    size_t scratchUsed_u;
+    /**
+     * Copies of the independent commands executed by this console
+     */
+    argClone_t *clones_pst;
+    /**
+     * Heap allocations made by the last dispatch, test hook. Deferred commands
+     * store it under jobLock_st when they are done.
+     */
+    size_t dispatchAllocs_u;
     /**
      * console state
     */
     consoleState_t state_en;
+    /**
+     * next initialized console, see consoleList_sx
+     */
+    struct wsconsole_tag *nextConsole_px;
+#if WSCONSOLE_STATIC_POOL_SIZE > 0
+    /**
+     * pool slot is in use
+     */
+    bool inUse_bol;
+#endif
 }wsconsole_t;
 
 /***************************************************************************************/
 /* Local functions prototypes: */
 static cmdItem_t *FindCommandByName_stp(wsconsole_tp console_x, const char *name_cpc);
+static cmdItem_t *FindCommandByPrefix_stp(wsconsole_tp console_x, const char *name_cpc);
+static void Complete_vd(void *console_pv, struct embedded_cli *cli_pst, const char *line_cpc,
+                        int cursor_i);
+static void CompleteArgs_vd(wsconsole_tp registry_x, struct embedded_cli *cli_pst,
+                            const char *line_cpc, int cursor_i, const char *name_cpc,
+                            size_t len_u);
+static void PrepareComplete_vd(wsconsole_tp console_x);
+static wscomp_tp GetComp_x(wsconsole_tp registry_x, const char *name_cpc, size_t len_u);
+static bool ListCandidate_bol(void *list_pv, void *item_pv);
+static wserr_t GrowIndex_t(wsconsole_tp console_x);
+static bool ReadLine_bol(wsconsole_tp console_x);
+static size_t ConsumeInput_u(wsconsole_tp console_x, const char *buf_pc, size_t len_u,
+                                bool *line_pbol);
+static void StartSession_vd(wsconsole_tp console_x);
+static void Idle_vd(wsconsole_tp console_x);
+static wserr_t DispatchLine_t(wsconsole_tp console_x);
+static wserr_t ParseExecute_t(wsconsole_tp console_x, cmdItem_t *cmd_pt, int argc_i,
+                                char **argv_ppc);
+static wserr_t ExecuteCommand_t(wsconsole_tp console_x, cmdItem_t *cmd_pt);
+static wserr_t RunJob_t(wsconsole_tp console_x);
+static wsconsole_tp ExecConsole_tp(wsconsole_cmdItem_tp cmd_pt);
+static cmdItem_t *GetArgClone_pst(wsconsole_tp console_x, cmdItem_t *cmd_pt);
+static void FreeArgClones_vd(wsconsole_tp console_x);
+static void SetJob_vd(job_t *job_pst, cmdItem_t *cmd_pt, int argc_i, char **argv_ppc);
+static void SetupLines_vd(wsconsole_tp console_x, void *mem_pv);
+static void MoveJob_vd(job_t *dst_pst, job_t *src_pst);
+static void *Worker_pv(void *console_pv);
+static bool IsBusy_bol(wsconsole_tp console_x);
+static void Cancel_vd(wsconsole_tp console_x);
+static void Prompt_vd(wsconsole_tp console_x);
+static void Redraw_vd(wsconsole_tp console_x);
+static unsigned long CountAllocs_u(wsconsole_tp console_x);
+static ssize_t ResponseWrite_ss(void *cookie_pv, const char *buf_pc, size_t size_u);
+static void FlushResponse_vd(wsconsole_tp console_x);
+static void OutputWrite_vd(wsconsole_tp console_x, const char *buf_pc, size_t len_u);
+static struct arg_end *FindArgEnd_pst(void **argtable_ppv);
+static void FdWrite_vd(void *data_pv, const char *buf_pc, size_t len_u);
 static int HelpCommand_i(wsconsole_cmdItem_tp cmd_pt, FILE *respStream_fp);
+static void PrintHelp_vd(const wsconsole_cmdItem_t *cmd_pcst, FILE *respStream_fp);
 static wserr_t RegisterHelpCommand_t(wsconsole_tp console_x);
+static void FreeCommands_vd(wsconsole_tp console_x);
 
 /***************************************************************************************/
 /* Local variables: */
+#if WSCONSOLE_STATIC_POOL_SIZE > 0
+/**
+ * Static pool of console objects, used instead of the heap
+ */
+static wsconsole_t consolePool_sax[WSCONSOLE_STATIC_POOL_SIZE];
+#endif
+
+/**
+ * Console executing a command on this thread, the command may be registered to
+ * the shared registry of another console
+ */
+static __thread wsconsole_tp execConsole_xs = NULL;
+/**
+ * Command executed by the callback running on this thread
+ */
+static __thread cmdItem_t *execItem_xs = NULL;
 /**
- * Singleton object implementation
+ * Initialized consoles, searched for the owner of a command outside of its
+ * callback
  */
-static wsconsole_t console_sx;
+static wsconsole_tp consoleList_sx = NULL;
+static pthread_mutex_t consoleListLock_sst = PTHREAD_MUTEX_INITIALIZER;
 /***************************************************************************************/
 /* Global functions (unlimited visibility) */
 
@@ -129,8 +420,24 @@ wserr_t wsconsole_InitParameter_t(wsconsole_config_t *config_stp)
     {
         exeResult_st = wserr_OK;  
         config_stp->getCharFunc_fp = NULL;
+        config_stp->getBufferFunc_fp = NULL;
         config_stp->intHandler_fp = NULL;
         config_stp->putCharFunc_fp = NULL; 
+        config_stp->writeFunc_fp = NULL;
+        config_stp->outData_pv = NULL;
+        config_stp->termFd_i = -1;
+        config_stp->inFd_i = -1;
+        config_stp->outFd_i = -1;
+        config_stp->outTimeoutMs_i = -1;
+        config_stp->asyncExec_bol = false;
+        config_stp->submitFunc_fp = NULL;
+        config_stp->submitData_pv = NULL;
+        config_stp->registry_x = NULL;
+        config_stp->history_x = NULL;
+        config_stp->lineLen_u = 0;
+        config_stp->lineMem_pv = NULL;
+        config_stp->lineMemSize_u = 0;
+        config_stp->allocCountFunc_fp = NULL;
     }
 
     return(exeResult_st);
@@ -143,10 +450,114 @@ wserr_t wsconsole_InitParameter_t(wsconsole_config_t *config_stp)
 *//*-----------------------------------------------------------------------------------*/
 wsconsole_tp wsconsole_AllocateConsole_t(void)
 {
-    /* new allocation, reset status */
-    console_sx.state_en = STATE_ALLOCATED;
-    /* Currently only support singleton in this version */
-    return(&console_sx);
+    wsconsole_tp console_x = NULL;
+
+#if WSCONSOLE_STATIC_POOL_SIZE > 0
+    size_t idx_u;
+
+    for(idx_u = 0; idx_u < WSCONSOLE_STATIC_POOL_SIZE; idx_u++)
+    {
+        if(!consolePool_sax[idx_u].inUse_bol)
+        {
+            console_x = &consolePool_sax[idx_u];
+            memset(console_x, 0, sizeof(wsconsole_t));
+            console_x->inUse_bol = true;
+            break;
+        }
+    }
+#else
+    console_x = (wsconsole_tp) calloc(1, sizeof(wsconsole_t));
+#endif
+
+    if(NULL != console_x)
+    {
+        /* new allocation, reset status */
+        console_x->state_en = STATE_ALLOCATED;
+        STAILQ_INIT(&console_x->cmdList_st);
+        console_x->cmdIndex_ppst = NULL;
+        console_x->indexSize_u = 0;
+        console_x->cmdCount_u = 0;
+        console_x->table_pcst = NULL;
+        console_x->tableItems_pst = NULL;
+        wstrie_Init_vd(&console_x->names_st);
+        console_x->respStream_fp = NULL;
+        console_x->respLen_u = 0;
+        console_x->respAtomic_bol = false;
+        console_x->outError_bol = false;
+        console_x->scratchUsed_u = 0;
+        console_x->dispatchAllocs_u = 0;
+    }
+
+    return(console_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Release the console
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_FreeConsole_t(wsconsole_tp console_x)
+{
+    if(console_x == NULL)
+        return wserr_ERR_PARAM;
+
+    if(console_x->state_en != STATE_ALLOCATED)
+    {
+        (void)wsconsole_DeInit_t(console_x);
+    }
+
+#if WSCONSOLE_STATIC_POOL_SIZE > 0
+    console_x->inUse_bol = false;
+#else
+    free(console_x);
+#endif
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the console a command is registered to
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wsconsole_tp wsconsole_GetConsole_tp(wsconsole_cmdItem_tp cmd_pt)
+{
+    const wsconsole_cmdTable_t *table_pcst;
+    wsconsole_tp console_x;
+    wsconsole_tp owner_x = NULL;
+    cmdItem_t *item_pst;
+
+    if(cmd_pt == NULL)
+        return NULL;
+
+    /* inside the callback the owner is known from the executed command, this also
+     * covers the copies of the independent commands */
+    if((execItem_xs != NULL) && (execItem_xs->item_pcst == cmd_pt))
+        return(execItem_xs->owner_x);
+
+    /* the description of a table entry may be in read only memory, it belongs to
+     * the console whose table holds it. A command registered at run time is found
+     * by its name and carries its owner. */
+    (void)pthread_mutex_lock(&consoleListLock_sst);
+    for(console_x = consoleList_sx; (owner_x == NULL) && (console_x != NULL);
+        console_x = console_x->nextConsole_px)
+    {
+        table_pcst = console_x->table_pcst;
+        if((table_pcst != NULL) && ((uintptr_t)cmd_pt >= (uintptr_t)table_pcst->items_pcst)
+            && ((uintptr_t)cmd_pt < (uintptr_t)&table_pcst->items_pcst[table_pcst->count_u]))
+        {
+            owner_x = console_x->tableItems_pst[cmd_pt - table_pcst->items_pcst].owner_x;
+        }
+        else
+        {
+            item_pst = FindCommandByName_stp(console_x, cmd_pt->command);
+            if((item_pst != NULL) && (item_pst->item_pcst == cmd_pt))
+                owner_x = item_pst->owner_x;
+        }
+    }
+    (void)pthread_mutex_unlock(&consoleListLock_sst);
+
+    return(owner_x);
 }
 
 /**--------------------------------------------------------------------------------------
@@ -157,6 +568,7 @@ wsconsole_tp wsconsole_AllocateConsole_t(void)
 wserr_t wsconsole_Init_t(wsconsole_tp console_x, wsconsole_config_t *config_stp)
 {
     wserr_t exeResult_st = wserr_OK;
+    bool termOpen_bol = false;
 
     /* Validation of parameter list first */
     if((config_stp == NULL) || (console_x == NULL))
@@ -167,38 +579,170 @@ wserr_t wsconsole_Init_t(wsconsole_tp console_x, wsconsole_config_t *config_stp)
         return wserr_ERR_INVALID_STATE;
     
 
+    /* At least one input interface is needed */
+    if((config_stp->getCharFunc_fp == NULL) && (config_stp->getBufferFunc_fp == NULL)
+        && (config_stp->inFd_i < 0))
+        return wserr_ERR_PARAM;
+
+    /* Long lines need the line memory, passed in or allocated here */
+    console_x->lineMem_pv = NULL;
+    if(config_stp->lineLen_u > EMBEDDED_CLI_MAX_LINE)
+    {
+        if(config_stp->lineLen_u > (size_t)INT_MAX)
+            return wserr_ERR_PARAM;
+
+        if(config_stp->lineMem_pv != NULL)
+        {
+            if(config_stp->lineMemSize_u < wsconsole_GetLineMemSize_u(config_stp->lineLen_u))
+                return wserr_ERR_PARAM;
+        }
+        else
+        {
+            console_x->lineMem_pv = malloc(wsconsole_GetLineMemSize_u(config_stp->lineLen_u));
+            if(console_x->lineMem_pv == NULL)
+                return wserr_ERR_NO_MEM;
+        }
+    }
+
     /* Copy parameter for execution */
     memcpy(&console_x->config_st, config_stp, sizeof(wsconsole_config_t));
+    console_x->inHead_u = 0;
+    console_x->inTail_u = 0;
+    console_x->started_bol = false;
+    console_x->rawOut_bol = false;
+    (void)pthread_mutex_init(&console_x->outLock_st, NULL);
+    (void)pthread_mutex_init(&console_x->compLock_st, NULL);
+    (void)pthread_mutex_init(&console_x->jobLock_st, NULL);
+    (void)pthread_cond_init(&console_x->jobCond_st, NULL);
+    console_x->workerActive_bol = false;
+    console_x->workerQuit_bol = false;
+    console_x->deferred_bol = (console_x->config_st.submitFunc_fp != NULL);
+    console_x->busy_bol = false;
+    console_x->cancel_bol = false;
+    console_x->job_st.cmd_pst = NULL;
+    console_x->next_st.cmd_pst = NULL;
 
     /* Start up the Embedded CLI instance with the appropriate
      * callbacks/userdata */
-    embedded_cli_init(&console_x->cli_st, "cli> ", 
-                        console_x->config_st.putCharFunc_fp, stdout);
+    if(console_x->config_st.outFd_i >= 0)
+    {
+        /* the console writes to the file descriptor itself */
+        embedded_cli_init(&console_x->cli_st, "cli> ", NULL, console_x);
+        embedded_cli_set_write(&console_x->cli_st, FdWrite_vd);
+    }
+    else
+    {
+        embedded_cli_init(&console_x->cli_st, "cli> ", 
+                            console_x->config_st.putCharFunc_fp, 
+                            (console_x->config_st.outData_pv != NULL) ? 
+                                console_x->config_st.outData_pv : stdout);
+        if(console_x->config_st.writeFunc_fp != NULL)
+        {
+            embedded_cli_set_write(&console_x->cli_st, console_x->config_st.writeFunc_fp);
+        }
+    }
+    SetupLines_vd(console_x, (console_x->lineMem_pv != NULL) ?
+                                console_x->lineMem_pv : console_x->config_st.lineMem_pv);
+    embedded_cli_set_complete(&console_x->cli_st, Complete_vd, console_x);
+
+    if(console_x->config_st.history_x != NULL)
+    {
+        wserr_LOG(wshist_Load_t(console_x->config_st.history_x, &console_x->cli_st));
+    }
     
-    /* Capture Ctrl-C in an interrupt service routine */
-    struct sigaction sa;
-    sa.sa_handler = console_x->config_st.intHandler_fp;
-    sigemptyset(&sa.sa_mask);
-    sa.sa_flags = 0;
+    /* Capture Ctrl-C in an interrupt service routine, consoles driven by an event
+     * loop usually have no handler and leave the process wide setting untouched */
+    if(console_x->config_st.intHandler_fp != NULL)
+    {
+        struct sigaction sa;
+        sa.sa_handler = console_x->config_st.intHandler_fp;
+        sigemptyset(&sa.sa_mask);
+        sa.sa_flags = 0;
+
+        /* Register signal handler for SIGINT (Ctrl-C) using sigaction */
+        if (sigaction(SIGINT, &sa, NULL) == -1) 
+        {
+            exeResult_st = wserr_ERR_GEN;   
+        }
+    }
+
+    /* The response stream is opened once and reused for all commands, the
+     * output is passed on to the console output while the command runs */
+    if(wserr_OK == exeResult_st)
+    {
+        cookie_io_functions_t respIo_st = { .write = ResponseWrite_ss };
+
+        console_x->respLen_u = 0;
+        console_x->respAtomic_bol = false;
+        console_x->respStream_fp = fopencookie(console_x, "w", respIo_st);
+        if(console_x->respStream_fp == NULL)
+        {
+            exeResult_st = wserr_ERR_NO_MEM;
+        }
+        else
+        {
+            (void)setvbuf(console_x->respStream_fp, console_x->streamBuffer_ca,
+                            _IOLBF, sizeof(console_x->streamBuffer_ca));
+        }
+    }
+
+    /* Switch the terminal to raw mode once for the whole session */
+    if((wserr_OK == exeResult_st) && (console_x->config_st.termFd_i >= 0))
+    {
+        exeResult_st = wsterm_Open_t(console_x->config_st.termFd_i);
+        termOpen_bol = (wserr_OK == exeResult_st);
+    }
+
+    /* Register as basic the help function, consoles using a shared registry find
+     * it there */
+    if((wserr_OK == exeResult_st) && (console_x->config_st.registry_x == NULL))
+    {
+        exeResult_st = RegisterHelpCommand_t(console_x);
+    }
 
-    /* Register signal handler for SIGINT (Ctrl-C) using sigaction */
-    if (sigaction(SIGINT, &sa, NULL) == -1) 
+    /* The worker thread is started once and waits for the commands, as the last
+     * step nothing can fail after it and it never has to be stopped here */
+    if((wserr_OK == exeResult_st) && console_x->config_st.asyncExec_bol)
     {
-        exeResult_st = wserr_ERR_GEN;   
+        if(pthread_create(&console_x->worker_st, NULL, Worker_pv, console_x) == 0)
+        {
+            console_x->workerActive_bol = true;
+            console_x->deferred_bol = true;
+        }
+        else
+        {
+            exeResult_st = wserr_ERR_NO_MEM;
+        }
     }
 
     /* Initialization without errors, move the initialized state */
     if(wserr_OK == exeResult_st)
     {
         console_x->state_en = STATE_INITIALIZED;
+        (void)pthread_mutex_lock(&consoleListLock_sst);
+        console_x->nextConsole_px = consoleList_sx;
+        consoleList_sx = console_x;
+        (void)pthread_mutex_unlock(&consoleListLock_sst);
     }
-
-    /* Register as basic the help function */
-    if(wserr_OK == exeResult_st)
+    else
     {
-        exeResult_st = RegisterHelpCommand_t(console_x);
+        /* the console stays allocated, everything set up so far is released */
+        if(termOpen_bol)
+            (void)wsterm_Close_t();
+        if(console_x->respStream_fp != NULL)
+        {
+            (void)fclose(console_x->respStream_fp);
+            console_x->respStream_fp = NULL;
+        }
+        FreeCommands_vd(console_x);
+        free(console_x->lineMem_pv);
+        console_x->lineMem_pv = NULL;
+        (void)pthread_cond_destroy(&console_x->jobCond_st);
+        (void)pthread_mutex_destroy(&console_x->jobLock_st);
+        (void)pthread_mutex_destroy(&console_x->outLock_st);
+        (void)pthread_mutex_destroy(&console_x->compLock_st);
     }
-    
+
     return(exeResult_st);
 }
 
@@ -234,31 +778,75 @@ wserr_t wsconsole_RegisterCommand_t(wsconsole_tp console_x,
                                             wsconsole_cmdItem_t *newItem_stp)
 {
     wserr_t exeResult_st = wserr_ERR_GEN;
+    regItem_t *regItem_pst;
     cmdItem_t *tempItem_stp;
-    cmdItem_t *lastItem_stp;
+    uint32_t hash_u32;
+    size_t mask_u;
+    size_t slot_u;
 
     /* Check the internal structure of the command */
     exeResult_st = wsconsole_ValidateCommand_t(newItem_stp);
+
+    /* Command names must be unique */
+    if((wserr_OK == exeResult_st) 
+        && (NULL != FindCommandByName_stp(console_x, newItem_stp->command)))
+    {
+        exeResult_st = wserr_ERR_PARAM;
+    }
+
+    /* Make sure the index has a free slot and stays at most half full */
+    if((wserr_OK == exeResult_st) 
+        && (2U * (console_x->cmdCount_u + 1U) > console_x->indexSize_u))
+    {
+        exeResult_st = GrowIndex_t(console_x);
+    }
+
     if(wserr_OK == exeResult_st)
     {
         /* Allocate memory for new command */
-        tempItem_stp = (cmdItem_t *) calloc(1, sizeof(wsconsole_cmdItem_t));
-        if(NULL != tempItem_stp)
+        regItem_pst = (regItem_t *) calloc(1, sizeof(regItem_t));
+        if(NULL != regItem_pst)
         {
             /* copy the data only to the allocated temporary object */
-            memcpy(&tempItem_stp->thisItem_st, newItem_stp, sizeof(wsconsole_cmdItem_t));
-                lastItem_stp = SLIST_FIRST(&console_x->cmdList_st);
-            /* add command item to command list */
-            if (NULL == lastItem_stp) 
+            memcpy(&regItem_pst->desc_st, newItem_stp, sizeof(wsconsole_cmdItem_t));
+            tempItem_stp = &regItem_pst->item_st;
+            tempItem_stp->item_pcst = &regItem_pst->desc_st;
+            hash_u32 = wscmdtab_Hash_u32(newItem_stp->command);
+            tempItem_stp->hash_u32 = hash_u32;
+            tempItem_stp->owner_x = console_x;
+            tempItem_stp->defaults_pv = (NULL != newItem_stp->argtable) ?
+                                    wsargs_SaveDefaults_pv(newItem_stp->argtable) : NULL;
+
+            /* the defaults and the prefix index are the only steps which may still
+             * fail */
+            if(((NULL != newItem_stp->argtable) && (NULL == tempItem_stp->defaults_pv))
+                || (wstrie_Insert_t(&console_x->names_st, newItem_stp->command, tempItem_stp)
+                    != wserr_OK))
             {
-                SLIST_INSERT_HEAD(&console_x->cmdList_st, tempItem_stp, nextItem_st);
-            } else 
+                wsargs_FreeDefaults_vd(tempItem_stp->defaults_pv);
+                free(regItem_pst);
+                return wserr_ERR_NO_MEM;
+            }
+            (void)pthread_mutex_init(&tempItem_stp->argLock_st, NULL);
+
+            /* add command item to the end of the command list */
+            STAILQ_INSERT_TAIL(&console_x->cmdList_st, tempItem_stp, nextItem_st);
+
+            /* add command item to the first free slot of the index */
+            mask_u = console_x->indexSize_u - 1U;
+            slot_u = hash_u32 & mask_u;
+            while(NULL != console_x->cmdIndex_ppst[slot_u])
             {
-                cmdItem_t *it;
-                while ((it = SLIST_NEXT(lastItem_stp, nextItem_st)) != NULL) {
-                    lastItem_stp = it;
-                }
-                SLIST_INSERT_AFTER(lastItem_stp, tempItem_stp, nextItem_st);
+                slot_u = (slot_u + 1U) & mask_u;
+            }
+            console_x->cmdIndex_ppst[slot_u] = tempItem_stp;
+            console_x->cmdCount_u++;
+
+            /* build the option tables of the argument table once, they are
+             * reused by every later parse of this command */
+            if(NULL != newItem_stp->argtable)
+            {
+                (void)arg_compile((void **)newItem_stp->argtable);
             }
         }
         else
@@ -271,6 +859,98 @@ wserr_t wsconsole_RegisterCommand_t(wsconsole_tp console_x,
     return(exeResult_st); 
 }
 
+/**--------------------------------------------------------------------------------------
+ * @brief     Register a command table built at compile time
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_RegisterTable_t(wsconsole_tp console_x,
+                                            const wsconsole_cmdTable_t *table_pcst)
+{
+    wserr_t exeResult_st = wserr_OK;
+    cmdItem_t *items_pst;
+    size_t chars_u;
+    size_t idx_u;
+
+    if((console_x == NULL) || (table_pcst == NULL) || (table_pcst->items_pcst == NULL)
+        || (table_pcst->seeds_pcu16 == NULL) || (table_pcst->count_u == 0)
+        || (table_pcst->buckets_u == 0))
+        return wserr_ERR_PARAM;
+
+    if(console_x->table_pcst != NULL)
+        return wserr_ERR_INVALID_STATE;
+
+    /* Every entry must be complete, stored at the slot of its hash and unique */
+    for(idx_u = 0; (wserr_OK == exeResult_st) && (idx_u < table_pcst->count_u); idx_u++)
+    {
+        exeResult_st = wsconsole_ValidateCommand_t(
+                            (wsconsole_cmdItem_t *)&table_pcst->items_pcst[idx_u]);
+        if((wserr_OK == exeResult_st)
+            && ((wscmdtab_Slot_u(table_pcst,
+                    wscmdtab_Hash_u32(table_pcst->items_pcst[idx_u].command)) != idx_u)
+                || (NULL != FindCommandByName_stp(console_x,
+                                                table_pcst->items_pcst[idx_u].command))))
+        {
+            exeResult_st = wserr_ERR_PARAM;
+        }
+    }
+
+    if(wserr_OK != exeResult_st)
+        return exeResult_st;
+
+    /* only the run time state of the commands is allocated, the descriptions stay
+     * in the table */
+    items_pst = (cmdItem_t *) calloc(table_pcst->count_u, sizeof(cmdItem_t));
+    if(NULL == items_pst)
+        return wserr_ERR_NO_MEM;
+
+    /* the names are added to the prefix index below, which then cannot fail */
+    for(idx_u = 0, chars_u = 0; idx_u < table_pcst->count_u; idx_u++)
+    {
+        chars_u += strlen(table_pcst->items_pcst[idx_u].command);
+    }
+    for(idx_u = 0; (wserr_OK == exeResult_st) && (idx_u < table_pcst->count_u); idx_u++)
+    {
+        if(NULL != table_pcst->items_pcst[idx_u].argtable)
+        {
+            items_pst[idx_u].defaults_pv =
+                            wsargs_SaveDefaults_pv(table_pcst->items_pcst[idx_u].argtable);
+            if(NULL == items_pst[idx_u].defaults_pv)
+                exeResult_st = wserr_ERR_NO_MEM;
+        }
+    }
+    if((wserr_OK != exeResult_st)
+        || (wstrie_Reserve_t(&console_x->names_st, chars_u) != wserr_OK))
+    {
+        for(idx_u = 0; idx_u < table_pcst->count_u; idx_u++)
+        {
+            wsargs_FreeDefaults_vd(items_pst[idx_u].defaults_pv);
+        }
+        free(items_pst);
+        return wserr_ERR_NO_MEM;
+    }
+
+    for(idx_u = 0; idx_u < table_pcst->count_u; idx_u++)
+    {
+        items_pst[idx_u].item_pcst = &table_pcst->items_pcst[idx_u];
+        items_pst[idx_u].hash_u32 = wscmdtab_Hash_u32(table_pcst->items_pcst[idx_u].command);
+        items_pst[idx_u].owner_x = console_x;
+        (void)pthread_mutex_init(&items_pst[idx_u].argLock_st, NULL);
+        (void)wstrie_Insert_t(&console_x->names_st, table_pcst->items_pcst[idx_u].command,
+                                &items_pst[idx_u]);
+
+        if(NULL != table_pcst->items_pcst[idx_u].argtable)
+        {
+            (void)arg_compile((void **)table_pcst->items_pcst[idx_u].argtable);
+        }
+    }
+
+    console_x->tableItems_pst = items_pst;
+    console_x->table_pcst = table_pcst;
+
+    return(exeResult_st);
+}
+
 /**--------------------------------------------------------------------------------------
  * @brief     Run function
  * @author    S. Wink
@@ -279,40 +959,20 @@ wserr_t wsconsole_RegisterCommand_t(wsconsole_tp console_x,
 wserr_t wsconsole_Run_t(wsconsole_tp console_x)
 {
     wserr_t exeResult_st = wserr_ERR_GEN;
-    int nerrors = 0;
     bool done = false;
-    cmdItem_t *cmd_pt = NULL;
-    char response_c[500];
-    int cli_argc;
-    char **cli_argv;
 
-    embedded_cli_prompt(&console_x->cli_st);
-    while (!done) {
-        char ch = console_x->config_st.getCharFunc_fp();
+    /* Consoles with only an input channel are driven by wsconsole_Step_t */
+    if((console_x->config_st.getCharFunc_fp == NULL)
+        && (console_x->config_st.getBufferFunc_fp == NULL))
+        return wserr_ERR_INVALID_STATE;
 
+    StartSession_vd(console_x);
+    while (!done) {
         /**
          * If we have entered a command, try and process it
          */
-        if (embedded_cli_insert_char(&console_x->cli_st, ch)) {
-            cli_argc = embedded_cli_argc(&console_x->cli_st, &cli_argv);
-
-            cmd_pt = FindCommandByName_stp(console_x, cli_argv[0]);
-            if(NULL != cmd_pt)
-            {
-                if(cmd_pt->thisItem_st.argtable != NULL)
-                {
-                    nerrors = arg_parse(cli_argc, cli_argv, cmd_pt->thisItem_st.argtable);
-                }
-                if(0 == nerrors)
-                {
-                    FILE* memstream = fmemopen(response_c, 500, "w");
-                    exeResult_st = cmd_pt->thisItem_st.func((wsconsole_cmdItem_t *)cmd_pt,
-                                                                memstream);
-                    embedded_cli_response(&console_x->cli_st, response_c);
-                    fclose(memstream);
-                }
-            }
-            embedded_cli_prompt(&console_x->cli_st);
+        if (ReadLine_bol(console_x)) {
+            exeResult_st = DispatchLine_t(console_x);
         }
     }
     return(exeResult_st);    
@@ -326,12 +986,67 @@ wserr_t wsconsole_Run_t(wsconsole_tp console_x)
 wserr_t wsconsole_DeInit_t(wsconsole_tp console_x)
 {
     wserr_t exeResult_st = wserr_ERR_GEN;
-    cmdItem_t *it, *tmp;
+    wsconsole_tp *link_ppx;
 
     if(console_x != NULL)
     {
-        SLIST_FOREACH_SAFE(it, &console_x->cmdList_st, nextItem_st, tmp)
-        free(it);
+        if(console_x->state_en == STATE_INITIALIZED)
+        {
+            (void)pthread_mutex_lock(&consoleListLock_sst);
+            for(link_ppx = &consoleList_sx; *link_ppx != NULL;
+                link_ppx = &(*link_ppx)->nextConsole_px)
+            {
+                if(*link_ppx == console_x)
+                {
+                    *link_ppx = console_x->nextConsole_px;
+                    break;
+                }
+            }
+            (void)pthread_mutex_unlock(&consoleListLock_sst);
+            /* wait for the external executor, a running command is asked to
+             * cancel */
+            if(console_x->config_st.submitFunc_fp != NULL)
+            {
+                (void)pthread_mutex_lock(&console_x->jobLock_st);
+                console_x->cancel_bol = true;
+                console_x->next_st.cmd_pst = NULL;
+                while(console_x->busy_bol)
+                {
+                    (void)pthread_cond_wait(&console_x->jobCond_st, &console_x->jobLock_st);
+                }
+                (void)pthread_mutex_unlock(&console_x->jobLock_st);
+            }
+            /* stop the worker thread, a running command is asked to cancel */
+            if(console_x->workerActive_bol)
+            {
+                (void)pthread_mutex_lock(&console_x->jobLock_st);
+                console_x->workerQuit_bol = true;
+                console_x->cancel_bol = true;
+                console_x->next_st.cmd_pst = NULL;
+                (void)pthread_cond_broadcast(&console_x->jobCond_st);
+                (void)pthread_mutex_unlock(&console_x->jobLock_st);
+                (void)pthread_join(console_x->worker_st, NULL);
+                console_x->workerActive_bol = false;
+            }
+            (void)pthread_cond_destroy(&console_x->jobCond_st);
+            (void)pthread_mutex_destroy(&console_x->jobLock_st);
+            (void)pthread_mutex_destroy(&console_x->outLock_st);
+            (void)pthread_mutex_destroy(&console_x->compLock_st);
+            /* only an initialized console has the terminal open */
+            if(console_x->config_st.termFd_i >= 0)
+            {
+                (void)wsterm_Close_t();
+            }
+        }
+        FreeArgClones_vd(console_x);
+        FreeCommands_vd(console_x);
+        free(console_x->lineMem_pv);
+        console_x->lineMem_pv = NULL;
+        if(console_x->respStream_fp != NULL)
+        {
+            (void)fclose(console_x->respStream_fp);
+            console_x->respStream_fp = NULL;
+        }
         console_x->state_en = STATE_ALLOCATED;
         exeResult_st = wserr_OK;
     }
@@ -339,6 +1054,272 @@ wserr_t wsconsole_DeInit_t(wsconsole_tp console_x)
     return(exeResult_st);    
 }
 
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the size of the line memory for command lines of lineLen_u bytes
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wsconsole_GetLineMemSize_u(size_t lineLen_u)
+{
+    /* line editor, running and queued command, each with line and arguments,
+     * the argument copy of the parser plus the alignment of the argument vectors */
+    return(LINE_COPIES * (lineLen_u + EMBEDDED_CLI_ARGC_FOR_LINE(lineLen_u) * sizeof(char *))
+            + EMBEDDED_CLI_ARGC_FOR_LINE(lineLen_u) * sizeof(char *) + sizeof(char *) - 1U);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates scratch memory from the arena of the console
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *wsconsole_ScratchAlloc_pv(wsconsole_cmdItem_tp cmd_pt, size_t size_u)
+{
+    wsconsole_tp console_x = ExecConsole_tp(cmd_pt);
+    size_t slots_u = (size_u + sizeof(scratchAlign_t) - 1U) / sizeof(scratchAlign_t);
+    void *mem_pv;
+
+    if((console_x == NULL) || (size_u == 0))
+        return NULL;
+
+    if(slots_u > (SCRATCH_SLOTS - console_x->scratchUsed_u))
+        return NULL;
+
+    mem_pv = &console_x->scratch_ua[console_x->scratchUsed_u];
+    console_x->scratchUsed_u += slots_u;
+
+    return(mem_pv);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the number of heap allocations of the last dispatch
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wsconsole_GetDispatchAllocs_u(wsconsole_tp console_x)
+{
+    size_t allocs_u;
+
+    if(console_x == NULL)
+        return 0;
+
+    if(console_x->state_en != STATE_INITIALIZED)
+        return(console_x->dispatchAllocs_u);
+
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    allocs_u = console_x->dispatchAllocs_u;
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    return(allocs_u);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Passes the response written so far on to the output channel
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_Flush_t(wsconsole_cmdItem_tp cmd_pt)
+{
+    wsconsole_tp console_x = ExecConsole_tp(cmd_pt);
+    bool error_bol;
+
+    if(console_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)fflush(console_x->respStream_fp);
+    FlushResponse_vd(console_x);
+
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    error_bol = console_x->outError_bol;
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+
+    return(error_bol ? wserr_ERR_GEN : wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the cancellation token of the running command
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+bool wsconsole_IsCancelled_bol(wsconsole_cmdItem_tp cmd_pt)
+{
+    wsconsole_tp console_x = ExecConsole_tp(cmd_pt);
+    bool cancel_bol;
+
+    if(console_x == NULL)
+        return false;
+
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    cancel_bol = console_x->cancel_bol;
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    return(cancel_bol);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Executes the command handed over to the external executor
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_ExecutePending_t(wsconsole_tp console_x)
+{
+    if(console_x == NULL)
+        return wserr_ERR_PARAM;
+
+    return(RunJob_t(console_x));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Executes a tokenized command line without the line editor
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_ExecuteArgv_t(wsconsole_tp console_x, int argc_i, char **argv_ppc)
+{
+    wserr_t exeResult_st;
+    cmdItem_t *cmd_pt;
+
+    if((console_x == NULL) || (argc_i <= 0) || (argv_ppc == NULL))
+        return wserr_ERR_PARAM;
+
+    if(console_x->state_en != STATE_INITIALIZED)
+        return wserr_ERR_INVALID_STATE;
+
+    cmd_pt = FindCommandByPrefix_stp((console_x->config_st.registry_x != NULL) ?
+                                        console_x->config_st.registry_x : console_x,
+                                    argv_ppc[0]);
+    console_x->rawOut_bol = true;
+    console_x->scratchUsed_u = 0;
+    if(NULL != cmd_pt)
+    {
+        exeResult_st = ParseExecute_t(console_x, cmd_pt, argc_i, argv_ppc);
+    }
+    else
+    {
+        fprintf(console_x->respStream_fp, "%s: command not found\n", argv_ppc[0]);
+        (void)fflush(console_x->respStream_fp);
+        exeResult_st = wserr_ERR_PARAM;
+    }
+    console_x->scratchUsed_u = 0;
+    console_x->rawOut_bol = false;
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Checks whether a command is registered as independent
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+bool wsconsole_IsIndependent_bol(wsconsole_tp console_x, const char *name_cpc)
+{
+    cmdItem_t *cmd_pt;
+
+    if((console_x == NULL) || (name_cpc == NULL))
+        return false;
+
+    cmd_pt = FindCommandByPrefix_stp((console_x->config_st.registry_x != NULL) ?
+                                        console_x->config_st.registry_x : console_x,
+                                    name_cpc);
+
+    return((cmd_pt != NULL) && cmd_pt->item_pcst->independent);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Writes text to the console output as it is
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_WriteRaw_t(wsconsole_tp console_x, const char *buf_pc, size_t len_u)
+{
+    if((console_x == NULL) || ((buf_pc == NULL) && (len_u > 0)))
+        return wserr_ERR_PARAM;
+
+    if(console_x->state_en != STATE_INITIALIZED)
+        return wserr_ERR_INVALID_STATE;
+
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    embedded_cli_response_raw(&console_x->cli_st, buf_pc, len_u);
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Passes received input to the console without blocking
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_Feed_t(wsconsole_tp console_x, const char *buf_pc, size_t len_u)
+{
+    size_t used_u;
+    bool line_bol;
+
+    if((console_x == NULL) || ((buf_pc == NULL) && (len_u > 0)))
+        return wserr_ERR_PARAM;
+
+    if(console_x->state_en != STATE_INITIALIZED)
+        return wserr_ERR_INVALID_STATE;
+
+    StartSession_vd(console_x);
+    while(len_u > 0)
+    {
+        used_u = ConsumeInput_u(console_x, buf_pc, len_u, &line_bol);
+        buf_pc += used_u;
+        len_u -= used_u;
+        if(line_bol)
+        {
+            (void)DispatchLine_t(console_x);
+        }
+    }
+    Idle_vd(console_x);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Reads the available input of the input channel
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsconsole_Step_t(wsconsole_tp console_x)
+{
+    ssize_t read_i;
+
+    if((console_x == NULL) || (console_x->config_st.inFd_i < 0))
+        return wserr_ERR_PARAM;
+
+    if(console_x->state_en != STATE_INITIALIZED)
+        return wserr_ERR_INVALID_STATE;
+
+    do
+    {
+        read_i = read(console_x->config_st.inFd_i, console_x->inBuffer_ca,
+                        sizeof(console_x->inBuffer_ca));
+    } while((read_i < 0) && (errno == EINTR));
+
+    if(read_i > 0)
+        return wsconsole_Feed_t(console_x, console_x->inBuffer_ca, (size_t)read_i);
+
+    if((read_i < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        return wserr_OK;
+
+    /* end of input or broken channel */
+    return(wserr_ERR_GEN);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the input channel of the console
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int wsconsole_GetInputFd_i(wsconsole_tp console_x)
+{
+    if(console_x == NULL)
+        return -1;
+
+    return(console_x->config_st.inFd_i);
+}
+
 /***************************************************************************************/
 /* Local functions: */
 
@@ -351,84 +1332,1211 @@ wserr_t wsconsole_DeInit_t(wsconsole_tp console_x)
 *//*------------------------------------------------------------------------------------*/
 static cmdItem_t *FindCommandByName_stp(wsconsole_tp console_x, const char *name_cpc)
 {
-    cmdItem_t *cmd_stp = NULL;
     cmdItem_t *item_stp;
-    SLIST_FOREACH(item_stp, &console_x->cmdList_st, nextItem_st)
+    uint32_t hash_u32;
+    size_t mask_u;
+    size_t slot_u;
+
+    if(name_cpc == NULL)
+        return NULL;
+
+    hash_u32 = wscmdtab_Hash_u32(name_cpc);
+
+    /* A command of the table can only be at the slot of its perfect hash */
+    if(console_x->table_pcst != NULL)
+    {
+        slot_u = wscmdtab_Slot_u(console_x->table_pcst, hash_u32);
+        if(strcmp(name_cpc, console_x->table_pcst->items_pcst[slot_u].command) == 0)
+            return(&console_x->tableItems_pst[slot_u]);
+    }
+
+    if(console_x->indexSize_u == 0)
+        return NULL;
+
+    mask_u = console_x->indexSize_u - 1U;
+    slot_u = hash_u32 & mask_u;
+
+    /* The index is never full, an empty slot ends the probe sequence */
+    while(NULL != (item_stp = console_x->cmdIndex_ppst[slot_u]))
     {
-        if (strcmp(name_cpc, item_stp->thisItem_st.command) == 0)
+        if((item_stp->hash_u32 == hash_u32) 
+            && (strcmp(name_cpc, item_stp->item_pcst->command) == 0))
         {
-            cmd_stp = item_stp;
-            break;
+            return item_stp;
         }
+        slot_u = (slot_u + 1U) & mask_u;
     }
-    return cmd_stp;
+    return NULL;
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief   Help command function, prints all commands registered to console
+ * @brief   Finds the command by its name or by a prefix only one command name starts
+ *              with, used for the typed, batch and pool executed lines alike
  * @author  S. Wink
- * @date    10. Mar. 2024
- * @param[in]   argc    number of arguments
- * @param[in]   argv    argument pointer vector
- * @param[out]  resp_pc pointer to zero terminated string response
- * @return      wserr_OK
+ * @date    16. Oct. 2026
+ * @param[in]   console_x   console holding the commands
+ * @param[in]   name_cpc    command name or prefix
+ * @return      pointer to the command item, else NULL
 *//*------------------------------------------------------------------------------------*/
-static int HelpCommand_i(wsconsole_cmdItem_tp cmd_pt, FILE *respStream_fp)
+static cmdItem_t *FindCommandByPrefix_stp(wsconsole_tp console_x, const char *name_cpc)
 {
-    cmdItem_t *item_stp;
-    wsconsole_cmdItem_t *cmd_stp;
-    int lineFeed_i = 0;
+    cmdItem_t *item_stp = FindCommandByName_stp(console_x, name_cpc);
+    wstrie_match_t match_st;
 
-    /* Print summary of each command */
-    SLIST_FOREACH(item_stp, &console_sx.cmdList_st, nextItem_st)
+    if((item_stp == NULL) && (name_cpc != NULL) && (name_cpc[0] != '\0')
+        && (wstrie_Match_u(&console_x->names_st, name_cpc, strlen(name_cpc), &match_st) == 1))
     {
-        cmd_stp = &item_stp->thisItem_st;
-        if (cmd_stp->help == NULL)
-        {
-            continue;
-        }
-        /* First line: command name and hint
-         * Pad all the hints to the same column
-         */
-        fprintf(respStream_fp, "%-s ", cmd_stp->command);
-        if(cmd_stp->hint != NULL)
+        item_stp = match_st.value_pv;
+    }
+    return item_stp;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Completion callback of the line editor, called on Tab. The command name is
+ *              extended as far as all matching names agree, a unique name is finished
+ *              with a blank, else the matching names are listed. The arguments behind
+ *              the command name are completed from the argtable of the command.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_pv  console object
+ * @param   cli_pst     line editor
+ * @param   line_cpc    line being edited
+ * @param   cursor_i    cursor position in the line
+*//*------------------------------------------------------------------------------------*/
+static void Complete_vd(void *console_pv, struct embedded_cli *cli_pst, const char *line_cpc,
+                        int cursor_i)
+{
+    wsconsole_tp console_x = console_pv;
+    wsconsole_tp registry_x = (console_x->config_st.registry_x != NULL) ?
+                                    console_x->config_st.registry_x : console_x;
+    wstrie_match_t match_st;
+    wscomp_list_t list_st;
+    char common_ca[COMPLETE_LEN];
+    size_t start_u = 0;
+    size_t len_u;
+    bool blank_bol;
+
+    /* the command name is the first word of the line */
+    while(((int)start_u < cursor_i) && isspace((unsigned char)line_cpc[start_u]))
+        start_u++;
+    for(len_u = 0; (int)(start_u + len_u) < cursor_i; len_u++)
+    {
+        if(isspace((unsigned char)line_cpc[start_u + len_u]))
         {
-            fprintf(respStream_fp, "%s\n", cmd_stp->hint);
+            CompleteArgs_vd(registry_x, cli_pst, line_cpc, cursor_i, &line_cpc[start_u], len_u);
+            return;
         }
-        else
+    }
+
+    if(wstrie_Match_u(&registry_x->names_st, &line_cpc[start_u], len_u, &match_st) == 0)
+        return;
+
+    /* the line changes with the first insert */
+    blank_bol = isspace((unsigned char)line_cpc[cursor_i]);
+    len_u = wstrie_Common_u(&registry_x->names_st, &match_st, common_ca, sizeof(common_ca));
+    embedded_cli_insert_text(cli_pst, common_ca, len_u);
+
+    if(match_st.keys_u == 1)
+    {
+        if(!blank_bol)
+            embedded_cli_insert_text(cli_pst, " ", 1);
+        return;
+    }
+
+    wscomp_ListBegin_vd(&list_st, cli_pst, WSCONSOLE_COMPLETE_LIST_MAX);
+    wstrie_ForEach_vd(&registry_x->names_st, &match_st, ListCandidate_bol, &list_st);
+    wscomp_ListEnd_vd(&list_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Completes an argument of a command with its completion index
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   registry_x  console holding the commands
+ * @param   cli_pst     line editor
+ * @param   line_cpc    line being edited
+ * @param   cursor_i    cursor position in the line
+ * @param   name_cpc    command name or unambiguous prefix, the first word of the line
+ * @param   len_u       length of the command name
+*//*------------------------------------------------------------------------------------*/
+static void CompleteArgs_vd(wsconsole_tp registry_x, struct embedded_cli *cli_pst,
+                            const char *line_cpc, int cursor_i, const char *name_cpc,
+                            size_t len_u)
+{
+    wscomp_tp comp_x = GetComp_x(registry_x, name_cpc, len_u);
+
+    if(comp_x != NULL)
+        wscomp_Complete_vd(comp_x, cli_pst, line_cpc, cursor_i, WSCONSOLE_COMPLETE_LIST_MAX);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads the directory listing the completion of the next Tab needs, called
+ *              by the input thread before it takes outLock_st. The input thread is the
+ *              only one changing the edited line, so it is read without the lock.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void PrepareComplete_vd(wsconsole_tp console_x)
+{
+    wsconsole_tp registry_x = (console_x->config_st.registry_x != NULL) ?
+                                    console_x->config_st.registry_x : console_x;
+    const char *line_cpc = console_x->cli_st.buffer;
+    int cursor_i = console_x->cli_st.cursor;
+    size_t start_u = 0;
+    size_t len_u;
+
+    /* only the arguments of a command are completed from a directory */
+    while(((int)start_u < cursor_i) && isspace((unsigned char)line_cpc[start_u]))
+        start_u++;
+    for(len_u = 0; (int)(start_u + len_u) < cursor_i; len_u++)
+    {
+        if(isspace((unsigned char)line_cpc[start_u + len_u]))
         {
-            fprintf(respStream_fp, " - NO HINT\n");    
+            wscomp_Prepare_vd(GetComp_x(registry_x, &line_cpc[start_u], len_u), line_cpc,
+                                cursor_i);
+            return;
         }
-        
-        /* Second line: print help.
-         * Argtable has a nice helper function for this which does line
-         * wrapping.
-         */
-        arg_print_formatted(respStream_fp, 2, 78, cmd_stp->help);
-        /* Finally, print the list of arguments */
-        if (cmd_stp->argtable)
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the completion index of a command, it is built with the first
+ *              completion and kept until the command is released
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   registry_x  console holding the commands
+ * @param   name_cpc    command name or unambiguous prefix
+ * @param   len_u       length of the command name
+ * @return  completion index, NULL if the command is unknown or has no argtable
+*//*------------------------------------------------------------------------------------*/
+static wscomp_tp GetComp_x(wsconsole_tp registry_x, const char *name_cpc, size_t len_u)
+{
+    cmdItem_t *cmd_pst = wstrie_Find_pv(&registry_x->names_st, name_cpc, len_u);
+    wstrie_match_t match_st;
+    wscomp_tp comp_x;
+
+    if((cmd_pst == NULL)
+        && (wstrie_Match_u(&registry_x->names_st, name_cpc, len_u, &match_st) == 1))
+    {
+        cmd_pst = match_st.value_pv;
+    }
+    if((cmd_pst == NULL) || (cmd_pst->item_pcst->argtable == NULL))
+        return NULL;
+
+    (void)pthread_mutex_lock(&registry_x->compLock_st);
+    if(cmd_pst->comp_x == NULL)
+        cmd_pst->comp_x = wscomp_Build_tp(cmd_pst->item_pcst->argtable);
+    comp_x = cmd_pst->comp_x;
+    (void)pthread_mutex_unlock(&registry_x->compLock_st);
+
+    return(comp_x);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Adds one command name to the candidate list
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   list_pv     candidate list
+ * @param   item_pv     matching command
+ * @return  false if the list is full
+*//*------------------------------------------------------------------------------------*/
+static bool ListCandidate_bol(void *list_pv, void *item_pv)
+{
+    const char *name_cpc = ((cmdItem_t *)item_pv)->item_pcst->command;
+
+    return(wscomp_ListAdd_bol(list_pv, NULL, name_cpc, strlen(name_cpc)));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Doubles the size of the command index and re-inserts all commands
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param[in]   console_x   console object
+ * @return      wserr_OK on success, wserr_ERR_NO_MEM if out of memory
+*//*------------------------------------------------------------------------------------*/
+static wserr_t GrowIndex_t(wsconsole_tp console_x)
+{
+    cmdItem_t **newIndex_ppst;
+    cmdItem_t *item_stp;
+    size_t newSize_u;
+    size_t mask_u;
+    size_t slot_u;
+
+    newSize_u = (console_x->indexSize_u == 0) ? CMD_INDEX_INIT_SIZE 
+                                              : (2U * console_x->indexSize_u);
+    newIndex_ppst = (cmdItem_t **) calloc(newSize_u, sizeof(cmdItem_t *));
+    if(NULL == newIndex_ppst)
+        return wserr_ERR_NO_MEM;
+
+    mask_u = newSize_u - 1U;
+    STAILQ_FOREACH(item_stp, &console_x->cmdList_st, nextItem_st)
+    {
+        slot_u = item_stp->hash_u32 & mask_u;
+        while(NULL != newIndex_ppst[slot_u])
         {
-            arg_print_glossary(respStream_fp, 
-                                (void **) cmd_stp->argtable, "  %12s  %s\n");
+            slot_u = (slot_u + 1U) & mask_u;
         }
+        newIndex_ppst[slot_u] = item_stp;
     }
-    return 0U;
+
+    free(console_x->cmdIndex_ppst);
+    console_x->cmdIndex_ppst = newIndex_ppst;
+    console_x->indexSize_u = newSize_u;
+    return wserr_OK;
 }
 
 /**---------------------------------------------------------------------------------------
- * @brief Register a 'help' command
+ * @brief   Feeds input into the command line interface until a line is completed or
+ *              the received input is used up
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param[in]   console_x   console object
+ * @return      true if a complete command line is available
 *//*------------------------------------------------------------------------------------*/
-static wserr_t RegisterHelpCommand_t(wsconsole_tp console_x)
+static bool ReadLine_bol(wsconsole_tp console_x)
 {
-    wsconsole_cmdItem_t command_st = 
+    char ch_c;
+    bool line_bol;
+
+    if(console_x->config_st.getBufferFunc_fp == NULL)
     {
-        .command = "help",
-        .help = "Print the list of registered commands",
-        .argtable = NULL,
-        .func = &HelpCommand_i
-    };
+        Idle_vd(console_x);
+        ch_c = console_x->config_st.getCharFunc_fp();
+        (void)ConsumeInput_u(console_x, &ch_c, 1, &line_bol);
+        return(line_bol);
+    }
 
-    return wsconsole_RegisterCommand_t(console_x, &command_st);
+    /* Refill the input buffer if everything was processed */
+    if(console_x->inHead_u >= console_x->inTail_u)
+    {
+        Idle_vd(console_x);
+        console_x->inHead_u = 0;
+        console_x->inTail_u = console_x->config_st.getBufferFunc_fp(
+                                console_x->inBuffer_ca, sizeof(console_x->inBuffer_ca));
+        if(console_x->inTail_u == 0)
+            return false;
+    }
+
+    console_x->inHead_u += ConsumeInput_u(console_x,
+                                            &console_x->inBuffer_ca[console_x->inHead_u],
+                                            console_x->inTail_u - console_x->inHead_u,
+                                            &line_bol);
+
+    return(line_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Passes input to the line editor up to the first completed line. While a
+ *              command runs, Ctrl-C cancels it instead of clearing the line.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @param   buf_pc      received characters
+ * @param   len_u       number of received characters, at least 1
+ * @param   line_pbol   set to true if a line was completed
+ * @return  number of characters consumed, at least 1
+*//*------------------------------------------------------------------------------------*/
+static size_t ConsumeInput_u(wsconsole_tp console_x, const char *buf_pc, size_t len_u,
+                                bool *line_pbol)
+{
+    const char *cancel_cpc;
+    const char *tab_cpc;
+    size_t used_u;
+
+    *line_pbol = false;
+    if(IsBusy_bol(console_x))
+    {
+        cancel_cpc = memchr(buf_pc, '\x03', len_u);
+        if(cancel_cpc == buf_pc)
+        {
+            Cancel_vd(console_x);
+            return 1;
+        }
+        if(cancel_cpc != NULL)
+            len_u = (size_t)(cancel_cpc - buf_pc);
+    }
+
+    /* A Tab is passed on its own, the directory listing it may need is read before
+     * the lock is taken */
+    tab_cpc = memchr(buf_pc, '\t', len_u);
+    if(tab_cpc == buf_pc)
+    {
+        PrepareComplete_vd(console_x);
+        len_u = 1;
+    }
+    else if(tab_cpc != NULL)
+    {
+        len_u = (size_t)(tab_cpc - buf_pc);
+    }
+
+    /* Parse the input, this stops at the first completed line */
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    used_u = embedded_cli_insert_buffer(&console_x->cli_st, buf_pc, len_u);
+    *line_pbol = (embedded_cli_get_line(&console_x->cli_st) != NULL);
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+
+    return(used_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Shows the first prompt of the console session
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void StartSession_vd(wsconsole_tp console_x)
+{
+    if(!console_x->started_bol)
+    {
+        console_x->started_bol = true;
+        Prompt_vd(console_x);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Does the work deferred by the dispatch when the input is processed, the
+ *              lines collected by the history are written and the history file is
+ *              compacted
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void Idle_vd(wsconsole_tp console_x)
+{
+    if(console_x->config_st.history_x != NULL)
+    {
+        (void)wshist_Flush_t(console_x->config_st.history_x);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Dispatches the completed command line: look up, parse, execute and send the
+ *              response. After warm-up this path does not use the heap, the argument
+ *              vector is tokenized in place, arg_parse copies it to the console and the
+ *              response stream is reused.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @return  result of the command callback, wserr_ERR_GEN if no command was executed
+*//*------------------------------------------------------------------------------------*/
+static wserr_t DispatchLine_t(wsconsole_tp console_x)
+{
+    wserr_t exeResult_st = wserr_ERR_GEN;
+    unsigned long allocs_u = CountAllocs_u(console_x);
+    cmdItem_t *cmd_pt = NULL;
+    int cli_argc;
+    char **cli_argv;
+    bool held_bol = false;
+    bool queued_bol = false;
+    bool submit_bol = false;
+    const char *line_cpc;
+    size_t handoff_u;
+
+    /* the line is stored before the tokenizer splits it up, it is written to the
+     * file by the idle step */
+    line_cpc = embedded_cli_get_line(&console_x->cli_st);
+    if((console_x->config_st.history_x != NULL) && (line_cpc != NULL))
+    {
+        (void)wshist_Append_t(console_x->config_st.history_x, line_cpc);
+    }
+
+    cli_argc = embedded_cli_argc(&console_x->cli_st, &cli_argv);
+    cmd_pt = FindCommandByPrefix_stp((console_x->config_st.registry_x != NULL) ?
+                                        console_x->config_st.registry_x : console_x,
+                                    cli_argv[0]);
+
+    if(console_x->deferred_bol)
+    {
+        /* the allocations of the command are counted where it runs */
+        handoff_u = (size_t)(CountAllocs_u(console_x) - allocs_u);
+        (void)pthread_mutex_lock(&console_x->jobLock_st);
+        if(console_x->busy_bol)
+        {
+            /* a line entered while a command runs is executed afterwards, an
+             * empty line, e.g. the LF of a CR LF client, is dropped silently */
+            held_bol = true;
+            if((NULL != cmd_pt) && (NULL == console_x->next_st.cmd_pst))
+            {
+                SetJob_vd(&console_x->next_st, cmd_pt, cli_argc, cli_argv);
+                console_x->next_st.allocs_u = handoff_u;
+                queued_bol = true;
+                exeResult_st = wserr_OK;
+            }
+            else if(cli_argc > 0)
+            {
+                exeResult_st = wserr_ERR_INVALID_STATE;
+            }
+        }
+        else if(NULL != cmd_pt)
+        {
+            /* the command line is parsed where the command runs */
+            SetJob_vd(&console_x->job_st, cmd_pt, cli_argc, cli_argv);
+            console_x->job_st.allocs_u = handoff_u;
+            queued_bol = true;
+            console_x->busy_bol = true;
+            console_x->cancel_bol = false;
+            (void)pthread_cond_broadcast(&console_x->jobCond_st);
+            held_bol = true;
+            submit_bol = (NULL != console_x->config_st.submitFunc_fp);
+            exeResult_st = wserr_OK;
+        }
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+        if(wserr_ERR_INVALID_STATE == exeResult_st)
+        {
+            (void)pthread_mutex_lock(&console_x->outLock_st);
+            embedded_cli_response(&console_x->cli_st,
+                                    "busy, Ctrl-C cancels the running command\n");
+            embedded_cli_redraw(&console_x->cli_st);
+            (void)pthread_mutex_unlock(&console_x->outLock_st);
+        }
+        if(submit_bol)
+        {
+            console_x->config_st.submitFunc_fp(console_x, console_x->config_st.submitData_pv);
+        }
+    }
+    else if(NULL != cmd_pt)
+    {
+        console_x->scratchUsed_u = 0;
+        exeResult_st = ParseExecute_t(console_x, cmd_pt, cli_argc, cli_argv);
+    }
+
+    /* the executor shows the prompt when the command is done */
+    if(!held_bol)
+    {
+        console_x->scratchUsed_u = 0;
+        Prompt_vd(console_x);
+    }
+
+    /* a queued command stores the count when it is done */
+    if(!queued_bol)
+    {
+        handoff_u = (size_t)(CountAllocs_u(console_x) - allocs_u);
+        (void)pthread_mutex_lock(&console_x->jobLock_st);
+        console_x->dispatchAllocs_u = handoff_u;
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+    }
+
+    return(exeResult_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Parses the arguments and executes the command, serialized with all other
+ *              consoles using the same command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @param   cmd_pt      command to execute
+ * @param   argc_i      number of arguments
+ * @param   argv_ppc    arguments
+ * @return  result of the command callback, wserr_ERR_PARAM if the arguments are invalid
+*//*------------------------------------------------------------------------------------*/
+static wserr_t ParseExecute_t(wsconsole_tp console_x, cmdItem_t *cmd_pt, int argc_i,
+                                char **argv_ppc)
+{
+    wserr_t exeResult_st = wserr_ERR_PARAM;
+    int nerrors_i = 0;
+    cmdItem_t *clone_pst = NULL;
+    arg_parse_ctx_t ctx_st;
+
+    /* independent commands parse into the copy of this console, without the lock
+     * several consoles run them at the same time */
+    if(cmd_pt->item_pcst->independent)
+        clone_pst = GetArgClone_pst(console_x, cmd_pt);
+
+    if(clone_pst != NULL)
+        cmd_pt = clone_pst;
+    else
+        (void)pthread_mutex_lock(&cmd_pt->argLock_st);
+
+    if(cmd_pt->item_pcst->argtable != NULL)
+    {
+        /* omitted optional arguments keep the values of the previous parse */
+        wsargs_RestoreDefaults_vd(cmd_pt->item_pcst->argtable, cmd_pt->defaults_pv);
+        nerrors_i = arg_parse_rbuf(argc_i, argv_ppc, cmd_pt->item_pcst->argtable, &ctx_st,
+                                    console_x->parseArgv_ppc, console_x->parseArgc_i);
+    }
+    if(0 == nerrors_i)
+    {
+        exeResult_st = ExecuteCommand_t(console_x, cmd_pt);
+    }
+    else if(console_x->rawOut_bol)
+    {
+        /* nobody watches a batch run, the reason is written to the output */
+        arg_print_errors(console_x->respStream_fp,
+                            FindArgEnd_pst(cmd_pt->item_pcst->argtable), argv_ppc[0]);
+        (void)fflush(console_x->respStream_fp);
+    }
+
+    if(clone_pst == NULL)
+        (void)pthread_mutex_unlock(&cmd_pt->argLock_st);
+
+    return(exeResult_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Executes the parsed command and sends the rest of its response
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @param   cmd_pt      command to execute, the argtable is already parsed
+ * @return  result of the command callback
+*//*------------------------------------------------------------------------------------*/
+static wserr_t ExecuteCommand_t(wsconsole_tp console_x, cmdItem_t *cmd_pt)
+{
+    wserr_t exeResult_st;
+
+    console_x->respAtomic_bol = cmd_pt->item_pcst->atomic;
+    console_x->respLen_u = 0;
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    console_x->outError_bol = false;
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+    execConsole_xs = console_x;
+    execItem_xs = cmd_pt;
+    exeResult_st = cmd_pt->item_pcst->func((wsconsole_cmdItem_t *)cmd_pt->item_pcst,
+                                                console_x->respStream_fp);
+    execItem_xs = NULL;
+    execConsole_xs = NULL;
+
+    /* pass on what is left in the stream and the atomic buffer */
+    (void)fflush(console_x->respStream_fp);
+    clearerr(console_x->respStream_fp);
+    FlushResponse_vd(console_x);
+    console_x->respAtomic_bol = false;
+
+    return(exeResult_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the copy of an independent command owned by the console, the copy
+ *              is created at the first use
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   executing console
+ * @param   cmd_pt      registered command
+ * @return  copy of the command, NULL if the argtable cannot be copied
+*//*------------------------------------------------------------------------------------*/
+static cmdItem_t *GetArgClone_pst(wsconsole_tp console_x, cmdItem_t *cmd_pt)
+{
+    argClone_t *clone_pst;
+
+    for(clone_pst = console_x->clones_pst; clone_pst != NULL; clone_pst = clone_pst->next_pst)
+    {
+        if(clone_pst->orig_pst == cmd_pt)
+            break;
+    }
+
+    if(clone_pst == NULL)
+    {
+        clone_pst = calloc(1, sizeof(argClone_t));
+        if(clone_pst == NULL)
+            return NULL;
+
+        /* a failed copy is remembered too, the command is then serialized */
+        clone_pst->orig_pst = cmd_pt;
+        clone_pst->item_st = *cmd_pt;
+        clone_pst->desc_st = *cmd_pt->item_pcst;
+        clone_pst->desc_st.argtable = (cmd_pt->item_pcst->argtable != NULL) ?
+                                wsargs_CloneTable_ppv(cmd_pt->item_pcst->argtable) : NULL;
+        clone_pst->item_st.item_pcst = &clone_pst->desc_st;
+        clone_pst->item_st.comp_x = NULL;
+        clone_pst->next_pst = console_x->clones_pst;
+        console_x->clones_pst = clone_pst;
+    }
+
+    if((clone_pst->desc_st.argtable == NULL)
+        && (cmd_pt->item_pcst->argtable != NULL))
+        return NULL;
+
+    return(&clone_pst->item_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Releases the command copies of the console
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void FreeArgClones_vd(wsconsole_tp console_x)
+{
+    argClone_t *clone_pst;
+
+    while(console_x->clones_pst != NULL)
+    {
+        clone_pst = console_x->clones_pst;
+        console_x->clones_pst = clone_pst->next_pst;
+        wsargs_FreeTable_vd(clone_pst->desc_st.argtable);
+        free(clone_pst);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sets up a job, the tokenized command line is copied because the line
+ *              editor reuses its buffer for the next line while the command runs
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   job_pst     job to set up
+ * @param   cmd_pt      command of the job
+ * @param   argc_i      number of arguments
+ * @param   argv_ppc    arguments, pointing into the line editor buffer
+*//*------------------------------------------------------------------------------------*/
+static void SetJob_vd(job_t *job_pst, cmdItem_t *cmd_pt, int argc_i, char **argv_ppc)
+{
+    size_t used_u = 0;
+    size_t len_u;
+    int idx_i;
+
+    for(idx_i = 0; idx_i < argc_i; idx_i++)
+    {
+        len_u = strlen(argv_ppc[idx_i]) + 1U;
+        if(len_u > (job_pst->lineSize_u - used_u))
+            break;
+        memcpy(&job_pst->line_pc[used_u], argv_ppc[idx_i], len_u);
+        job_pst->argv_ppc[idx_i] = &job_pst->line_pc[used_u];
+        used_u += len_u;
+    }
+    job_pst->argv_ppc[idx_i] = NULL;
+    job_pst->argc_i = idx_i;
+    job_pst->cmd_pst = cmd_pt;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Moves a job, the line buffers of the jobs are swapped, so the job moves
+ *              without copying the line
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   dst_pst     destination job, not running
+ * @param   src_pst     source job, empty afterwards
+*//*------------------------------------------------------------------------------------*/
+static void MoveJob_vd(job_t *dst_pst, job_t *src_pst)
+{
+    char **argv_ppc = dst_pst->argv_ppc;
+    char *line_pc = dst_pst->line_pc;
+
+    dst_pst->argv_ppc = src_pst->argv_ppc;
+    dst_pst->line_pc = src_pst->line_pc;
+    src_pst->argv_ppc = argv_ppc;
+    src_pst->line_pc = line_pc;
+    dst_pst->argc_i = src_pst->argc_i;
+    dst_pst->allocs_u = src_pst->allocs_u;
+    dst_pst->cmd_pst = src_pst->cmd_pst;
+    src_pst->cmd_pst = NULL;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Points the line editor, the jobs and the parser to their buffers, the compile time
+ *              buffers or the line memory for long lines
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @param   mem_pv      line memory of wsconsole_GetLineMemSize_u(lineLen_u) bytes,
+ *                      NULL if the compile time buffers are used
+*//*------------------------------------------------------------------------------------*/
+static void SetupLines_vd(wsconsole_tp console_x, void *mem_pv)
+{
+    job_t *jobs_apst[2] = { &console_x->job_st, &console_x->next_st };
+    size_t lineLen_u = console_x->config_st.lineLen_u;
+    size_t argc_u = EMBEDDED_CLI_ARGC_FOR_LINE(lineLen_u);
+    uintptr_t addr_u;
+    char **argv_ppc;
+    char *line_pc;
+    size_t idx_u;
+
+    if((mem_pv == NULL) || (lineLen_u <= EMBEDDED_CLI_MAX_LINE))
+    {
+        console_x->parseArgv_ppc = console_x->parseArgv_apc;
+        console_x->parseArgc_i = EMBEDDED_CLI_MAX_ARGC;
+        for(idx_u = 0; idx_u < 2U; idx_u++)
+        {
+            jobs_apst[idx_u]->argv_ppc = jobs_apst[idx_u]->argv_apc;
+            jobs_apst[idx_u]->line_pc = jobs_apst[idx_u]->line_ca;
+            jobs_apst[idx_u]->lineSize_u = sizeof(jobs_apst[idx_u]->line_ca);
+        }
+        return;
+    }
+
+    /* argument vectors first, they need the pointer alignment */
+    addr_u = ((uintptr_t)mem_pv + sizeof(char *) - 1U) & ~(uintptr_t)(sizeof(char *) - 1U);
+    argv_ppc = (char **)addr_u;
+    console_x->parseArgv_ppc = &argv_ppc[LINE_COPIES * argc_u];
+    console_x->parseArgc_i = (int)argc_u;
+    line_pc = (char *)&argv_ppc[(LINE_COPIES + 1U) * argc_u];
+
+    embedded_cli_set_buffers(&console_x->cli_st, line_pc, lineLen_u, argv_ppc,
+                                (int)argc_u);
+    for(idx_u = 0; idx_u < 2U; idx_u++)
+    {
+        jobs_apst[idx_u]->argv_ppc = &argv_ppc[(idx_u + 1U) * argc_u];
+        jobs_apst[idx_u]->line_pc = &line_pc[(idx_u + 1U) * lineLen_u];
+        jobs_apst[idx_u]->lineSize_u = lineLen_u;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Worker thread of the asynchronous execution, runs one command after the
+ *              other until the console is de-initialized
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_pv  console object
+ * @return  NULL
+*//*------------------------------------------------------------------------------------*/
+static void *Worker_pv(void *console_pv)
+{
+    wsconsole_tp console_x = console_pv;
+
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    while(!console_x->workerQuit_bol)
+    {
+        if(console_x->job_st.cmd_pst == NULL)
+        {
+            (void)pthread_cond_wait(&console_x->jobCond_st, &console_x->jobLock_st);
+            continue;
+        }
+
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+        (void)RunJob_t(console_x);
+        (void)pthread_mutex_lock(&console_x->jobLock_st);
+    }
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    return(NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Executes the pending command of the console, shows the prompt with the
+ *              text typed meanwhile and releases the console for the next command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @return  result of the command callback, wserr_ERR_INVALID_STATE if no command is
+ *              pending
+*//*------------------------------------------------------------------------------------*/
+static wserr_t RunJob_t(wsconsole_tp console_x)
+{
+    wserr_t exeResult_st;
+    unsigned long allocs_u;
+    bool idle_bol;
+
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    if(console_x->job_st.cmd_pst == NULL)
+    {
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+        return wserr_ERR_INVALID_STATE;
+    }
+
+    do
+    {
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+        /* the dispatch is measured on the thread executing the command */
+        allocs_u = CountAllocs_u(console_x);
+        console_x->scratchUsed_u = 0;
+        exeResult_st = ParseExecute_t(console_x, console_x->job_st.cmd_pst,
+                                        console_x->job_st.argc_i,
+                                        console_x->job_st.argv_ppc);
+        console_x->scratchUsed_u = 0;
+
+        /* the prompt with the text typed meanwhile is shown when no further line
+         * is queued, else the output of the next command would follow it */
+        (void)pthread_mutex_lock(&console_x->jobLock_st);
+        idle_bol = (console_x->next_st.cmd_pst == NULL);
+        (void)pthread_mutex_unlock(&console_x->jobLock_st);
+        if(idle_bol)
+            Redraw_vd(console_x);
+        allocs_u = CountAllocs_u(console_x) - allocs_u;
+
+        /* continue with the line entered meanwhile */
+        (void)pthread_mutex_lock(&console_x->jobLock_st);
+        console_x->dispatchAllocs_u = console_x->job_st.allocs_u + (size_t)allocs_u;
+        console_x->job_st.cmd_pst = NULL;
+        if(console_x->next_st.cmd_pst != NULL)
+        {
+            MoveJob_vd(&console_x->job_st, &console_x->next_st);
+            console_x->cancel_bol = false;
+        }
+    } while(console_x->job_st.cmd_pst != NULL);
+
+    console_x->busy_bol = false;
+    (void)pthread_cond_broadcast(&console_x->jobCond_st);
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    return(exeResult_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the console executing the command on this thread, else the console
+ *              the command is registered to
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt      command passed to the callback
+ * @return  console object, NULL if cmd_pt is NULL
+*//*------------------------------------------------------------------------------------*/
+static wsconsole_tp ExecConsole_tp(wsconsole_cmdItem_tp cmd_pt)
+{
+    if(cmd_pt == NULL)
+        return NULL;
+
+    return((execConsole_xs != NULL) ? execConsole_xs : wsconsole_GetConsole_tp(cmd_pt));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks if a command runs on the worker thread
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @return  true if a command runs
+*//*------------------------------------------------------------------------------------*/
+static bool IsBusy_bol(wsconsole_tp console_x)
+{
+    bool busy_bol;
+
+    if(!console_x->deferred_bol)
+        return false;
+
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    busy_bol = console_x->busy_bol;
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    return(busy_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sets the cancellation token of the running command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void Cancel_vd(wsconsole_tp console_x)
+{
+    (void)pthread_mutex_lock(&console_x->jobLock_st);
+    console_x->cancel_bol = true;
+    console_x->next_st.cmd_pst = NULL;
+    (void)pthread_mutex_unlock(&console_x->jobLock_st);
+
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    embedded_cli_response(&console_x->cli_st, "^C\n");
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Shows the prompt, serialized with the output of a running command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void Prompt_vd(wsconsole_tp console_x)
+{
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    embedded_cli_prompt(&console_x->cli_st);
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Shows the prompt and the text typed while a command ran, serialized with
+ *              the line editor
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void Redraw_vd(wsconsole_tp console_x)
+{
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    embedded_cli_redraw(&console_x->cli_st);
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the number of heap allocations made by the calling thread so far
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @return  value of the configured counter, arg_alloc_count if none is configured
+*//*------------------------------------------------------------------------------------*/
+static unsigned long CountAllocs_u(wsconsole_tp console_x)
+{
+    if(console_x->config_st.allocCountFunc_fp != NULL)
+        return(console_x->config_st.allocCountFunc_fp());
+
+    return(arg_alloc_count());
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Write function of the response stream. The output of atomic commands is
+ *              collected in the bounded response buffer, everything else is passed
+ *              on to the console output immediately.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cookie_pv   console object
+ * @param   buf_pc      characters written by the command
+ * @param   size_u      number of characters
+ * @return  number of characters consumed, -1 if the output channel failed
+*//*------------------------------------------------------------------------------------*/
+static ssize_t ResponseWrite_ss(void *cookie_pv, const char *buf_pc, size_t size_u)
+{
+    wsconsole_tp console_x = cookie_pv;
+    bool error_bol;
+
+    if(console_x->respAtomic_bol)
+    {
+        /* A response larger than the buffer cannot be atomic, send what is
+         * collected so far and continue, nothing is truncated */
+        if(size_u > (sizeof(console_x->respBuffer_ca) - console_x->respLen_u))
+        {
+            FlushResponse_vd(console_x);
+        }
+
+        if(size_u <= (sizeof(console_x->respBuffer_ca) - console_x->respLen_u))
+        {
+            memcpy(&console_x->respBuffer_ca[console_x->respLen_u], buf_pc, size_u);
+            console_x->respLen_u += size_u;
+            return((ssize_t)size_u);
+        }
+    }
+
+    (void)pthread_mutex_lock(&console_x->outLock_st);
+    OutputWrite_vd(console_x, buf_pc, size_u);
+    error_bol = console_x->outError_bol;
+    (void)pthread_mutex_unlock(&console_x->outLock_st);
+
+    /* report a failed output channel as stream error to the command */
+    if(error_bol)
+    {
+        errno = EIO;
+        return(-1);
+    }
+    return((ssize_t)size_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sends the content of the bounded response buffer to the console output
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void FlushResponse_vd(wsconsole_tp console_x)
+{
+    if(console_x->respLen_u > 0)
+    {
+        (void)pthread_mutex_lock(&console_x->outLock_st);
+        OutputWrite_vd(console_x, console_x->respBuffer_ca, console_x->respLen_u);
+        (void)pthread_mutex_unlock(&console_x->outLock_st);
+        console_x->respLen_u = 0;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Passes response data on to the console output, the caller holds outLock_st
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+ * @param   buf_pc      response data
+ * @param   len_u       number of characters
+*//*------------------------------------------------------------------------------------*/
+static void OutputWrite_vd(wsconsole_tp console_x, const char *buf_pc, size_t len_u)
+{
+    if(console_x->rawOut_bol)
+    {
+        embedded_cli_response_raw(&console_x->cli_st, buf_pc, len_u);
+    }
+    else
+    {
+        embedded_cli_response_write(&console_x->cli_st, buf_pc, len_u);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the arg_end entry terminating an argtable
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   argtable_ppv    argtable of a command
+ * @return  arg_end entry
+*//*------------------------------------------------------------------------------------*/
+static struct arg_end *FindArgEnd_pst(void **argtable_ppv)
+{
+    struct arg_hdr **table_ppst = (struct arg_hdr **)argtable_ppv;
+
+    while(!(table_ppst[0]->flag & ARG_TERMINATOR))
+    {
+        table_ppst++;
+    }
+
+    return((struct arg_end *)table_ppst[0]);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Output function for the file descriptor channel, writes the complete block
+ *              and waits while the descriptor cannot take more data
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   data_pv     console object
+ * @param   buf_pc      characters to write
+ * @param   len_u       number of characters
+*//*------------------------------------------------------------------------------------*/
+static void FdWrite_vd(void *data_pv, const char *buf_pc, size_t len_u)
+{
+    wsconsole_tp console_x = data_pv;
+    struct pollfd pfd_st = { .fd = console_x->config_st.outFd_i, .events = POLLOUT };
+    ssize_t written_i;
+    int ready_i;
+
+    while((len_u > 0) && !console_x->outError_bol)
+    {
+        written_i = write(console_x->config_st.outFd_i, buf_pc, len_u);
+        if(written_i > 0)
+        {
+            buf_pc += written_i;
+            len_u -= (size_t)written_i;
+        }
+        else if((written_i < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+        {
+            /* channel is full, wait until it drained */
+            do
+            {
+                ready_i = poll(&pfd_st, 1, console_x->config_st.outTimeoutMs_i);
+            } while((ready_i < 0) && (errno == EINTR));
+
+            if((ready_i <= 0) || (pfd_st.revents & (POLLERR | POLLHUP | POLLNVAL)))
+            {
+                console_x->outError_bol = true;
+            }
+        }
+        else if((written_i < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            console_x->outError_bol = true;
+        }
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Help command function, prints all commands registered to console
+ * @author  S. Wink
+ * @date    10. Mar. 2024
+ * @param[in]   argc    number of arguments
+ * @param[in]   argv    argument pointer vector
+ * @param[out]  resp_pc pointer to zero terminated string response
+ * @return      wserr_OK
+*//*------------------------------------------------------------------------------------*/
+static int HelpCommand_i(wsconsole_cmdItem_tp cmd_pt, FILE *respStream_fp)
+{
+    cmdItem_t *item_stp;
+    const wsconsole_cmdTable_t *table_pcst;
+    wsconsole_tp console_x = wsconsole_GetConsole_tp(cmd_pt);
+    size_t idx_u;
+
+    /* Print summary of each command */
+    STAILQ_FOREACH(item_stp, &console_x->cmdList_st, nextItem_st)
+    {
+        PrintHelp_vd(item_stp->item_pcst, respStream_fp);
+    }
+
+    /* and of the table commands in the order of their definition */
+    table_pcst = console_x->table_pcst;
+    for(idx_u = 0; (table_pcst != NULL) && (idx_u < table_pcst->count_u); idx_u++)
+    {
+        PrintHelp_vd(&table_pcst->items_pcst[(table_pcst->order_pcu16 != NULL) ?
+                                                table_pcst->order_pcu16[idx_u] : idx_u],
+                        respStream_fp);
+    }
+    return 0U;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Prints the help of one command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param[in]   cmd_pcst        command description
+ * @param[in]   respStream_fp   response stream
+*//*------------------------------------------------------------------------------------*/
+static void PrintHelp_vd(const wsconsole_cmdItem_t *cmd_pcst, FILE *respStream_fp)
+{
+    if (cmd_pcst->help == NULL)
+    {
+        return;
+    }
+    /* First line: command name and hint
+     * Pad all the hints to the same column
+     */
+    fprintf(respStream_fp, "%-s ", cmd_pcst->command);
+    if(cmd_pcst->hint != NULL)
+    {
+        fprintf(respStream_fp, "%s\n", cmd_pcst->hint);
+    }
+    else
+    {
+        fprintf(respStream_fp, " - NO HINT\n");    
+    }
+    
+    /* Second line: print help.
+     * Argtable has a nice helper function for this which does line
+     * wrapping.
+     */
+    arg_print_formatted(respStream_fp, 2, 78, cmd_pcst->help);
+    /* Finally, print the list of arguments */
+    if (cmd_pcst->argtable)
+    {
+        arg_print_glossary(respStream_fp, 
+                            (void **) cmd_pcst->argtable, "  %12s  %s\n");
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief Register a 'help' command
+*//*------------------------------------------------------------------------------------*/
+static wserr_t RegisterHelpCommand_t(wsconsole_tp console_x)
+{
+    wsconsole_cmdItem_t command_st = 
+    {
+        .command = "help",
+        .help = "Print the list of registered commands",
+        .argtable = NULL,
+        .func = &HelpCommand_i
+    };
+
+    return wsconsole_RegisterCommand_t(console_x, &command_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Releases the registered commands, the command table and the indexes over
+ *              the command names
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console object
+*//*------------------------------------------------------------------------------------*/
+static void FreeCommands_vd(wsconsole_tp console_x)
+{
+    cmdItem_t *it, *tmp;
+    size_t idx_u;
+
+    STAILQ_FOREACH_SAFE(it, &console_x->cmdList_st, nextItem_st, tmp)
+    {
+        (void)pthread_mutex_destroy(&it->argLock_st);
+        wscomp_Free_vd(it->comp_x);
+        wsargs_FreeDefaults_vd(it->defaults_pv);
+        free(it);
+    }
+    STAILQ_INIT(&console_x->cmdList_st);
+    if(console_x->table_pcst != NULL)
+    {
+        for(idx_u = 0; idx_u < console_x->table_pcst->count_u; idx_u++)
+        {
+            (void)pthread_mutex_destroy(&console_x->tableItems_pst[idx_u].argLock_st);
+            wscomp_Free_vd(console_x->tableItems_pst[idx_u].comp_x);
+            wsargs_FreeDefaults_vd(console_x->tableItems_pst[idx_u].defaults_pv);
+        }
+        free(console_x->tableItems_pst);
+        console_x->tableItems_pst = NULL;
+        console_x->table_pcst = NULL;
+    }
+    wstrie_Free_vd(&console_x->names_st);
+    free(console_x->cmdIndex_ppst);
+    console_x->cmdIndex_ppst = NULL;
+    console_x->indexSize_u = 0;
+    console_x->cmdCount_u = 0;
 }
 
 
@@ -12,9 +12,12 @@
 *   wsconsole_cmdItem_t command_st;
 *
 *   wserr_LOG(wsconsole_InitParameter_t(&consoleConfig_sts));
-*   consoleConfig_sts.getCharFunc_fp = GetCharacter_c;
+*   consoleConfig_sts.getBufferFunc_fp = wsterm_Read_u;
 *   consoleConfig_sts.intHandler_fp = InterruptHandler_vd;
 *   consoleConfig_sts.putCharFunc_fp = PosixPutCharacter_vd;
+*   consoleConfig_sts.writeFunc_fp = PosixWrite_vd;
+*   consoleConfig_sts.termFd_i = STDIN_FILENO;
+*   consoleConfig_sts.asyncExec_bol = true;
 *
 *   console_xs = wsconsole_AllocateConsole_t();
 *   wserr_LOG(wsconsole_Init_t(console_xs, &consoleConfig_sts));
@@ -23,6 +26,7 @@
 *   command_st.hint = NULL;
 *   command_st.help = "Adds the two numbers and returns the result.";
 *   command_st.func = &AddCommand_t;
+*   command_st.atomic = false;
 *   struct arg_int *add_args[2];
 *   add_args[0] = arg_int0(NULL, NULL, "<a>", "First number");
 *   add_args[1] = arg_int0(NULL, NULL, "<b>", "Second number");
@@ -38,6 +42,7 @@
 *   }
 *
 *   wserr_LOG(wsconsole_DeInit_t(console_x));
+*   wserr_LOG(wsconsole_FreeConsole_t(console_x));
 *   
 *   
 * Copyright (c) [2024] [Stephan Wink]
@@ -73,13 +78,60 @@ extern "C"
 #include <stdbool.h>
 #include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
 
 #include "wserr.h"
+#include "wshist.h"
 
 
 /****************************************************************************************/
 /* Global constant defines: */
 
+#ifndef WSCONSOLE_STATIC_POOL_SIZE
+/**
+ * Number of console objects in the static pool. If set to 0, console objects
+ * are allocated from the heap.
+ */
+#define WSCONSOLE_STATIC_POOL_SIZE 0
+#endif
+
+#ifndef WSCONSOLE_IN_BUF_LEN
+/**
+ * Size of the console input buffer used with the block input interface
+ */
+#define WSCONSOLE_IN_BUF_LEN 256
+#endif
+
+#ifndef WSCONSOLE_RESP_BUF_LEN
+/**
+ * Size of the bounded response buffer of atomic commands, see
+ * wsconsole_cmdItem_t.atomic
+ */
+#define WSCONSOLE_RESP_BUF_LEN 500
+#endif
+
+#ifndef WSCONSOLE_STREAM_BUF_LEN
+/**
+ * Size of the response stream buffer, the response is passed on to the output
+ * line by line or whenever this buffer is full
+ */
+#define WSCONSOLE_STREAM_BUF_LEN 128
+#endif
+
+#ifndef WSCONSOLE_SCRATCH_LEN
+/**
+ * Size of the per console scratch arena, reset after each command
+ */
+#define WSCONSOLE_SCRATCH_LEN 512
+#endif
+
+#ifndef WSCONSOLE_COMPLETE_LIST_MAX
+/**
+ * Maximum number of candidates listed when Tab is pressed on an ambiguous prefix
+ */
+#define WSCONSOLE_COMPLETE_LIST_MAX 100
+#endif
+
 /****************************************************************************************/
 /* Global function like macro defines (to be avoided): */
 
@@ -106,6 +158,15 @@ typedef wserr_t (*wsconsole_callBackFunc_t)(wsconsole_cmdItem_tp cmd_pt, FILE *r
  */
 typedef char (*wsconsole_getCharacter_t)(void);
 
+/**
+ * @brief Console get buffer function
+ * @param buf_pc        buffer to store the received characters
+ * @param size_u        size of the buffer
+ * @return number of received characters, blocks until at least one character is
+ *          available, 0 on end of input
+ */
+typedef size_t (*wsconsole_getBuffer_t)(char *buf_pc, size_t size_u);
+
 /**
  * @brief Console put character function
  * @param *data_pv      pointer to data channel
@@ -115,6 +176,15 @@ typedef char (*wsconsole_getCharacter_t)(void);
  */
 typedef void (*wsconsole_putCharacter_t)(void *data_pv, char ch_c, bool isLast_bol);
 
+/**
+ * @brief Console write function, outputs a block of characters
+ * @param *data_pv      pointer to data channel
+ * @param buf_pc        characters to print to channel
+ * @param len_u         number of characters in buf_pc
+ * @return none
+ */
+typedef void (*wsconsole_write_t)(void *data_pv, const char *buf_pc, size_t len_u);
+
 /**
  * @brief Console interrupt handler
  * @param dummy_i     dummy parameter to meet structure
@@ -122,6 +192,27 @@ typedef void (*wsconsole_putCharacter_t)(void *data_pv, char ch_c, bool isLast_b
  */
 typedef void (*wsconsole_intHandler_t)(int dummy_i);
 
+/**
+ * @brief Abstract datatype console object
+ */
+typedef struct wsconsole_tag *wsconsole_tp;
+
+/**
+ * @brief Hands a pending command of the console to an external executor, which
+ *          runs it later with wsconsole_ExecutePending_t
+ * @param console_x   console with the pending command
+ * @param data_pv     user data of the configuration
+ * @return none
+ */
+typedef void (*wsconsole_submit_t)(wsconsole_tp console_x, void *data_pv);
+
+/**
+ * @brief Counts the heap allocations made by the calling thread, e.g. a malloc
+ *          wrapper of a test
+ * @return number of allocations so far
+ */
+typedef unsigned long (*wsconsole_allocCount_t)(void);
+
 /**
  * @brief Parameters for console initialization
  */
@@ -131,15 +222,104 @@ typedef struct wsconsole_config_tag
      * Function pointer interface to get a character by polling.
      */
     wsconsole_getCharacter_t getCharFunc_fp;
+    /**
+     * Function pointer interface to get a block of characters. If set, it is
+     * used instead of getCharFunc_fp.
+     */
+    wsconsole_getBuffer_t getBufferFunc_fp;
     /**
      * Function pointer interface to print a character to the outstream
      */
     wsconsole_putCharacter_t putCharFunc_fp;
+    /**
+     * Function pointer interface to print a block of characters to the outstream.
+     * If set, it is used instead of putCharFunc_fp and each console update
+     * (echo, prompt, response) is passed on with as few calls as possible.
+     */
+    wsconsole_write_t writeFunc_fp;
+    /**
+     * Data channel passed to putCharFunc_fp and writeFunc_fp, stdout if NULL.
+     */
+    void *outData_pv;
     /**
      * Function pointer interface to the interrupt handler for special 
      * characters.
      */
     wsconsole_intHandler_t intHandler_fp;
+    /**
+     * File descriptor of the terminal input. If set (>= 0), the terminal session
+     * (wsterm) is opened in raw mode at wsconsole_Init_t and restored at
+     * wsconsole_DeInit_t. Set to -1 if the input channel is not a terminal.
+     */
+    int termFd_i;
+    /**
+     * File descriptor of the input channel read by wsconsole_Step_t, it should
+     * be non-blocking. Set to -1 if the input is passed with wsconsole_Feed_t or
+     * read by wsconsole_Run_t.
+     */
+    int inFd_i;
+    /**
+     * File descriptor of the output channel, e.g. a socket or a serial port. If
+     * set (>= 0), it is used instead of writeFunc_fp and putCharFunc_fp. The
+     * descriptor may be non-blocking, the console then waits until it is
+     * writable again, so a slow channel throttles the writing command
+     * (backpressure) and the memory use stays constant. Set to -1 if not used.
+     */
+    int outFd_i;
+    /**
+     * Maximum time in milliseconds to wait for the output channel outFd_i to
+     * become writable, -1 waits forever. If the time elapses, the pending
+     * output is dropped and the response stream reports an error.
+     */
+    int outTimeoutMs_i;
+    /**
+     * If set, commands are executed on a worker thread of the console. The line
+     * editor stays responsive while a command runs and Ctrl-C requests the
+     * cancellation of the running command, see wsconsole_IsCancelled_bol.
+     * One line entered while a command runs is executed afterwards, further
+     * lines are rejected.
+     */
+    bool asyncExec_bol;
+    /**
+     * If set, commands are executed by an external executor, e.g. a worker pool
+     * shared by many consoles. The console behaves like with asyncExec_bol, but
+     * has no thread of its own. Set to NULL to execute on the console.
+     */
+    wsconsole_submit_t submitFunc_fp;
+    void *submitData_pv;
+    /**
+     * If set, the commands are looked up in the registry of this console instead
+     * of the own one. The registry is read only while other consoles use it. An
+     * argtable holds the parse results, so one command executes at a time across
+     * all consoles sharing it, different commands run in parallel.
+     */
+    wsconsole_tp registry_x;
+    /**
+     * If set, the history of the line editor is restored from this history at
+     * wsconsole_Init_t and every executed line is appended to it. The file is
+     * written when the console waits for input, see wshist_Flush_t. The history
+     * may be shared by many consoles. Set to NULL to keep the history in memory.
+     */
+    wshist_tp history_x;
+    /**
+     * Maximum length of a command line including the terminating nul, 0 uses
+     * the compile time size EMBEDDED_CLI_MAX_LINE. The argument vector grows
+     * with the line, so the arguments of a long line are never cut off.
+     */
+    size_t lineLen_u;
+    /**
+     * Memory for the line buffers if lineLen_u is set, at least
+     * wsconsole_GetLineMemSize_u(lineLen_u) bytes which stay valid until
+     * wsconsole_DeInit_t. Set to NULL to allocate the memory at wsconsole_Init_t.
+     */
+    void *lineMem_pv;
+    size_t lineMemSize_u;
+    /**
+     * Counter of the heap allocations of the calling thread, read before and
+     * after each dispatch for wsconsole_GetDispatchAllocs_u. Set to NULL to
+     * count the allocations of the argument parser only (arg_alloc_count).
+     */
+    wsconsole_allocCount_t allocCountFunc_fp;
 } wsconsole_config_t;
 
 /**
@@ -172,12 +352,40 @@ typedef struct wsconsole_cmdItem_tag{
      * Only used for the duration of esp_console_cmd_register call.
      */
     void *argtable;
+    /**
+     * If set, the response is collected in a bounded buffer of
+     * WSCONSOLE_RESP_BUF_LEN characters and sent in one piece when the callback
+     * returns. Otherwise the response is streamed to the output while the
+     * callback writes it, which suits large outputs.
+     */
+    bool atomic;
+    /**
+     * If set, the command has no side effects on shared state and may run at the
+     * same time as other independent commands, e.g. in a parallel batch run. Every
+     * executing console parses into its own copy of the argtable.
+     */
+    bool independent;
 } wsconsole_cmdItem_t;
 
 /**
- * @brief Abstract datatype console object
+ * @brief Command table built at compile time, see wscmdtab.h
  */
-typedef struct wsconsole_tag *wsconsole_tp;
+typedef struct wsconsole_cmdTable_tag{
+    /**
+     * Command descriptions, each at the slot of the perfect hash of its name
+     */
+    const wsconsole_cmdItem_t *items_pcst;
+    size_t count_u;
+    /**
+     * Seed of the slot hash for every bucket of names
+     */
+    const uint16_t *seeds_pcu16;
+    size_t buckets_u;
+    /**
+     * Slots in the order of the definition file, used for the help listing
+     */
+    const uint16_t *order_pcu16;
+} wsconsole_cmdTable_t;
 
 /****************************************************************************************/
 /* Global function definitions: */
@@ -193,14 +401,42 @@ typedef struct wsconsole_tag *wsconsole_tp;
 extern wserr_t wsconsole_InitParameter_t(wsconsole_config_t *config_stp);
 
 /**---------------------------------------------------------------------------------------
- * @brief   allocates the console
+ * @brief   allocates a new console, every console has its own command line interface
+ *              state and command table. Consoles are taken from the heap or, if
+ *              WSCONSOLE_STATIC_POOL_SIZE is set, from a static pool.
  * @author  S. Wink
  * @date    05. Mar. 2024
  * @return
  *          - allocated wsconsole opaque pointer
+ *          - NULL if out of memory or the pool is exhausted
 *//*------------------------------------------------------------------------------------*/
 wsconsole_tp wsconsole_AllocateConsole_t(void);
 
+/**---------------------------------------------------------------------------------------
+ * @brief   releases a console allocated by wsconsole_AllocateConsole_t, an initialized
+ *              console is de-initialized first
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @return
+ *          - OK on success
+ *          - ERR_PARAM if console_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_FreeConsole_t(wsconsole_tp console_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the console a command is registered to, inside of the command
+ *              callback without searching the initialized consoles
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt        command passed to the command callback function or entry of
+ *                        a registered command table
+ * @return
+ *          - owning console object
+ *          - NULL if cmd_pt is NULL or not registered to an initialized console
+*//*------------------------------------------------------------------------------------*/
+extern wsconsole_tp wsconsole_GetConsole_tp(wsconsole_cmdItem_tp cmd_pt);
+
 /**---------------------------------------------------------------------------------------
  * @brief   initialize console module, Call this once before using other console module
  *              features
@@ -211,7 +447,9 @@ wsconsole_tp wsconsole_AllocateConsole_t(void);
  * @return
  *          - OK on success
  *          - ERR_NO_MEM if out of memory
+ *          - ERR_PARAM if no input interface is configured
  *          - ERR_INVALID_STATE if already initialized
+ *          - ERR_GEN if the terminal session could not be opened
 *//*------------------------------------------------------------------------------------*/
 extern wserr_t wsconsole_Init_t(wsconsole_tp console_x, wsconsole_config_t *config_stp);
 
@@ -234,12 +472,29 @@ extern wserr_t wsconsole_ValidateCommand_t(wsconsole_cmdItem_t *newItem_stp);
  * @return
  *          - OK on success
  *          - ERR_NO_MEM if out of memory
- *          - ERR_PARAM if parameter not correct
+ *          - ERR_PARAM if parameter not correct or command name already registered
  *          - ESP_ERR_INVALID_STATE, if esp_console_init wasn't called
 *//*------------------------------------------------------------------------------------*/
 extern wserr_t wsconsole_RegisterCommand_t(wsconsole_tp console_x, 
                                             wsconsole_cmdItem_t *newItem_stp);
 
+/**---------------------------------------------------------------------------------------
+ * @brief   registers a command table built at compile time, the descriptions are used
+ *              in place and are not copied. A console holds one table, the commands
+ *              registered at run time are looked up after it.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @param   table_pcst    command table, must stay valid until wsconsole_DeInit_t
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if the table is invalid or a name is registered already
+ *          - wserr_ERR_INVALID_STATE if the console holds a table already
+ *          - wserr_ERR_NO_MEM if out of memory
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_RegisterTable_t(wsconsole_tp console_x,
+                                            const wsconsole_cmdTable_t *table_pcst);
+
 /**---------------------------------------------------------------------------------------
  * @brief   Run command line
  * @author  S. Wink
@@ -266,6 +521,171 @@ extern wserr_t wsconsole_Run_t(wsconsole_tp console_x);
 *//*------------------------------------------------------------------------------------*/
 extern wserr_t wsconsole_DeInit_t(wsconsole_tp console_x);
 
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the size of the line memory a console needs for command lines of
+ *              lineLen_u bytes, see lineMem_pv of wsconsole_config_t
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   lineLen_u     maximum length of a command line including the nul
+ * @return  number of bytes, for the line editor, the two queued commands and the
+ *              argument copy of the parser
+*//*------------------------------------------------------------------------------------*/
+extern size_t wsconsole_GetLineMemSize_u(size_t lineLen_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   allocates scratch memory from the arena of the console, to be used inside of
+ *              the command callback function. The memory is valid until the callback
+ *              returns, the arena is reset after each command and never uses the heap.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt        command passed to the command callback function
+ * @param   size_u        number of bytes requested
+ * @return
+ *          - pointer to the scratch memory, aligned for any basic type
+ *          - NULL if the arena is exhausted or cmd_pt is NULL
+*//*------------------------------------------------------------------------------------*/
+extern void *wsconsole_ScratchAlloc_pv(wsconsole_cmdItem_tp cmd_pt, size_t size_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   test hook, returns the number of heap allocations counted by
+ *              allocCountFunc_fp of the configuration while the last command line
+ *              was dispatched, from the history over the parse and the command to
+ *              the prompt. A deferred command adds the count of the executing thread
+ *              when it is done, the call of submitFunc_fp is not counted. A value
+ *              other than 0 after warm-up is a regression.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @return  number of heap allocations of the last dispatch, 0 if console_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern size_t wsconsole_GetDispatchAllocs_u(wsconsole_tp console_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   passes the response written so far on to the output channel, to be used
+ *              inside of the command callback function to deliver the output of a long
+ *              running command partway. Returns when the output channel accepted the
+ *              data, so a slow channel throttles the command.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt        command passed to the command callback function
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if cmd_pt is NULL
+ *          - wserr_ERR_GEN if the output channel failed or timed out, the command
+ *              should stop producing output
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_Flush_t(wsconsole_cmdItem_tp cmd_pt);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the cancellation token of the running command, to be polled inside
+ *              of the command callback function. The token is set when Ctrl-C is
+ *              received while the command runs asynchronously (asyncExec_bol).
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt        command passed to the command callback function
+ * @return  true if the command shall stop, false otherwise or if cmd_pt is NULL
+*//*------------------------------------------------------------------------------------*/
+extern bool wsconsole_IsCancelled_bol(wsconsole_cmdItem_tp cmd_pt);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   executes the command handed over with submitFunc_fp, to be called by the
+ *              executor on its own thread. The prompt and the text typed meanwhile
+ *              are shown afterwards and the console accepts the next command.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @return
+ *          - result of the command callback
+ *          - wserr_ERR_PARAM if console_x is NULL
+ *          - wserr_ERR_INVALID_STATE if no command is pending
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_ExecutePending_t(wsconsole_tp console_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   executes a tokenized command line without the line editor, there is no
+ *              echo, prompt or history and the response is written to the output as
+ *              it is. Unknown commands and invalid arguments are reported to the
+ *              output. As for typed lines, an unambiguous prefix selects the command.
+ *              Used by the batch mode, see wsbatch.h.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @param   argc_i        number of arguments, the first one is the command name
+ * @param   argv_ppc      arguments, see embedded_cli_tokenize
+ * @return
+ *          - result of the command callback
+ *          - wserr_ERR_PARAM if the command is unknown or the arguments are invalid
+ *          - wserr_ERR_INVALID_STATE if the console is not initialized
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_ExecuteArgv_t(wsconsole_tp console_x, int argc_i, char **argv_ppc);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   checks whether a command is registered as independent, see
+ *              wsconsole_cmdItem_t
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @param   name_cpc      command name or unambiguous prefix
+ * @return  true if the command is known and independent
+*//*------------------------------------------------------------------------------------*/
+extern bool wsconsole_IsIndependent_bol(wsconsole_tp console_x, const char *name_cpc);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   writes text to the console output as it is, e.g. the response of a command
+ *              which was collected on another console
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @param   buf_pc        characters to write
+ * @param   len_u         number of characters
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_INVALID_STATE if the console is not initialized
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_WriteRaw_t(wsconsole_tp console_x, const char *buf_pc,
+                                        size_t len_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   passes received input to the console without blocking, every line completed
+ *              by the input is executed before the function returns. This is the event
+ *              loop alternative to wsconsole_Run_t, both must not be mixed on one
+ *              console.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @param   buf_pc        received characters
+ * @param   len_u         number of received characters
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_INVALID_STATE if the console is not initialized
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_Feed_t(wsconsole_tp console_x, const char *buf_pc, size_t len_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   reads the available input from the input channel inFd_i and passes it to
+ *              wsconsole_Feed_t, to be called when the descriptor is readable
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @return
+ *          - wserr_OK on success, also if no input was available
+ *          - wserr_ERR_PARAM if console_x is NULL or has no input channel
+ *          - wserr_ERR_INVALID_STATE if the console is not initialized
+ *          - wserr_ERR_GEN on end of input or read error, the console should be closed
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsconsole_Step_t(wsconsole_tp console_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the input channel of the console to register it with an event loop
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x     console object
+ * @return  file descriptor inFd_i of the configuration, -1 if not set or console_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern int wsconsole_GetInputFd_i(wsconsole_tp console_x);
+
 /****************************************************************************************/
 /* Global data definitions: */
 
@@ -0,0 +1,606 @@
+/****************************************************************************************
+* FILENAME :        wshist.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the persistent command history of the console
+*
+* DETAILED DESCRIPTION :
+*   The entered lines are collected in the history object and appended to the
+*   history file with one write() call when the console is idle. At
+*   start up the file is mapped and scanned backwards from its end until the line
+*   editor history is full, so the start up time does not depend on the file size.
+*   A file above the size limit is compacted to its newest half, the copy replaces
+*   the old file by rename(). Processes sharing the file serialize the compaction
+*   with an exclusive lock and write with a shared lock, a writer which finds the
+*   file replaced reopens it.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+#include "wshist.h"
+
+#include "wserr.h"
+#include "embedded_cli.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Suffix of the temporary file written by the compaction
+ */
+#define TMP_SUFFIX ".tmp"
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief History object implementation
+ */
+typedef struct wshist_tag
+{
+    /**
+     * serializes the consoles sharing the history
+     */
+    pthread_mutex_t lock_st;
+    char *path_pc;
+    size_t maxBytes_u;
+    /**
+     * open history file and its identity, used to detect a replaced file
+     */
+    int fd_i;
+    dev_t dev_x;
+    ino_t ino_x;
+    /**
+     * size of the file when it was written last, plus the lines written since
+     */
+    size_t fileSize_u;
+    /**
+     * lines not yet written to the file, each one with its line feed
+     */
+    size_t pendingLen_u;
+    char pending_ca[WSHIST_PENDING_LEN];
+    /**
+     * last appended line, a repeat is not written again, lastLen_u is 0 if the
+     * line did not fit
+     */
+    size_t lastLen_u;
+    char last_ca[WSHIST_LAST_LEN];
+}wshist_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static bool OpenFile_bol(wshist_tp hist_x);
+static bool LockCurrent_bol(wshist_tp hist_x, int operation_i);
+static void Compact_vd(wshist_tp hist_x);
+static bool WritePending_bol(wshist_tp hist_x);
+static bool WriteAll_bol(int fd_i, const char *data_cpc, size_t len_u);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Initializes the history configuration with default values
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wshist_InitParameter_t(wshist_config_t *config_stp)
+{
+    if(config_stp == NULL)
+        return wserr_ERR_PARAM;
+
+    config_stp->path_cpc = NULL;
+    config_stp->maxBytes_u = WSHIST_MAX_BYTES;
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Opens or creates the history file
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wshist_tp wshist_AllocateHistory_t(const wshist_config_t *config_stp)
+{
+    wshist_tp hist_x;
+    struct stat stat_st;
+    char last_c;
+
+    if((config_stp == NULL) || (config_stp->path_cpc == NULL) ||
+       (config_stp->maxBytes_u < WSHIST_MIN_BYTES))
+        return NULL;
+
+    hist_x = calloc(1, sizeof(wshist_t));
+    if(hist_x == NULL)
+        return NULL;
+
+    hist_x->fd_i = -1;
+    hist_x->maxBytes_u = config_stp->maxBytes_u;
+    hist_x->path_pc = strdup(config_stp->path_cpc);
+    if((hist_x->path_pc == NULL) || !OpenFile_bol(hist_x))
+    {
+        free(hist_x->path_pc);
+        free(hist_x);
+        return NULL;
+    }
+    (void)pthread_mutex_init(&hist_x->lock_st, NULL);
+
+    /* A line cut off by a crash is terminated, so the next line starts in
+     * a line of its own */
+    if(LockCurrent_bol(hist_x, LOCK_EX))
+    {
+        if((fstat(hist_x->fd_i, &stat_st) == 0) && (stat_st.st_size > 0) &&
+           (pread(hist_x->fd_i, &last_c, 1, stat_st.st_size - 1) == 1) &&
+           (last_c != '\n'))
+        {
+            (void)WriteAll_bol(hist_x->fd_i, "\n", 1);
+        }
+        (void)flock(hist_x->fd_i, LOCK_UN);
+    }
+    Compact_vd(hist_x);
+    if(fstat(hist_x->fd_i, &stat_st) == 0)
+        hist_x->fileSize_u = (size_t)stat_st.st_size;
+
+    return(hist_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Closes the history file and releases the history object
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wshist_FreeHistory_t(wshist_tp hist_x)
+{
+    if(hist_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)WritePending_bol(hist_x);
+    if(hist_x->fd_i >= 0)
+        (void)close(hist_x->fd_i);
+    (void)pthread_mutex_destroy(&hist_x->lock_st);
+    free(hist_x->path_pc);
+    free(hist_x);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Appends one line to the history file
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wshist_Append_t(wshist_tp hist_x, const char *line_cpc)
+{
+    wserr_t exeResult_st = wserr_OK;
+    struct iovec iov_st[2];
+    size_t len_u;
+    ssize_t written_i;
+
+    if((hist_x == NULL) || (line_cpc == NULL) || (strchr(line_cpc, '\n') != NULL))
+        return wserr_ERR_PARAM;
+
+    len_u = strlen(line_cpc);
+    if(len_u == 0)
+        return wserr_OK;
+
+    (void)pthread_mutex_lock(&hist_x->lock_st);
+
+    if((hist_x->lastLen_u == len_u) && (memcmp(hist_x->last_ca, line_cpc, len_u) == 0))
+    {
+        (void)pthread_mutex_unlock(&hist_x->lock_st);
+        return wserr_OK;
+    }
+
+    /* a full buffer is written here, the idle step did not come in time */
+    if((len_u + 1U) > (sizeof(hist_x->pending_ca) - hist_x->pendingLen_u))
+    {
+        if(!WritePending_bol(hist_x))
+            exeResult_st = wserr_ERR_GEN;
+    }
+
+    if((len_u + 1U) <= sizeof(hist_x->pending_ca))
+    {
+        memcpy(&hist_x->pending_ca[hist_x->pendingLen_u], line_cpc, len_u);
+        hist_x->pending_ca[hist_x->pendingLen_u + len_u] = '\n';
+        hist_x->pendingLen_u += len_u + 1U;
+    }
+    else if(LockCurrent_bol(hist_x, LOCK_SH))
+    {
+        /* line and line feed are written with one call, so lines of other
+         * writers of the file are never interleaved */
+        iov_st[0].iov_base = (void *)line_cpc;
+        iov_st[0].iov_len = len_u;
+        iov_st[1].iov_base = "\n";
+        iov_st[1].iov_len = 1;
+        do
+        {
+            written_i = writev(hist_x->fd_i, iov_st, 2);
+        } while((written_i < 0) && (errno == EINTR));
+        (void)flock(hist_x->fd_i, LOCK_UN);
+
+        if(written_i != (ssize_t)(len_u + 1))
+            exeResult_st = wserr_ERR_GEN;
+        else
+            hist_x->fileSize_u += len_u + 1U;
+    }
+    else
+    {
+        exeResult_st = wserr_ERR_GEN;
+    }
+
+    if(len_u < sizeof(hist_x->last_ca))
+    {
+        memcpy(hist_x->last_ca, line_cpc, len_u);
+        hist_x->lastLen_u = len_u;
+    }
+    else
+    {
+        hist_x->lastLen_u = 0;
+    }
+
+    (void)pthread_mutex_unlock(&hist_x->lock_st);
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Writes the collected lines and compacts the history file
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wshist_Flush_t(wshist_tp hist_x)
+{
+    wserr_t exeResult_st = wserr_OK;
+    struct stat stat_st;
+
+    if(hist_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)pthread_mutex_lock(&hist_x->lock_st);
+
+    if(!WritePending_bol(hist_x))
+        exeResult_st = wserr_ERR_GEN;
+
+    /* the size counts the lines of this process only, the compaction checks the
+     * real size under the exclusive lock */
+    if(hist_x->fileSize_u > hist_x->maxBytes_u)
+    {
+        Compact_vd(hist_x);
+        if(fstat(hist_x->fd_i, &stat_st) == 0)
+            hist_x->fileSize_u = (size_t)stat_st.st_size;
+    }
+
+    (void)pthread_mutex_unlock(&hist_x->lock_st);
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Restores the newest lines of the history file into the line editor
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wshist_Load_t(wshist_tp hist_x, struct embedded_cli *cli_pst)
+{
+#if EMBEDDED_CLI_HISTORY_LEN
+    wserr_t exeResult_st = wserr_OK;
+    struct stat stat_st;
+    char *map_pc;
+    size_t size_u;
+    size_t end_u;
+    size_t pos_u;
+    size_t start_u;
+    size_t bytes_u = 0;
+    size_t count_u = 0;
+    size_t len_u;
+
+    if((hist_x == NULL) || (cli_pst == NULL))
+        return wserr_ERR_PARAM;
+
+    (void)pthread_mutex_lock(&hist_x->lock_st);
+
+    if(!LockCurrent_bol(hist_x, LOCK_SH))
+    {
+        (void)pthread_mutex_unlock(&hist_x->lock_st);
+        return wserr_ERR_GEN;
+    }
+
+    if(fstat(hist_x->fd_i, &stat_st) != 0)
+    {
+        exeResult_st = wserr_ERR_GEN;
+    }
+    else if(stat_st.st_size > 0)
+    {
+        size_u = (size_t)stat_st.st_size;
+        /* a private mapping, the line feeds of the restored lines are replaced by
+         * nul terminators and only these pages are copied */
+        map_pc = mmap(NULL, size_u, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      hist_x->fd_i, 0);
+        if(map_pc == MAP_FAILED)
+        {
+            exeResult_st = wserr_ERR_GEN;
+        }
+        else
+        {
+            /* a line which is still written by another process is left out */
+            end_u = size_u;
+            while((end_u > 0) && (map_pc[end_u - 1] != '\n'))
+                end_u--;
+
+            /* walk backwards over the lines which fit into the editor history */
+            pos_u = end_u;
+            while((pos_u > 0) && (count_u < EMBEDDED_CLI_HISTORY_MAX) &&
+                  (bytes_u < sizeof(cli_pst->history)))
+            {
+                start_u = pos_u - 1;
+                while((start_u > 0) && (map_pc[start_u - 1] != '\n'))
+                    start_u--;
+                len_u = pos_u - 1 - start_u;
+                if((len_u > 0) && (len_u < cli_pst->buffer_size))
+                {
+                    count_u++;
+                    bytes_u += len_u + 1;
+                }
+                pos_u = start_u;
+            }
+
+            /* and add them oldest first */
+            while(pos_u < end_u)
+            {
+                start_u = pos_u;
+                while(map_pc[pos_u] != '\n')
+                    pos_u++;
+                map_pc[pos_u] = '\0';
+                pos_u++;
+                embedded_cli_add_history(cli_pst, &map_pc[start_u]);
+            }
+
+            (void)munmap(map_pc, size_u);
+        }
+    }
+
+    (void)flock(hist_x->fd_i, LOCK_UN);
+    (void)pthread_mutex_unlock(&hist_x->lock_st);
+
+    return(exeResult_st);
+#else
+    if((hist_x == NULL) || (cli_pst == NULL))
+        return wserr_ERR_PARAM;
+
+    return(wserr_OK);
+#endif
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Opens the history file by its path, an already open file is closed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x      history object
+ * @return  true on success
+*//*------------------------------------------------------------------------------------*/
+static bool OpenFile_bol(wshist_tp hist_x)
+{
+    struct stat stat_st;
+    int fd_i;
+
+    fd_i = open(hist_x->path_pc, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0600);
+    if(fd_i < 0)
+        return false;
+
+    if(fstat(fd_i, &stat_st) != 0)
+    {
+        (void)close(fd_i);
+        return false;
+    }
+
+    if(hist_x->fd_i >= 0)
+        (void)close(hist_x->fd_i);
+    hist_x->fd_i = fd_i;
+    hist_x->dev_x = stat_st.st_dev;
+    hist_x->ino_x = stat_st.st_ino;
+
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Locks the history file, if the file was replaced by the compaction of
+ *              another process it is opened again
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x          history object
+ * @param   operation_i     LOCK_SH or LOCK_EX
+ * @return  true if the current file is open and locked
+*//*------------------------------------------------------------------------------------*/
+static bool LockCurrent_bol(wshist_tp hist_x, int operation_i)
+{
+    struct stat stat_st;
+    int result_i;
+
+    for(;;)
+    {
+        do
+        {
+            result_i = flock(hist_x->fd_i, operation_i);
+        } while((result_i != 0) && (errno == EINTR));
+
+        if(result_i != 0)
+            return false;
+
+        if((stat(hist_x->path_pc, &stat_st) == 0) &&
+           (stat_st.st_dev == hist_x->dev_x) && (stat_st.st_ino == hist_x->ino_x))
+            return true;
+
+        (void)flock(hist_x->fd_i, LOCK_UN);
+        if(!OpenFile_bol(hist_x))
+            return false;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Replaces a history file above the size limit by its newest lines, at most
+ *              half of the limit is kept
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x      history object
+*//*------------------------------------------------------------------------------------*/
+static void Compact_vd(wshist_tp hist_x)
+{
+    struct stat stat_st;
+    const char *map_cpc;
+    const char *cut_cpc;
+    char *tmpPath_pc;
+    size_t size_u;
+    size_t keep_u;
+    bool written_bol;
+    bool renamed_bol = false;
+    int tmpFd_i;
+
+    if(!LockCurrent_bol(hist_x, LOCK_EX))
+        return;
+
+    /* another process may have compacted the file before the lock was granted */
+    if((fstat(hist_x->fd_i, &stat_st) != 0) ||
+       ((size_t)stat_st.st_size <= hist_x->maxBytes_u))
+    {
+        (void)flock(hist_x->fd_i, LOCK_UN);
+        return;
+    }
+
+    size_u = (size_t)stat_st.st_size;
+    tmpPath_pc = malloc(strlen(hist_x->path_pc) + sizeof(TMP_SUFFIX));
+    map_cpc = mmap(NULL, size_u, PROT_READ, MAP_SHARED, hist_x->fd_i, 0);
+    if((tmpPath_pc != NULL) && (map_cpc != MAP_FAILED))
+    {
+        strcpy(tmpPath_pc, hist_x->path_pc);
+        strcat(tmpPath_pc, TMP_SUFFIX);
+
+        /* keep the newest half, starting with a complete line */
+        cut_cpc = memchr(&map_cpc[size_u - hist_x->maxBytes_u / 2], '\n',
+                         hist_x->maxBytes_u / 2);
+        keep_u = (cut_cpc != NULL) ? (size_t)(&map_cpc[size_u] - cut_cpc - 1) : 0;
+
+        tmpFd_i = open(tmpPath_pc, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+        if(tmpFd_i >= 0)
+        {
+            written_bol = ((keep_u == 0) || WriteAll_bol(tmpFd_i, cut_cpc + 1, keep_u)) &&
+                          (fsync(tmpFd_i) == 0);
+            if((close(tmpFd_i) == 0) && written_bol)
+            {
+                renamed_bol = (rename(tmpPath_pc, hist_x->path_pc) == 0);
+            }
+
+            if(!renamed_bol)
+                (void)unlink(tmpPath_pc);
+        }
+    }
+
+    if(map_cpc != MAP_FAILED)
+        (void)munmap((void *)map_cpc, size_u);
+    free(tmpPath_pc);
+
+    /* writers waiting for the lock of the old file find it replaced */
+    (void)flock(hist_x->fd_i, LOCK_UN);
+    if(renamed_bol)
+        (void)OpenFile_bol(hist_x);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Writes the collected lines to the history file with one call, so lines of
+ *              other writers of the file are never interleaved. The lines are
+ *              dropped if the file cannot be written.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x      history object, lock_st is held
+ * @return  true if nothing was pending or all lines were written
+*//*------------------------------------------------------------------------------------*/
+static bool WritePending_bol(wshist_tp hist_x)
+{
+    bool written_bol = false;
+
+    if(hist_x->pendingLen_u == 0)
+        return true;
+
+    if(LockCurrent_bol(hist_x, LOCK_SH))
+    {
+        written_bol = WriteAll_bol(hist_x->fd_i, hist_x->pending_ca, hist_x->pendingLen_u);
+        (void)flock(hist_x->fd_i, LOCK_UN);
+    }
+
+    if(written_bol)
+        hist_x->fileSize_u += hist_x->pendingLen_u;
+    hist_x->pendingLen_u = 0;
+
+    return(written_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Writes a complete buffer to a file descriptor
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   fd_i        destination file descriptor
+ * @param   data_cpc    data to write
+ * @param   len_u       number of bytes to write
+ * @return  true if all bytes were written
+*//*------------------------------------------------------------------------------------*/
+static bool WriteAll_bol(int fd_i, const char *data_cpc, size_t len_u)
+{
+    ssize_t written_i;
+
+    while(len_u > 0)
+    {
+        written_i = write(fd_i, data_cpc, len_u);
+        if(written_i < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            return false;
+        }
+        data_cpc += written_i;
+        len_u -= (size_t)written_i;
+    }
+
+    return true;
+}
@@ -0,0 +1,216 @@
+/*****************************************************************************************
+* FILENAME :        wshist.h
+*
+* DESCRIPTION :
+*       Header file for the persistent command history of the console. The entered
+*       lines are appended to a history file, at start up the newest lines are
+*       restored from the mapped file without parsing the whole file.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wserr_LOG(wshist_InitParameter_t(&histConfig_sts));
+*   histConfig_sts.path_cpc = "/home/user/.arg3cli_history";
+*
+*   hist_xs = wshist_AllocateHistory_t(&histConfig_sts);
+*   consoleConfig_sts.history_x = hist_xs;
+*
+*   wserr_LOG(wshist_Append_t(hist_xs, "add 1 2"));
+*   wserr_LOG(wshist_Flush_t(hist_xs));
+*
+*   wserr_LOG(wshist_FreeHistory_t(hist_xs));
+*
+*   The file holds one line per entry and is only appended to. If it grows above
+*   maxBytes_u, the newest half is copied to a new file which replaces the old one.
+*   One history object may be shared by many consoles, e.g. the sessions of a
+*   console server, and processes using the same file see the lines of each other
+*   after a restart.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSHIST_H
+#define WSHIST_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSHIST_MAX_BYTES
+/**
+ * Default size limit of the history file in bytes
+ */
+#define WSHIST_MAX_BYTES (1024 * 1024)
+#endif
+
+#ifndef WSHIST_MIN_BYTES
+/**
+ * Smallest accepted size limit of the history file in bytes
+ */
+#define WSHIST_MIN_BYTES 4096
+#endif
+
+#ifndef WSHIST_PENDING_LEN
+/**
+ * Size of the buffer collecting the appended lines until wshist_Flush_t writes
+ * them, a full buffer is written by wshist_Append_t
+ */
+#define WSHIST_PENDING_LEN 4096
+#endif
+
+#ifndef WSHIST_LAST_LEN
+/**
+ * Size of the copy of the last appended line, a repeat of a longer line is
+ * written again
+ */
+#define WSHIST_LAST_LEN 256
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+struct embedded_cli;
+
+/**
+ * @brief Opaque history object
+ */
+typedef struct wshist_tag *wshist_tp;
+
+/**
+ * @brief Parameters of the history
+ */
+typedef struct wshist_config_tag
+{
+    /**
+     * Path of the history file, it is created if it does not exist
+     */
+    const char *path_cpc;
+    /**
+     * Size limit of the history file in bytes, the file is compacted to half of
+     * the limit when it is exceeded
+     */
+    size_t maxBytes_u;
+} wshist_config_t;
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   initializes the configuration with default values
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   config_stp    configuration to initialize
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if config_stp is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wshist_InitParameter_t(wshist_config_t *config_stp);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   opens or creates the history file, a file above the size limit is compacted
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   config_stp    configuration of the history, the path is copied
+ * @return
+ *          - allocated history object
+ *          - NULL if the configuration is invalid, out of memory or the file cannot
+ *            be opened
+*//*------------------------------------------------------------------------------------*/
+extern wshist_tp wshist_AllocateHistory_t(const wshist_config_t *config_stp);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   writes the collected lines, closes the history file and releases the
+ *              history object
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x        history object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if hist_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wshist_FreeHistory_t(wshist_tp hist_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   appends one line to the history, empty lines and a repeat of the last
+ *              appended line are skipped, the call is thread safe. The line is
+ *              collected in the history object and written by wshist_Flush_t, the
+ *              file is only written here if the collected lines fill the buffer.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x        history object
+ * @param   line_cpc      nul terminated line without line feed
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid or the line holds a line feed
+ *          - wserr_ERR_GEN if the file could not be written
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wshist_Append_t(wshist_tp hist_x, const char *line_cpc);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   writes the collected lines to the history file and compacts the file if it
+ *              exceeds the size limit, to be called when the console is idle, e.g.
+ *              before waiting for input. Returns at once if nothing is to be done.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x        history object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if hist_x is NULL
+ *          - wserr_ERR_GEN if the file could not be written, the lines are dropped
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wshist_Flush_t(wshist_tp hist_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   restores the newest lines of the history file into the line editor, only
+ *              as many lines as the editor history holds are read from the end of the
+ *              mapped file
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   hist_x        history object
+ * @param   cli_pst       line editor to fill
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_GEN if the file could not be mapped
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wshist_Load_t(wshist_tp hist_x, struct embedded_cli *cli_pst);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSHIST_H
@@ -0,0 +1,467 @@
+/****************************************************************************************
+* FILENAME :        wsloop.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the event loop of the console
+*
+* DETAILED DESCRIPTION :
+*   Registered descriptors are stored in a fixed slot table. The epoll backend keeps
+*   the slot index in the event data, the poll() backend keeps a pollfd array parallel
+*   to the slot table where unused entries carry the descriptor -1, which poll()
+*   ignores. Slots removed while the ready list is processed are released at the end
+*   of wsloop_Poll_t, so a pending event never reaches a reused slot.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#include "wsloop.h"
+
+#include "wserr.h"
+#include "wsconsole.h"
+
+#if defined(__linux__) && !defined(WSLOOP_USE_POLL)
+#define WSLOOP_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+typedef enum slotState_tag
+{
+    SLOT_FREE = 0,
+    SLOT_USED,
+    SLOT_REMOVED
+}slotState_t;
+
+/**
+ * @brief Registered descriptor
+ */
+typedef struct slot_tag
+{
+    slotState_t state_en;
+    int fd_i;
+    wsloop_callBack_t func_fp;
+    void *data_pv;
+    /**
+     * console of the descriptor and its close notification, NULL for plain descriptors
+     */
+    wsconsole_tp console_x;
+    wsloop_callBack_t closeFunc_fp;
+    void *closeData_pv;
+}slot_t;
+
+/**
+ * @brief Event loop object
+ */
+typedef struct wsloop_objectTag
+{
+    slot_t *slots_pst;
+    size_t maxFds_u;
+    size_t count_u;
+    /**
+     * ready list is processed, removed slots are released afterwards
+     */
+    bool dispatching_bol;
+#ifdef WSLOOP_EPOLL
+    int epollFd_i;
+#else
+    struct pollfd *pollFds_pst;
+    /**
+     * highest used slot index + 1
+     */
+    size_t top_u;
+#endif
+}wsloop_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static wserr_t Attach_t(wsloop_tp loop_x, size_t slot_u);
+static void Detach_vd(wsloop_tp loop_x, size_t slot_u);
+static void ReleaseSlots_vd(wsloop_tp loop_x);
+static void Dispatch_vd(wsloop_tp loop_x, size_t slot_u);
+static void ConsoleReady_vd(wsloop_tp loop_x, int fd_i, void *data_pv);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates an event loop
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wsloop_tp wsloop_AllocateLoop_t(size_t maxFds_u)
+{
+    wsloop_tp loop_x;
+
+    if(maxFds_u == 0)
+        return NULL;
+
+    loop_x = calloc(1, sizeof(wsloop_t));
+    if(loop_x == NULL)
+        return NULL;
+
+    loop_x->maxFds_u = maxFds_u;
+    loop_x->slots_pst = calloc(maxFds_u, sizeof(slot_t));
+#ifdef WSLOOP_EPOLL
+    loop_x->epollFd_i = epoll_create1(EPOLL_CLOEXEC);
+    if((loop_x->slots_pst == NULL) || (loop_x->epollFd_i < 0))
+    {
+        if(loop_x->epollFd_i >= 0)
+            (void)close(loop_x->epollFd_i);
+        free(loop_x->slots_pst);
+        free(loop_x);
+        return NULL;
+    }
+#else
+    loop_x->pollFds_pst = calloc(maxFds_u, sizeof(struct pollfd));
+    if((loop_x->slots_pst == NULL) || (loop_x->pollFds_pst == NULL))
+    {
+        free(loop_x->pollFds_pst);
+        free(loop_x->slots_pst);
+        free(loop_x);
+        return NULL;
+    }
+    for(size_t idx_u = 0; idx_u < maxFds_u; idx_u++)
+    {
+        loop_x->pollFds_pst[idx_u].fd = -1;
+    }
+#endif
+
+    return(loop_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Frees the event loop
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsloop_FreeLoop_t(wsloop_tp loop_x)
+{
+    if(loop_x == NULL)
+        return wserr_ERR_PARAM;
+
+#ifdef WSLOOP_EPOLL
+    (void)close(loop_x->epollFd_i);
+#else
+    free(loop_x->pollFds_pst);
+#endif
+    free(loop_x->slots_pst);
+    free(loop_x);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Registers a descriptor
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsloop_AddFd_t(wsloop_tp loop_x, int fd_i, wsloop_callBack_t func_fp,
+                        void *data_pv)
+{
+    size_t slot_u;
+    wserr_t exeResult_st;
+
+    if((loop_x == NULL) || (fd_i < 0) || (func_fp == NULL))
+        return wserr_ERR_PARAM;
+
+    for(slot_u = 0; slot_u < loop_x->maxFds_u; slot_u++)
+    {
+        if(loop_x->slots_pst[slot_u].state_en == SLOT_FREE)
+            break;
+    }
+    if(slot_u == loop_x->maxFds_u)
+        return wserr_ERR_NO_MEM;
+
+    memset(&loop_x->slots_pst[slot_u], 0, sizeof(slot_t));
+    loop_x->slots_pst[slot_u].fd_i = fd_i;
+    loop_x->slots_pst[slot_u].func_fp = func_fp;
+    loop_x->slots_pst[slot_u].data_pv = data_pv;
+
+    exeResult_st = Attach_t(loop_x, slot_u);
+    if(wserr_OK == exeResult_st)
+    {
+        loop_x->slots_pst[slot_u].state_en = SLOT_USED;
+        loop_x->count_u++;
+    }
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Removes a descriptor from the loop
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsloop_RemoveFd_t(wsloop_tp loop_x, int fd_i)
+{
+    size_t slot_u;
+
+    if(loop_x == NULL)
+        return wserr_ERR_PARAM;
+
+    for(slot_u = 0; slot_u < loop_x->maxFds_u; slot_u++)
+    {
+        if((loop_x->slots_pst[slot_u].state_en == SLOT_USED)
+            && (loop_x->slots_pst[slot_u].fd_i == fd_i))
+        {
+            Detach_vd(loop_x, slot_u);
+            loop_x->slots_pst[slot_u].state_en =
+                loop_x->dispatching_bol ? SLOT_REMOVED : SLOT_FREE;
+            loop_x->count_u--;
+            return(wserr_OK);
+        }
+    }
+
+    return(wserr_ERR_PARAM);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Registers the input channel of a console
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsloop_AddConsole_t(wsloop_tp loop_x, wsconsole_tp console_x,
+                            wsloop_callBack_t closeFunc_fp, void *data_pv)
+{
+    int fd_i = wsconsole_GetInputFd_i(console_x);
+    wserr_t exeResult_st;
+    size_t slot_u;
+
+    if((loop_x == NULL) || (fd_i < 0))
+        return wserr_ERR_PARAM;
+
+    exeResult_st = wsloop_AddFd_t(loop_x, fd_i, ConsoleReady_vd, NULL);
+    if(wserr_OK == exeResult_st)
+    {
+        for(slot_u = 0; slot_u < loop_x->maxFds_u; slot_u++)
+        {
+            if((loop_x->slots_pst[slot_u].state_en == SLOT_USED)
+                && (loop_x->slots_pst[slot_u].fd_i == fd_i))
+            {
+                loop_x->slots_pst[slot_u].data_pv = &loop_x->slots_pst[slot_u];
+                loop_x->slots_pst[slot_u].console_x = console_x;
+                loop_x->slots_pst[slot_u].closeFunc_fp = closeFunc_fp;
+                loop_x->slots_pst[slot_u].closeData_pv = data_pv;
+                break;
+            }
+        }
+    }
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Waits for readable descriptors and calls their callbacks
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsloop_Poll_t(wsloop_tp loop_x, int timeoutMs_i)
+{
+    int ready_i;
+    int idx_i;
+
+    if(loop_x == NULL)
+        return wserr_ERR_PARAM;
+
+#ifdef WSLOOP_EPOLL
+    struct epoll_event events_sta[WSLOOP_MAX_EVENTS];
+
+    ready_i = epoll_wait(loop_x->epollFd_i, events_sta, WSLOOP_MAX_EVENTS, timeoutMs_i);
+#else
+    ready_i = poll(loop_x->pollFds_pst, (nfds_t)loop_x->top_u, timeoutMs_i);
+#endif
+    if(ready_i < 0)
+        return (errno == EINTR) ? wserr_OK : wserr_ERR_GEN;
+
+    loop_x->dispatching_bol = true;
+#ifdef WSLOOP_EPOLL
+    for(idx_i = 0; idx_i < ready_i; idx_i++)
+    {
+        Dispatch_vd(loop_x, (size_t)events_sta[idx_i].data.u32);
+    }
+#else
+    for(idx_i = 0; (ready_i > 0) && ((size_t)idx_i < loop_x->top_u); idx_i++)
+    {
+        if(loop_x->pollFds_pst[idx_i].revents != 0)
+        {
+            loop_x->pollFds_pst[idx_i].revents = 0;
+            ready_i--;
+            Dispatch_vd(loop_x, (size_t)idx_i);
+        }
+    }
+#endif
+    loop_x->dispatching_bol = false;
+    ReleaseSlots_vd(loop_x);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the number of registered descriptors
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wsloop_GetCount_u(wsloop_tp loop_x)
+{
+    if(loop_x == NULL)
+        return 0;
+
+    return(loop_x->count_u);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Registers the descriptor of a slot with the backend
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      loop object
+ * @param   slot_u      slot index
+ * @return  wserr_OK on success, wserr_ERR_GEN if the backend rejects the descriptor
+*//*------------------------------------------------------------------------------------*/
+static wserr_t Attach_t(wsloop_tp loop_x, size_t slot_u)
+{
+#ifdef WSLOOP_EPOLL
+    struct epoll_event event_st;
+
+    memset(&event_st, 0, sizeof(event_st));
+    event_st.events = EPOLLIN;
+    event_st.data.u32 = (uint32_t)slot_u;
+    if(epoll_ctl(loop_x->epollFd_i, EPOLL_CTL_ADD, loop_x->slots_pst[slot_u].fd_i,
+                    &event_st) != 0)
+        return wserr_ERR_GEN;
+#else
+    loop_x->pollFds_pst[slot_u].fd = loop_x->slots_pst[slot_u].fd_i;
+    loop_x->pollFds_pst[slot_u].events = POLLIN;
+    loop_x->pollFds_pst[slot_u].revents = 0;
+    if(slot_u >= loop_x->top_u)
+        loop_x->top_u = slot_u + 1;
+#endif
+
+    return(wserr_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Removes the descriptor of a slot from the backend
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      loop object
+ * @param   slot_u      slot index
+*//*------------------------------------------------------------------------------------*/
+static void Detach_vd(wsloop_tp loop_x, size_t slot_u)
+{
+#ifdef WSLOOP_EPOLL
+    (void)epoll_ctl(loop_x->epollFd_i, EPOLL_CTL_DEL, loop_x->slots_pst[slot_u].fd_i,
+                    NULL);
+#else
+    loop_x->pollFds_pst[slot_u].fd = -1;
+    loop_x->pollFds_pst[slot_u].revents = 0;
+    while((loop_x->top_u > 0) && (loop_x->pollFds_pst[loop_x->top_u - 1].fd < 0))
+    {
+        loop_x->top_u--;
+    }
+#endif
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Releases the slots removed while the ready list was processed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      loop object
+*//*------------------------------------------------------------------------------------*/
+static void ReleaseSlots_vd(wsloop_tp loop_x)
+{
+    size_t slot_u;
+
+    for(slot_u = 0; slot_u < loop_x->maxFds_u; slot_u++)
+    {
+        if(loop_x->slots_pst[slot_u].state_en == SLOT_REMOVED)
+            loop_x->slots_pst[slot_u].state_en = SLOT_FREE;
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Calls the callback of a ready slot if it is still registered
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      loop object
+ * @param   slot_u      slot index
+*//*------------------------------------------------------------------------------------*/
+static void Dispatch_vd(wsloop_tp loop_x, size_t slot_u)
+{
+    slot_t *slot_pst;
+
+    if(slot_u >= loop_x->maxFds_u)
+        return;
+
+    slot_pst = &loop_x->slots_pst[slot_u];
+    if(slot_pst->state_en == SLOT_USED)
+        slot_pst->func_fp(loop_x, slot_pst->fd_i, slot_pst->data_pv);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Advances a readable console, closes it at the end of its input
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      loop object
+ * @param   fd_i        input channel of the console
+ * @param   data_pv     slot of the console
+*//*------------------------------------------------------------------------------------*/
+static void ConsoleReady_vd(wsloop_tp loop_x, int fd_i, void *data_pv)
+{
+    slot_t *slot_pst = data_pv;
+    wsloop_callBack_t closeFunc_fp;
+    void *closeData_pv;
+
+    if(wserr_ERR_GEN != wsconsole_Step_t(slot_pst->console_x))
+        return;
+
+    closeFunc_fp = slot_pst->closeFunc_fp;
+    closeData_pv = slot_pst->closeData_pv;
+    (void)wsloop_RemoveFd_t(loop_x, fd_i);
+    if(closeFunc_fp != NULL)
+        closeFunc_fp(loop_x, fd_i, closeData_pv);
+}
@@ -0,0 +1,186 @@
+/*****************************************************************************************
+* FILENAME :        wsloop.h
+*
+* DESCRIPTION :
+*       Header file for the event loop of the console. Many consoles and other file
+*       descriptors are served by one thread, every readable console is advanced with
+*       wsconsole_Step_t instead of blocking one thread per console in wsconsole_Run_t.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   consoleConfig_sts.inFd_i = connectionFd_i;     // non-blocking descriptor
+*   consoleConfig_sts.outFd_i = connectionFd_i;
+*   wserr_LOG(wsconsole_Init_t(console_xs, &consoleConfig_sts));
+*
+*   loop_xs = wsloop_AllocateLoop_t(WSLOOP_MAX_FDS);
+*   wserr_LOG(wsloop_AddConsole_t(loop_xs, console_xs, ConsoleClosed_vd, NULL));
+*
+*   while(true)
+*   {
+*       wserr_LOG(wsloop_Poll_t(loop_xs, -1));
+*   }
+*
+*   wserr_LOG(wsloop_FreeLoop_t(loop_xs));
+*
+*   The loop uses epoll on Linux and poll() on other POSIX systems, the poll() backend
+*   can be forced with WSLOOP_USE_POLL. The loop object is not thread safe, all
+*   functions have to be called from the loop thread.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSLOOP_H
+#define WSLOOP_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+#include "wsconsole.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSLOOP_MAX_EVENTS
+/**
+ * Number of ready descriptors handled with one wsloop_Poll_t call
+ */
+#define WSLOOP_MAX_EVENTS 64
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+typedef struct wsloop_objectTag *wsloop_tp;
+
+/**
+ * Callback of a registered descriptor, called from wsloop_Poll_t
+ */
+typedef void (*wsloop_callBack_t)(wsloop_tp loop_x, int fd_i, void *data_pv);
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   allocates an event loop for up to maxFds_u descriptors
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   maxFds_u      maximum number of registered descriptors
+ * @return  loop object, NULL if out of memory or maxFds_u is 0
+*//*------------------------------------------------------------------------------------*/
+extern wsloop_tp wsloop_AllocateLoop_t(size_t maxFds_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   frees the event loop, registered consoles are not closed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if loop_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsloop_FreeLoop_t(wsloop_tp loop_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   registers a descriptor, the callback is called every time it is readable
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @param   fd_i          descriptor, should be non-blocking
+ * @param   func_fp       called when the descriptor is readable or closed by the peer
+ * @param   data_pv       user data passed to func_fp
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_NO_MEM if maxFds_u descriptors are already registered
+ *          - wserr_ERR_GEN if the descriptor is rejected by the system
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsloop_AddFd_t(wsloop_tp loop_x, int fd_i, wsloop_callBack_t func_fp,
+                                void *data_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   removes a descriptor from the loop, may be called from a callback
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @param   fd_i          registered descriptor
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if loop_x is NULL or fd_i is not registered
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsloop_RemoveFd_t(wsloop_tp loop_x, int fd_i);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   registers the input channel inFd_i of a console, the console is advanced with
+ *              wsconsole_Step_t when input is available. At the end of the input the
+ *              console is removed from the loop and closeFunc_fp is called, it may
+ *              deinit and free the console.
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @param   console_x     initialized console with a non-blocking inFd_i
+ * @param   closeFunc_fp  called at the end of the input, may be NULL
+ * @param   data_pv       user data passed to closeFunc_fp
+ * @return  see wsloop_AddFd_t
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsloop_AddConsole_t(wsloop_tp loop_x, wsconsole_tp console_x,
+                                    wsloop_callBack_t closeFunc_fp, void *data_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   waits for readable descriptors and calls their callbacks
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @param   timeoutMs_i   maximum waiting time in milliseconds, -1 waits without limit
+ *                          and 0 returns immediately
+ * @return
+ *          - wserr_OK on success, also on timeout or interruption by a signal
+ *          - wserr_ERR_PARAM if loop_x is NULL
+ *          - wserr_ERR_GEN if waiting failed
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsloop_Poll_t(wsloop_tp loop_x, int timeoutMs_i);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the number of registered descriptors
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x        loop object
+ * @return  number of registered descriptors, 0 if loop_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern size_t wsloop_GetCount_u(wsloop_tp loop_x);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSLOOP_H
@@ -0,0 +1,396 @@
+/****************************************************************************************
+* FILENAME :        wspool.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the work stealing thread pool of the console
+*
+* DETAILED DESCRIPTION :
+*   Every worker owns a ring of tasks with its own lock. A worker takes the oldest
+*   task of its own ring and steals the newest task of another ring when its own
+*   ring is empty, so the owner and the thief rarely meet at the same end. The pool
+*   lock only counts the queued and running tasks: a worker reserves a task in the
+*   counter before it looks for one, therefore a reserved task is always found in
+*   one of the rings.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "wspool.h"
+
+#include "wserr.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Queued task
+ */
+typedef struct task_tag
+{
+    wspool_task_t func_fp;
+    void *data_pv;
+}task_t;
+
+/**
+ * @brief Task ring of one worker
+ */
+typedef struct worker_tag
+{
+    pthread_t thread_st;
+    struct wspool_tag *pool_pst;
+    size_t index_u;
+    /**
+     * ring of tasks, head_u is the oldest task, protected by lock_st
+     */
+    pthread_mutex_t lock_st;
+    task_t *tasks_pst;
+    size_t size_u;
+    size_t head_u;
+    size_t count_u;
+}worker_t;
+
+/**
+ * @brief Pool object implementation
+ */
+typedef struct wspool_tag
+{
+    worker_t *workers_pst;
+    size_t workers_u;
+    /**
+     * worker which gets the next submitted task
+     */
+    size_t nextWorker_u;
+    /**
+     * queued and running tasks, protected by lock_st
+     */
+    pthread_mutex_t lock_st;
+    pthread_cond_t workCond_st;
+    pthread_cond_t idleCond_st;
+    size_t queued_u;
+    size_t running_u;
+    bool quit_bol;
+}wspool_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static bool PushTask_bol(worker_t *worker_pst, const task_t *task_pst);
+static bool TakeTask_bol(worker_t *worker_pst, bool steal_bol, task_t *task_pst);
+static void *Worker_pv(void *worker_pv);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates a pool and starts its worker threads
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wspool_tp wspool_AllocatePool_t(size_t workers_u)
+{
+    wspool_tp pool_x;
+    worker_t *worker_pst;
+    size_t idx_u;
+
+    if((workers_u == 0) || (workers_u > WSPOOL_MAX_WORKERS))
+        return NULL;
+
+    pool_x = calloc(1, sizeof(wspool_t));
+    if(pool_x == NULL)
+        return NULL;
+
+    pool_x->workers_pst = calloc(workers_u, sizeof(worker_t));
+    if(pool_x->workers_pst == NULL)
+    {
+        free(pool_x);
+        return NULL;
+    }
+    (void)pthread_mutex_init(&pool_x->lock_st, NULL);
+    (void)pthread_cond_init(&pool_x->workCond_st, NULL);
+    (void)pthread_cond_init(&pool_x->idleCond_st, NULL);
+
+    for(idx_u = 0; idx_u < workers_u; idx_u++)
+    {
+        worker_pst = &pool_x->workers_pst[idx_u];
+        worker_pst->pool_pst = pool_x;
+        worker_pst->index_u = idx_u;
+        (void)pthread_mutex_init(&worker_pst->lock_st, NULL);
+        worker_pst->tasks_pst = malloc(WSPOOL_QUEUE_INIT_LEN * sizeof(task_t));
+        worker_pst->size_u = WSPOOL_QUEUE_INIT_LEN;
+        if((worker_pst->tasks_pst == NULL)
+            || (pthread_create(&worker_pst->thread_st, NULL, Worker_pv, worker_pst) != 0))
+        {
+            free(worker_pst->tasks_pst);
+            (void)pthread_mutex_destroy(&worker_pst->lock_st);
+            break;
+        }
+        pool_x->workers_u++;
+    }
+
+    if(pool_x->workers_u != workers_u)
+    {
+        (void)wspool_FreePool_t(pool_x);
+        return NULL;
+    }
+
+    return(pool_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Stops the worker threads and releases the pool
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wspool_FreePool_t(wspool_tp pool_x)
+{
+    size_t idx_u;
+
+    if(pool_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)wspool_Wait_t(pool_x);
+
+    (void)pthread_mutex_lock(&pool_x->lock_st);
+    pool_x->quit_bol = true;
+    (void)pthread_cond_broadcast(&pool_x->workCond_st);
+    (void)pthread_mutex_unlock(&pool_x->lock_st);
+
+    for(idx_u = 0; idx_u < pool_x->workers_u; idx_u++)
+    {
+        (void)pthread_join(pool_x->workers_pst[idx_u].thread_st, NULL);
+        (void)pthread_mutex_destroy(&pool_x->workers_pst[idx_u].lock_st);
+        free(pool_x->workers_pst[idx_u].tasks_pst);
+    }
+
+    (void)pthread_cond_destroy(&pool_x->idleCond_st);
+    (void)pthread_cond_destroy(&pool_x->workCond_st);
+    (void)pthread_mutex_destroy(&pool_x->lock_st);
+    free(pool_x->workers_pst);
+    free(pool_x);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Queues a task
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wspool_Submit_t(wspool_tp pool_x, wspool_task_t task_fp, void *data_pv)
+{
+    task_t task_st;
+    worker_t *worker_pst;
+
+    if((pool_x == NULL) || (task_fp == NULL))
+        return wserr_ERR_PARAM;
+
+    task_st.func_fp = task_fp;
+    task_st.data_pv = data_pv;
+
+    /* only the submitting thread uses the turn counter */
+    worker_pst = &pool_x->workers_pst[pool_x->nextWorker_u];
+    pool_x->nextWorker_u = (pool_x->nextWorker_u + 1) % pool_x->workers_u;
+
+    if(!PushTask_bol(worker_pst, &task_st))
+        return wserr_ERR_NO_MEM;
+
+    (void)pthread_mutex_lock(&pool_x->lock_st);
+    pool_x->queued_u++;
+    (void)pthread_cond_signal(&pool_x->workCond_st);
+    (void)pthread_mutex_unlock(&pool_x->lock_st);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Blocks until all submitted tasks are finished
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wspool_Wait_t(wspool_tp pool_x)
+{
+    if(pool_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)pthread_mutex_lock(&pool_x->lock_st);
+    while((pool_x->queued_u > 0) || (pool_x->running_u > 0))
+    {
+        (void)pthread_cond_wait(&pool_x->idleCond_st, &pool_x->lock_st);
+    }
+    (void)pthread_mutex_unlock(&pool_x->lock_st);
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the number of worker threads
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wspool_GetWorkers_u(wspool_tp pool_x)
+{
+    return((pool_x != NULL) ? pool_x->workers_u : 0);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Appends a task to the ring of a worker, the ring is doubled when it is full
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   worker_pst  worker owning the ring
+ * @param   task_pst    task to append
+ * @return  true on success, false if the ring cannot grow
+*//*------------------------------------------------------------------------------------*/
+static bool PushTask_bol(worker_t *worker_pst, const task_t *task_pst)
+{
+    task_t *tasks_pst;
+    size_t idx_u;
+
+    (void)pthread_mutex_lock(&worker_pst->lock_st);
+    if(worker_pst->count_u == worker_pst->size_u)
+    {
+        tasks_pst = malloc(2U * worker_pst->size_u * sizeof(task_t));
+        if(tasks_pst == NULL)
+        {
+            (void)pthread_mutex_unlock(&worker_pst->lock_st);
+            return false;
+        }
+        for(idx_u = 0; idx_u < worker_pst->count_u; idx_u++)
+        {
+            tasks_pst[idx_u] = worker_pst->tasks_pst[(worker_pst->head_u + idx_u) %
+                                                        worker_pst->size_u];
+        }
+        free(worker_pst->tasks_pst);
+        worker_pst->tasks_pst = tasks_pst;
+        worker_pst->size_u *= 2U;
+        worker_pst->head_u = 0;
+    }
+    worker_pst->tasks_pst[(worker_pst->head_u + worker_pst->count_u) % worker_pst->size_u] =
+        *task_pst;
+    worker_pst->count_u++;
+    (void)pthread_mutex_unlock(&worker_pst->lock_st);
+
+    return true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Takes a task from the ring of a worker
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   worker_pst  worker owning the ring
+ * @param   steal_bol   take the newest task for another worker, else the oldest
+ * @param   task_pst    receives the task
+ * @return  true if a task was taken, false if the ring is empty
+*//*------------------------------------------------------------------------------------*/
+static bool TakeTask_bol(worker_t *worker_pst, bool steal_bol, task_t *task_pst)
+{
+    bool taken_bol = false;
+
+    (void)pthread_mutex_lock(&worker_pst->lock_st);
+    if(worker_pst->count_u > 0)
+    {
+        worker_pst->count_u--;
+        if(steal_bol)
+        {
+            *task_pst = worker_pst->tasks_pst[(worker_pst->head_u + worker_pst->count_u) %
+                                                worker_pst->size_u];
+        }
+        else
+        {
+            *task_pst = worker_pst->tasks_pst[worker_pst->head_u];
+            worker_pst->head_u = (worker_pst->head_u + 1) % worker_pst->size_u;
+        }
+        taken_bol = true;
+    }
+    (void)pthread_mutex_unlock(&worker_pst->lock_st);
+
+    return(taken_bol);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Worker thread, reserves a queued task, takes it from its own ring or steals
+ *              it from the other rings and runs it
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   worker_pv   worker object
+ * @return  NULL
+*//*------------------------------------------------------------------------------------*/
+static void *Worker_pv(void *worker_pv)
+{
+    worker_t *worker_pst = worker_pv;
+    wspool_tp pool_x = worker_pst->pool_pst;
+    task_t task_st;
+    size_t idx_u;
+
+    (void)pthread_mutex_lock(&pool_x->lock_st);
+    for(;;)
+    {
+        while((pool_x->queued_u == 0) && !pool_x->quit_bol)
+        {
+            (void)pthread_cond_wait(&pool_x->workCond_st, &pool_x->lock_st);
+        }
+        if(pool_x->queued_u == 0)
+            break;
+
+        pool_x->queued_u--;
+        pool_x->running_u++;
+        (void)pthread_mutex_unlock(&pool_x->lock_st);
+
+        /* the reserved task is in one of the rings, another worker may take the
+         * task seen first, then the search goes on */
+        idx_u = 0;
+        while(!TakeTask_bol(&pool_x->workers_pst[(worker_pst->index_u + idx_u) %
+                                                    pool_x->workers_u],
+                            idx_u != 0, &task_st))
+        {
+            idx_u = (idx_u + 1) % pool_x->workers_u;
+        }
+
+        task_st.func_fp(task_st.data_pv, worker_pst->index_u);
+
+        (void)pthread_mutex_lock(&pool_x->lock_st);
+        pool_x->running_u--;
+        if((pool_x->queued_u == 0) && (pool_x->running_u == 0))
+            (void)pthread_cond_broadcast(&pool_x->idleCond_st);
+    }
+    (void)pthread_mutex_unlock(&pool_x->lock_st);
+
+    return NULL;
+}
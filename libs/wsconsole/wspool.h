@@ -0,0 +1,160 @@
+/*****************************************************************************************
+* FILENAME :        wspool.h
+*
+* DESCRIPTION :
+*       Header file for the work stealing thread pool of the console. Every worker
+*       has its own task queue, a worker without tasks takes tasks from the queues
+*       of the other workers.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   pool_xs = wspool_AllocatePool_t(workers_u);
+*
+*   wserr_LOG(wspool_Submit_t(pool_xs, RunTask_vd, &task_st));
+*   wserr_LOG(wspool_Wait_t(pool_xs));
+*
+*   wserr_LOG(wspool_FreePool_t(pool_xs));
+*
+*   The task function gets the index of the executing worker, so it can use state
+*   which is owned by that worker, e.g. a console per worker.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSPOOL_H
+#define WSPOOL_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSPOOL_MAX_WORKERS
+/**
+ * Maximum number of worker threads of one pool
+ */
+#define WSPOOL_MAX_WORKERS 256
+#endif
+
+#ifndef WSPOOL_QUEUE_INIT_LEN
+/**
+ * Initial number of tasks in the queue of a worker, the queue grows on demand
+ */
+#define WSPOOL_QUEUE_INIT_LEN 64
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/**
+ * @brief Opaque thread pool object
+ */
+typedef struct wspool_tag *wspool_tp;
+
+/**
+ * @brief Task function of the pool
+ * @param data_pv       user data of the task
+ * @param worker_u      index of the executing worker, 0 ... workers - 1
+ * @return none
+ */
+typedef void (*wspool_task_t)(void *data_pv, size_t worker_u);
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   allocates a pool and starts its worker threads
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   workers_u     number of worker threads, 1 ... WSPOOL_MAX_WORKERS
+ * @return
+ *          - allocated pool
+ *          - NULL if the number of workers is invalid or out of memory or threads
+*//*------------------------------------------------------------------------------------*/
+extern wspool_tp wspool_AllocatePool_t(size_t workers_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   waits for all submitted tasks, stops the worker threads and releases the
+ *              pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pool_x        pool object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if pool_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wspool_FreePool_t(wspool_tp pool_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   queues a task, the tasks are spread over the workers in turn
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pool_x        pool object
+ * @param   task_fp       task function
+ * @param   data_pv       user data of the task
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_NO_MEM if the queue cannot grow
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wspool_Submit_t(wspool_tp pool_x, wspool_task_t task_fp, void *data_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   blocks until all submitted tasks are finished
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pool_x        pool object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if pool_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wspool_Wait_t(wspool_tp pool_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the number of worker threads
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pool_x        pool object
+ * @return  number of workers, 0 if pool_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern size_t wspool_GetWorkers_u(wspool_tp pool_x);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSPOOL_H
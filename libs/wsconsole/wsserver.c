@@ -0,0 +1,638 @@
+/****************************************************************************************
+* FILENAME :        wsserver.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the console server
+*
+* DETAILED DESCRIPTION :
+*   The listening socket and all session sockets are registered with one wsloop.
+*   A session is a console reading and writing its non-blocking socket and looking
+*   up the commands in the shared registry. With a worker pool the sessions hand
+*   their commands over to a queue, a session has at most one command in flight,
+*   so the queue never holds more entries than sessions.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+
+#include "wsserver.h"
+
+#include "wserr.h"
+#include "wsconsole.h"
+#include "wsloop.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Default output timeout of a session in milliseconds
+ */
+#define SESSION_OUT_TIMEOUT_MS 1000
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Client connection
+ */
+typedef struct session_tag
+{
+    /**
+     * console of the connection, NULL if the slot is free
+     */
+    wsconsole_tp console_x;
+    int fd_i;
+    struct wsserver_objectTag *server_x;
+}session_t;
+
+/**
+ * @brief Server object implementation
+ */
+typedef struct wsserver_objectTag
+{
+    /**
+     * Configuration of the server
+     */
+    wsserver_config_t config_st;
+    bool initialized_bol;
+    int listenFd_i;
+    /**
+     * Event loop of the listening socket and all sessions
+     */
+    wsloop_tp loop_x;
+    session_t *sessions_pst;
+    size_t sessionCount_u;
+    /**
+     * Worker pool and its queue of consoles with a pending command, protected by
+     * queueLock_st
+     */
+    pthread_t *workers_pst;
+    size_t workerCount_u;
+    pthread_mutex_t queueLock_st;
+    pthread_cond_t queueCond_st;
+    wsconsole_tp *queue_px;
+    size_t queueHead_u;
+    size_t queueLen_u;
+    bool quit_bol;
+}wsserver_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static wserr_t OpenListener_t(wsserver_tp server_x);
+static bool SetNonBlocking_bol(int fd_i);
+static void Accept_vd(wsloop_tp loop_x, int fd_i, void *data_pv);
+static void OpenSession_vd(wsserver_tp server_x, int fd_i);
+static void SessionClosed_vd(wsloop_tp loop_x, int fd_i, void *data_pv);
+static void CloseSession_vd(session_t *session_pst);
+static void Submit_vd(wsconsole_tp console_x, void *data_pv);
+static void *PoolWorker_pv(void *server_pv);
+static void StopPool_vd(wsserver_tp server_x);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Initializes the configuration with default values
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsserver_InitParameter_t(wsserver_config_t *config_stp)
+{
+    if(config_stp == NULL)
+        return wserr_ERR_PARAM;
+
+    config_stp->unixPath_cpc = NULL;
+    config_stp->tcpPort_i = 0;
+    config_stp->maxSessions_u = WSSERVER_MAX_SESSIONS;
+    config_stp->workers_u = 0;
+    config_stp->registry_x = NULL;
+    config_stp->history_x = NULL;
+    config_stp->outTimeoutMs_i = SESSION_OUT_TIMEOUT_MS;
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates a server object
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wsserver_tp wsserver_AllocateServer_t(void)
+{
+    wsserver_tp server_x = calloc(1, sizeof(wsserver_t));
+
+    if(server_x != NULL)
+    {
+        server_x->listenFd_i = -1;
+    }
+
+    return(server_x);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Opens the listening socket and starts the worker pool
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsserver_Init_t(wsserver_tp server_x, wsserver_config_t *config_stp)
+{
+    wserr_t exeResult_st = wserr_OK;
+    size_t idx_u;
+
+    if((server_x == NULL) || (config_stp == NULL) || (config_stp->registry_x == NULL)
+        || (config_stp->maxSessions_u == 0))
+        return wserr_ERR_PARAM;
+
+    if(server_x->initialized_bol)
+        return wserr_ERR_INVALID_STATE;
+
+    memcpy(&server_x->config_st, config_stp, sizeof(wsserver_config_t));
+    server_x->sessionCount_u = 0;
+    server_x->workerCount_u = 0;
+    server_x->queueHead_u = 0;
+    server_x->queueLen_u = 0;
+    server_x->quit_bol = false;
+    (void)pthread_mutex_init(&server_x->queueLock_st, NULL);
+    (void)pthread_cond_init(&server_x->queueCond_st, NULL);
+    server_x->initialized_bol = true;
+
+    /* a client closing its connection must not terminate the process */
+    (void)signal(SIGPIPE, SIG_IGN);
+
+    server_x->sessions_pst = calloc(config_stp->maxSessions_u, sizeof(session_t));
+    server_x->loop_x = wsloop_AllocateLoop_t(config_stp->maxSessions_u + 1U);
+    if((server_x->sessions_pst == NULL) || (server_x->loop_x == NULL))
+        exeResult_st = wserr_ERR_NO_MEM;
+
+    if(wserr_OK == exeResult_st)
+        exeResult_st = OpenListener_t(server_x);
+
+    if(wserr_OK == exeResult_st)
+        exeResult_st = wsloop_AddFd_t(server_x->loop_x, server_x->listenFd_i, Accept_vd,
+                                        server_x);
+
+    /* the pool is started once and waits for the commands of all sessions */
+    if((wserr_OK == exeResult_st) && (config_stp->workers_u > 0))
+    {
+        server_x->queue_px = calloc(config_stp->maxSessions_u, sizeof(wsconsole_tp));
+        server_x->workers_pst = calloc(config_stp->workers_u, sizeof(pthread_t));
+        if((server_x->queue_px == NULL) || (server_x->workers_pst == NULL))
+            exeResult_st = wserr_ERR_NO_MEM;
+
+        for(idx_u = 0; (wserr_OK == exeResult_st) && (idx_u < config_stp->workers_u); idx_u++)
+        {
+            if(pthread_create(&server_x->workers_pst[idx_u], NULL, PoolWorker_pv,
+                                server_x) != 0)
+            {
+                exeResult_st = wserr_ERR_NO_MEM;
+            }
+            else
+            {
+                server_x->workerCount_u++;
+            }
+        }
+    }
+
+    if(wserr_OK != exeResult_st)
+    {
+        (void)wsserver_DeInit_t(server_x);
+    }
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Accepts new connections and serves the readable sessions
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsserver_Poll_t(wsserver_tp server_x, int timeoutMs_i)
+{
+    if(server_x == NULL)
+        return wserr_ERR_PARAM;
+
+    if(!server_x->initialized_bol)
+        return wserr_ERR_INVALID_STATE;
+
+    return(wsloop_Poll_t(server_x->loop_x, timeoutMs_i));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the local TCP port of the server
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int wsserver_GetPort_i(wsserver_tp server_x)
+{
+    struct sockaddr_in addr_st;
+    socklen_t len_st = sizeof(addr_st);
+
+    if((server_x == NULL) || (server_x->listenFd_i < 0)
+        || (server_x->config_st.unixPath_cpc != NULL))
+        return -1;
+
+    if(getsockname(server_x->listenFd_i, (struct sockaddr *)&addr_st, &len_st) != 0)
+        return -1;
+
+    return((int)ntohs(addr_st.sin_port));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the number of open sessions
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wsserver_GetSessionCount_u(wsserver_tp server_x)
+{
+    if(server_x == NULL)
+        return 0;
+
+    return(server_x->sessionCount_u);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Closes all sessions and stops the server
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsserver_DeInit_t(wsserver_tp server_x)
+{
+    size_t idx_u;
+
+    if(server_x == NULL)
+        return wserr_ERR_PARAM;
+
+    if(!server_x->initialized_bol)
+        return wserr_OK;
+
+    /* the sessions wait for their commands, the pool is still running */
+    for(idx_u = 0; (server_x->sessions_pst != NULL)
+                    && (idx_u < server_x->config_st.maxSessions_u); idx_u++)
+    {
+        if(server_x->sessions_pst[idx_u].console_x != NULL)
+        {
+            (void)wsloop_RemoveFd_t(server_x->loop_x, server_x->sessions_pst[idx_u].fd_i);
+            CloseSession_vd(&server_x->sessions_pst[idx_u]);
+        }
+    }
+    StopPool_vd(server_x);
+
+    if(server_x->listenFd_i >= 0)
+    {
+        (void)close(server_x->listenFd_i);
+        server_x->listenFd_i = -1;
+        if(server_x->config_st.unixPath_cpc != NULL)
+            (void)unlink(server_x->config_st.unixPath_cpc);
+    }
+    if(server_x->loop_x != NULL)
+    {
+        (void)wsloop_FreeLoop_t(server_x->loop_x);
+        server_x->loop_x = NULL;
+    }
+    free(server_x->sessions_pst);
+    server_x->sessions_pst = NULL;
+    free(server_x->queue_px);
+    server_x->queue_px = NULL;
+    free(server_x->workers_pst);
+    server_x->workers_pst = NULL;
+    (void)pthread_cond_destroy(&server_x->queueCond_st);
+    (void)pthread_mutex_destroy(&server_x->queueLock_st);
+    server_x->initialized_bol = false;
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Frees the server object
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsserver_FreeServer_t(wsserver_tp server_x)
+{
+    if(server_x == NULL)
+        return wserr_ERR_PARAM;
+
+    (void)wsserver_DeInit_t(server_x);
+    free(server_x);
+
+    return(wserr_OK);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Opens the non-blocking listening socket, Unix domain or localhost TCP
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x    server object
+ * @return  wserr_OK on success, wserr_ERR_PARAM if the path is too long, else
+ *              wserr_ERR_GEN
+*//*------------------------------------------------------------------------------------*/
+static wserr_t OpenListener_t(wsserver_tp server_x)
+{
+    struct sockaddr_un unix_st;
+    struct sockaddr_in inet_st;
+    int fd_i;
+    int on_i = 1;
+    int bound_i;
+
+    if(server_x->config_st.unixPath_cpc != NULL)
+    {
+        memset(&unix_st, 0, sizeof(unix_st));
+        if(strlen(server_x->config_st.unixPath_cpc) >= sizeof(unix_st.sun_path))
+            return wserr_ERR_PARAM;
+
+        unix_st.sun_family = AF_UNIX;
+        strcpy(unix_st.sun_path, server_x->config_st.unixPath_cpc);
+        fd_i = socket(AF_UNIX, SOCK_STREAM, 0);
+        if(fd_i < 0)
+            return wserr_ERR_GEN;
+
+        /* a socket file left by a previous run blocks the bind */
+        (void)unlink(unix_st.sun_path);
+        bound_i = bind(fd_i, (struct sockaddr *)&unix_st, sizeof(unix_st));
+    }
+    else
+    {
+        memset(&inet_st, 0, sizeof(inet_st));
+        inet_st.sin_family = AF_INET;
+        inet_st.sin_port = htons((uint16_t)server_x->config_st.tcpPort_i);
+        inet_st.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd_i = socket(AF_INET, SOCK_STREAM, 0);
+        if(fd_i < 0)
+            return wserr_ERR_GEN;
+
+        (void)setsockopt(fd_i, SOL_SOCKET, SO_REUSEADDR, &on_i, sizeof(on_i));
+        bound_i = bind(fd_i, (struct sockaddr *)&inet_st, sizeof(inet_st));
+    }
+
+    if((bound_i != 0) || (listen(fd_i, SOMAXCONN) != 0) || !SetNonBlocking_bol(fd_i))
+    {
+        (void)close(fd_i);
+        return wserr_ERR_GEN;
+    }
+
+    server_x->listenFd_i = fd_i;
+    return(wserr_OK);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Switches a descriptor to non-blocking mode
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   fd_i        descriptor
+ * @return  true on success
+*//*------------------------------------------------------------------------------------*/
+static bool SetNonBlocking_bol(int fd_i)
+{
+    int flags_i = fcntl(fd_i, F_GETFL, 0);
+
+    return((flags_i >= 0) && (fcntl(fd_i, F_SETFL, flags_i | O_NONBLOCK) == 0));
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Accepts all pending connections of the listening socket
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      event loop
+ * @param   fd_i        listening socket
+ * @param   data_pv     server object
+*//*------------------------------------------------------------------------------------*/
+static void Accept_vd(wsloop_tp loop_x, int fd_i, void *data_pv)
+{
+    int conn_i;
+
+    (void)loop_x;
+    while(true)
+    {
+        conn_i = accept(fd_i, NULL, NULL);
+        if(conn_i < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            break;
+        }
+        OpenSession_vd(data_pv, conn_i);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Creates the console of a new connection, the connection is closed if no
+ *              session is free
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x    server object
+ * @param   fd_i        connected socket
+*//*------------------------------------------------------------------------------------*/
+static void OpenSession_vd(wsserver_tp server_x, int fd_i)
+{
+    wsconsole_config_t config_st;
+    session_t *session_pst = NULL;
+    size_t idx_u;
+
+    for(idx_u = 0; idx_u < server_x->config_st.maxSessions_u; idx_u++)
+    {
+        if(server_x->sessions_pst[idx_u].console_x == NULL)
+        {
+            session_pst = &server_x->sessions_pst[idx_u];
+            break;
+        }
+    }
+
+    if((session_pst == NULL) || !SetNonBlocking_bol(fd_i))
+    {
+        (void)close(fd_i);
+        return;
+    }
+
+    (void)wsconsole_InitParameter_t(&config_st);
+    config_st.inFd_i = fd_i;
+    config_st.outFd_i = fd_i;
+    config_st.outTimeoutMs_i = server_x->config_st.outTimeoutMs_i;
+    config_st.registry_x = server_x->config_st.registry_x;
+    config_st.history_x = server_x->config_st.history_x;
+    if(server_x->workerCount_u > 0)
+    {
+        config_st.submitFunc_fp = Submit_vd;
+        config_st.submitData_pv = server_x;
+    }
+
+    session_pst->console_x = wsconsole_AllocateConsole_t();
+    if(session_pst->console_x == NULL)
+    {
+        (void)close(fd_i);
+        return;
+    }
+    session_pst->fd_i = fd_i;
+    session_pst->server_x = server_x;
+    server_x->sessionCount_u++;
+
+    if((wserr_OK != wsconsole_Init_t(session_pst->console_x, &config_st))
+        || (wserr_OK != wsloop_AddConsole_t(server_x->loop_x, session_pst->console_x,
+                                            SessionClosed_vd, session_pst)))
+    {
+        CloseSession_vd(session_pst);
+        return;
+    }
+
+    /* the prompt tells the client the session is ready */
+    (void)wsconsole_Feed_t(session_pst->console_x, NULL, 0);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Called by the event loop at the end of the input of a session
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   loop_x      event loop
+ * @param   fd_i        connected socket
+ * @param   data_pv     session
+*//*------------------------------------------------------------------------------------*/
+static void SessionClosed_vd(wsloop_tp loop_x, int fd_i, void *data_pv)
+{
+    (void)loop_x;
+    (void)fd_i;
+    CloseSession_vd(data_pv);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Frees the console of a session and closes the connection, waits for a
+ *              running command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   session_pst session
+*//*------------------------------------------------------------------------------------*/
+static void CloseSession_vd(session_t *session_pst)
+{
+    bool open_bol = (session_pst->console_x != NULL);
+
+    if(open_bol)
+    {
+        (void)wsconsole_DeInit_t(session_pst->console_x);
+        (void)wsconsole_FreeConsole_t(session_pst->console_x);
+        session_pst->console_x = NULL;
+    }
+    (void)close(session_pst->fd_i);
+    session_pst->fd_i = -1;
+    if(open_bol)
+        session_pst->server_x->sessionCount_u--;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Queues the pending command of a session for the worker pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x   console with the pending command
+ * @param   data_pv     server object
+*//*------------------------------------------------------------------------------------*/
+static void Submit_vd(wsconsole_tp console_x, void *data_pv)
+{
+    wsserver_tp server_x = data_pv;
+    size_t tail_u;
+
+    (void)pthread_mutex_lock(&server_x->queueLock_st);
+    tail_u = (server_x->queueHead_u + server_x->queueLen_u)
+                % server_x->config_st.maxSessions_u;
+    server_x->queue_px[tail_u] = console_x;
+    server_x->queueLen_u++;
+    (void)pthread_cond_signal(&server_x->queueCond_st);
+    (void)pthread_mutex_unlock(&server_x->queueLock_st);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Thread of the worker pool, executes the queued commands
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_pv   server object
+ * @return  NULL
+*//*------------------------------------------------------------------------------------*/
+static void *PoolWorker_pv(void *server_pv)
+{
+    wsserver_tp server_x = server_pv;
+    wsconsole_tp console_x;
+
+    (void)pthread_mutex_lock(&server_x->queueLock_st);
+    while(!server_x->quit_bol)
+    {
+        if(server_x->queueLen_u == 0)
+        {
+            (void)pthread_cond_wait(&server_x->queueCond_st, &server_x->queueLock_st);
+            continue;
+        }
+
+        console_x = server_x->queue_px[server_x->queueHead_u];
+        server_x->queueHead_u = (server_x->queueHead_u + 1U)
+                                    % server_x->config_st.maxSessions_u;
+        server_x->queueLen_u--;
+        (void)pthread_mutex_unlock(&server_x->queueLock_st);
+
+        (void)wsconsole_ExecutePending_t(console_x);
+
+        (void)pthread_mutex_lock(&server_x->queueLock_st);
+    }
+    (void)pthread_mutex_unlock(&server_x->queueLock_st);
+
+    return(NULL);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Stops and joins the threads of the worker pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x    server object
+*//*------------------------------------------------------------------------------------*/
+static void StopPool_vd(wsserver_tp server_x)
+{
+    size_t idx_u;
+
+    (void)pthread_mutex_lock(&server_x->queueLock_st);
+    server_x->quit_bol = true;
+    (void)pthread_cond_broadcast(&server_x->queueCond_st);
+    (void)pthread_mutex_unlock(&server_x->queueLock_st);
+
+    for(idx_u = 0; idx_u < server_x->workerCount_u; idx_u++)
+    {
+        (void)pthread_join(server_x->workers_pst[idx_u], NULL);
+    }
+    server_x->workerCount_u = 0;
+}
@@ -0,0 +1,227 @@
+/*****************************************************************************************
+* FILENAME :        wsserver.h
+*
+* DESCRIPTION :
+*       Header file for the console server. Clients connect through a Unix domain
+*       socket or a localhost TCP port and every connection gets its own console with
+*       its own line editor and history. The commands are looked up in the registry
+*       of one console shared by all sessions.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wserr_LOG(wsserver_InitParameter_t(&serverConfig_sts));
+*   serverConfig_sts.unixPath_cpc = "/tmp/arg3cli.sock";
+*   serverConfig_sts.registry_x = console_xs;      // console with the commands
+*   serverConfig_sts.workers_u = 4;
+*
+*   server_xs = wsserver_AllocateServer_t();
+*   wserr_LOG(wsserver_Init_t(server_xs, &serverConfig_sts));
+*
+*   while(true)
+*   {
+*       wserr_LOG(wsserver_Poll_t(server_xs, -1));
+*   }
+*
+*   wserr_LOG(wsserver_DeInit_t(server_xs));
+*   wserr_LOG(wsserver_FreeServer_t(server_xs));
+*
+*   All sessions are multiplexed by one wsloop on the thread calling
+*   wsserver_Poll_t. With workers_u > 0 the commands run on a worker pool, else on
+*   the loop thread. The registry must not be changed while the server runs.
+*   SIGPIPE is ignored, a closed connection is reported as write error instead.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSSERVER_H
+#define WSSERVER_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+#include "wsconsole.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSSERVER_MAX_SESSIONS
+/**
+ * Default number of concurrent sessions
+ */
+#define WSSERVER_MAX_SESSIONS 64
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/**
+ * @brief Parameters for server initialization
+ */
+typedef struct wsserver_config_tag
+{
+    /**
+     * Path of the Unix domain socket, a stale socket file is replaced. Set to NULL
+     * to listen on the localhost TCP port instead.
+     */
+    const char *unixPath_cpc;
+    /**
+     * Localhost TCP port, 0 selects a free port, see wsserver_GetPort_i
+     */
+    int tcpPort_i;
+    /**
+     * Maximum number of concurrent sessions, further connections are closed
+     */
+    size_t maxSessions_u;
+    /**
+     * Number of threads of the worker pool, 0 executes the commands on the loop
+     * thread
+     */
+    size_t workers_u;
+    /**
+     * Console with the registered commands, shared by all sessions
+     */
+    wsconsole_tp registry_x;
+    /**
+     * Output timeout of a session in milliseconds, see wsconsole_config_t
+     */
+    int outTimeoutMs_i;
+    /**
+     * Command history shared by all sessions, NULL if the sessions keep their
+     * history in memory only
+     */
+    wshist_tp history_x;
+} wsserver_config_t;
+
+/**
+ * @brief Abstract datatype server object
+ */
+typedef struct wsserver_objectTag *wsserver_tp;
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   initializes the configuration with default values
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   config_stp    configuration to initialize
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if config_stp is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsserver_InitParameter_t(wsserver_config_t *config_stp);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   allocates a server object
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  server object, NULL if out of memory
+*//*------------------------------------------------------------------------------------*/
+extern wsserver_tp wsserver_AllocateServer_t(void);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   opens the listening socket and starts the worker pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @param   config_stp    configuration
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid
+ *          - wserr_ERR_INVALID_STATE if the server is already initialized
+ *          - wserr_ERR_NO_MEM if out of memory or threads
+ *          - wserr_ERR_GEN if the socket could not be opened
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsserver_Init_t(wsserver_tp server_x, wsserver_config_t *config_stp);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   accepts new connections and serves the readable sessions
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @param   timeoutMs_i   maximum waiting time in milliseconds, -1 without limit
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if server_x is NULL
+ *          - wserr_ERR_INVALID_STATE if the server is not initialized
+ *          - wserr_ERR_GEN if waiting failed
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsserver_Poll_t(wsserver_tp server_x, int timeoutMs_i);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the local TCP port of the server
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @return  port number, -1 if the server does not listen on TCP
+*//*------------------------------------------------------------------------------------*/
+extern int wsserver_GetPort_i(wsserver_tp server_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the number of open sessions
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @return  number of sessions, 0 if server_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern size_t wsserver_GetSessionCount_u(wsserver_tp server_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   closes all sessions and the listening socket and stops the worker pool
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if server_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsserver_DeInit_t(wsserver_tp server_x);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   frees the server object, de-initializes it first if needed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   server_x      server object
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if server_x is NULL
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsserver_FreeServer_t(wsserver_tp server_x);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSSERVER_H
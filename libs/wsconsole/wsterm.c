@@ -0,0 +1,321 @@
+/****************************************************************************************
+* FILENAME :        wsterm.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the terminal session layer of the console
+*
+* DETAILED DESCRIPTION :
+*   The terminal is switched to raw mode once when the session is opened and stays
+*   in raw mode until the session is closed. Input is read with one read() call per
+*   block of available bytes instead of one call per character.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <unistd.h>
+#include <termios.h>
+
+#include "wsterm.h"
+
+#include "wserr.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Terminal session object
+ */
+typedef struct termSession_tag
+{
+    /**
+     * file descriptor of the terminal input
+     */
+    int fd_i;
+    /**
+     * session is open
+     */
+    bool open_bol;
+    /**
+     * terminal attributes were changed and need to be restored
+     */
+    volatile sig_atomic_t rawActive_i;
+    /**
+     * terminal attributes before the session was opened
+     */
+    struct termios saved_st;
+    /**
+     * read buffer and its fill state
+     */
+    char buffer_ca[WSTERM_READ_BUF_LEN];
+    size_t head_u;
+    size_t tail_u;
+}termSession_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static void RestoreTerminal_vd(void);
+static void SignalHandler_vd(int signal_i);
+static void InstallSignalHandler_vd(void);
+static bool FillBuffer_bol(void);
+
+/***************************************************************************************/
+/* Local variables: */
+/**
+ * Singleton terminal session, a process has only one controlling terminal
+ */
+static termSession_t term_sx = { .fd_i = -1 };
+
+/**
+ * Signals which terminate the process and need to restore the terminal first
+ */
+static const int termSignals_cai[] = { SIGTERM, SIGHUP, SIGQUIT };
+
+/**
+ * Restore handlers are installed only once per process
+ */
+static bool handlerInstalled_bols = false;
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Opens the terminal session
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsterm_Open_t(int fd_i)
+{
+    wserr_t exeResult_st = wserr_OK;
+    struct termios raw_st;
+
+    if(fd_i < 0)
+        return wserr_ERR_PARAM;
+
+    if(term_sx.open_bol)
+        return wserr_ERR_INVALID_STATE;
+
+    term_sx.fd_i = fd_i;
+    term_sx.head_u = 0;
+    term_sx.tail_u = 0;
+
+    /* Scripted input (pipe or file) has no terminal attributes, only the buffered
+     * reader is used in this case */
+    if(isatty(fd_i) && (tcgetattr(fd_i, &term_sx.saved_st) == 0))
+    {
+        raw_st = term_sx.saved_st;
+
+        /* Do what cfmakeraw does (Using --std=c99 means that cfmakeraw isn't
+        available) */
+        raw_st.c_iflag &=
+            ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
+        /* the output keeps its processing, the terminal stays raw for the whole
+         * session and a "\n" printed by a command to stdout or stderr still
+         * returns to column 0 */
+        raw_st.c_oflag |= OPOST | ONLCR;
+        raw_st.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+        raw_st.c_cflag &= ~(CSIZE | PARENB);
+        raw_st.c_cflag |= CS8;
+
+        raw_st.c_cc[VMIN] = 1;
+        raw_st.c_cc[VTIME] = 0;
+
+        InstallSignalHandler_vd();
+
+        if(tcsetattr(fd_i, TCSANOW, &raw_st) == 0)
+        {
+            term_sx.rawActive_i = 1;
+        }
+        else
+        {
+            exeResult_st = wserr_ERR_GEN;
+        }
+    }
+
+    if(wserr_OK == exeResult_st)
+    {
+        term_sx.open_bol = true;
+    }
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Closes the terminal session
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wsterm_Close_t(void)
+{
+    if(!term_sx.open_bol)
+        return wserr_ERR_INVALID_STATE;
+
+    RestoreTerminal_vd();
+    term_sx.open_bol = false;
+    term_sx.head_u = 0;
+    term_sx.tail_u = 0;
+
+    return(wserr_OK);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Reads a block of bytes from the terminal session
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wsterm_Read_u(char *buf_pc, size_t size_u)
+{
+    size_t avail_u;
+
+    if((buf_pc == NULL) || (size_u == 0) || !FillBuffer_bol())
+        return 0;
+
+    avail_u = term_sx.tail_u - term_sx.head_u;
+    if(avail_u > size_u)
+        avail_u = size_u;
+
+    memcpy(buf_pc, &term_sx.buffer_ca[term_sx.head_u], avail_u);
+    term_sx.head_u += avail_u;
+
+    return(avail_u);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns one character of the terminal session
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+char wsterm_GetCharacter_c(void)
+{
+    if(!FillBuffer_bol())
+        return '\0';
+
+    return(term_sx.buffer_ca[term_sx.head_u++]);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Restores the terminal attributes saved at wsterm_Open_t, this function is
+ *              async signal safe
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void RestoreTerminal_vd(void)
+{
+    if(term_sx.rawActive_i)
+    {
+        term_sx.rawActive_i = 0;
+        (void)tcsetattr(term_sx.fd_i, TCSADRAIN, &term_sx.saved_st);
+    }
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Termination signal handler, restores the terminal and re-raises the signal
+ *              with its default action
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   signal_i    received signal
+*//*------------------------------------------------------------------------------------*/
+static void SignalHandler_vd(int signal_i)
+{
+    RestoreTerminal_vd();
+    (void)signal(signal_i, SIG_DFL);
+    (void)raise(signal_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Installs the restore handlers for process exit and termination signals
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void InstallSignalHandler_vd(void)
+{
+    struct sigaction sa;
+    size_t idx_u;
+
+    if(handlerInstalled_bols)
+        return;
+
+    sa.sa_handler = SignalHandler_vd;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0;
+
+    for(idx_u = 0; idx_u < sizeof(termSignals_cai) / sizeof(termSignals_cai[0]); idx_u++)
+    {
+        (void)sigaction(termSignals_cai[idx_u], &sa, NULL);
+    }
+    (void)atexit(RestoreTerminal_vd);
+
+    handlerInstalled_bols = true;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Makes sure the read buffer holds at least one byte, blocks in read() if
+ *              the buffer is empty
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  true if at least one byte is available, false on end of file or error
+*//*------------------------------------------------------------------------------------*/
+static bool FillBuffer_bol(void)
+{
+    ssize_t read_i;
+
+    if(term_sx.head_u < term_sx.tail_u)
+        return true;
+
+    if(term_sx.fd_i < 0)
+        return false;
+
+    do
+    {
+        read_i = read(term_sx.fd_i, term_sx.buffer_ca, sizeof(term_sx.buffer_ca));
+    } while((read_i < 0) && (errno == EINTR));
+
+    if(read_i <= 0)
+    {
+        if(read_i < 0)
+            perror("read()");
+        term_sx.head_u = 0;
+        term_sx.tail_u = 0;
+        return false;
+    }
+
+    term_sx.head_u = 0;
+    term_sx.tail_u = (size_t)read_i;
+    return true;
+}
@@ -0,0 +1,129 @@
+/*****************************************************************************************
+* FILENAME :        wsterm.h
+*
+* DESCRIPTION :
+*       Header file for the terminal session layer of the console. The terminal is
+*       switched to raw mode once for the lifetime of the session and input is read
+*       block wise into a local buffer.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wserr_LOG(wsterm_Open_t(STDIN_FILENO));
+*
+*   char ch_c = wsterm_GetCharacter_c();
+*
+*   wserr_LOG(wsterm_Close_t());
+*
+*   A process has only one controlling terminal, therefore the session is a module
+*   singleton. The terminal settings are restored on wsterm_Close_t, at process exit
+*   and when one of the termination signals SIGTERM, SIGHUP or SIGQUIT is received.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSTERM_H
+#define WSTERM_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "wserr.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+#ifndef WSTERM_READ_BUF_LEN
+/**
+ * Number of bytes requested from the terminal with one read() call
+ */
+#define WSTERM_READ_BUF_LEN 256
+#endif
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   opens the terminal session, the terminal is switched to raw mode if the
+ *              file descriptor is connected to a terminal. Only the input is raw,
+ *              the output still translates "\n" to "\r\n".
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   fd_i          file descriptor of the terminal input, e.g. STDIN_FILENO
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if the file descriptor is invalid
+ *          - wserr_ERR_INVALID_STATE if the session is already open
+ *          - wserr_ERR_GEN if the terminal attributes could not be changed
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsterm_Open_t(int fd_i);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   closes the terminal session and restores the original terminal settings
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_INVALID_STATE if the session is not open
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wsterm_Close_t(void);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   reads up to size_u bytes from the terminal session, already buffered bytes
+ *              are returned first, else the call blocks until at least one byte is
+ *              available
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   buf_pc        destination buffer
+ * @param   size_u        size of the destination buffer
+ * @return  number of bytes stored in buf_pc, 0 on end of file or error
+*//*------------------------------------------------------------------------------------*/
+extern size_t wsterm_Read_u(char *buf_pc, size_t size_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns one character of the terminal session, served from the read buffer,
+ *              compatible to the wsconsole_getCharacter_t interface
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  one received character, '\0' on end of file or error
+*//*------------------------------------------------------------------------------------*/
+extern char wsterm_GetCharacter_c(void);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSTERM_H
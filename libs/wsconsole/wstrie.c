@@ -0,0 +1,445 @@
+/****************************************************************************************
+* FILENAME :        wstrie.c
+*
+* SHORT DESCRIPTION:
+*   Implementation of the prefix index of the console
+*
+* DETAILED DESCRIPTION :
+*   The nodes are kept in one array and linked by index, a child list is sorted by
+*   character for the ordered iteration. A lookup finds the child for each
+*   character of the key in the edge index, a hash table over parent node and
+*   character which grows with the node array, so it does not scan the child lists.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdlib.h>
+#include <string.h>
+
+#include "wstrie.h"
+
+#include "wserr.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Number of nodes allocated with the first key
+ */
+#define MIN_NODES 32U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static uint32_t FindChild_u32(const wstrie_t *trie_pst, uint32_t node_u32, char ch_c);
+static uint32_t EdgeSlot_u32(uint32_t parent_u32, char ch_c, uint32_t mask_u32);
+static void AddEdge_vd(uint32_t *edges_pu32, uint32_t mask_u32, const wstrie_node_t *nodes_pcst,
+                        uint32_t child_u32);
+static uint32_t Walk_u32(const wstrie_t *trie_pst, const char *key_cpc, size_t len_u);
+static wserr_t Reserve_t(wstrie_t *trie_pst, size_t nodes_u);
+static bool Visit_bol(const wstrie_t *trie_pst, uint32_t node_u32, wstrie_visit_t visit_fp,
+                        void *data_pv);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Initializes an empty index
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wstrie_Init_vd(wstrie_t *trie_pst)
+{
+    trie_pst->nodes_pst = NULL;
+    trie_pst->used_u32 = 0;
+    trie_pst->size_u32 = 0;
+    trie_pst->edges_pu32 = NULL;
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Releases the nodes of the index
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wstrie_Free_vd(wstrie_t *trie_pst)
+{
+    free(trie_pst->nodes_pst);
+    free(trie_pst->edges_pu32);
+    wstrie_Init_vd(trie_pst);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Adds a key
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wstrie_Insert_t(wstrie_t *trie_pst, const char *key_cpc, void *value_pv)
+{
+    wstrie_node_t *node_pst;
+    uint32_t node_u32 = 0;
+    uint32_t child_u32;
+    uint32_t *link_pu32;
+    size_t len_u;
+    size_t idx_u;
+
+    if((trie_pst == NULL) || (key_cpc == NULL) || (key_cpc[0] == '\0') || (value_pv == NULL))
+        return wserr_ERR_PARAM;
+
+    len_u = strlen(key_cpc);
+    if(wstrie_Find_pv(trie_pst, key_cpc, len_u) != NULL)
+        return wserr_ERR_PARAM;
+
+    /* room for the root and a new node per character, nothing can fail later */
+    if(Reserve_t(trie_pst, (size_t)trie_pst->used_u32 + len_u + 1U) != wserr_OK)
+        return wserr_ERR_NO_MEM;
+
+    if(trie_pst->used_u32 == 0)
+    {
+        memset(&trie_pst->nodes_pst[0], 0, sizeof(wstrie_node_t));
+        trie_pst->used_u32 = 1;
+    }
+
+    trie_pst->nodes_pst[0].keys_u32++;
+    for(idx_u = 0; idx_u < len_u; idx_u++)
+    {
+        /* the child list is sorted, stop at the first character not below */
+        link_pu32 = &trie_pst->nodes_pst[node_u32].child_u32;
+        while((*link_pu32 != 0)
+                && ((unsigned char)trie_pst->nodes_pst[*link_pu32].ch_c
+                    < (unsigned char)key_cpc[idx_u]))
+        {
+            link_pu32 = &trie_pst->nodes_pst[*link_pu32].next_u32;
+        }
+
+        child_u32 = *link_pu32;
+        if((child_u32 == 0) || (trie_pst->nodes_pst[child_u32].ch_c != key_cpc[idx_u]))
+        {
+            child_u32 = trie_pst->used_u32++;
+            node_pst = &trie_pst->nodes_pst[child_u32];
+            memset(node_pst, 0, sizeof(wstrie_node_t));
+            node_pst->ch_c = key_cpc[idx_u];
+            node_pst->parent_u32 = node_u32;
+            node_pst->next_u32 = *link_pu32;
+            *link_pu32 = child_u32;
+            AddEdge_vd(trie_pst->edges_pu32, 2U * trie_pst->size_u32 - 1U,
+                        trie_pst->nodes_pst, child_u32);
+        }
+
+        trie_pst->nodes_pst[child_u32].keys_u32++;
+        node_u32 = child_u32;
+    }
+    trie_pst->nodes_pst[node_u32].value_pv = value_pv;
+
+    return wserr_OK;
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Makes room for keys of the given total length
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+wserr_t wstrie_Reserve_t(wstrie_t *trie_pst, size_t chars_u)
+{
+    if(trie_pst == NULL)
+        return wserr_ERR_PARAM;
+
+    if(chars_u > (size_t)UINT32_MAX)
+        return wserr_ERR_NO_MEM;
+
+    return(Reserve_t(trie_pst, (size_t)trie_pst->used_u32 + chars_u + 1U));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Looks up the keys starting with a prefix
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wstrie_Match_u(const wstrie_t *trie_pst, const char *prefix_cpc, size_t len_u,
+                        wstrie_match_t *match_pst)
+{
+    uint32_t node_u32 = Walk_u32(trie_pst, prefix_cpc, len_u);
+    size_t keys_u = (node_u32 != UINT32_MAX) ? trie_pst->nodes_pst[node_u32].keys_u32 : 0;
+
+    if(match_pst != NULL)
+    {
+        match_pst->node_u32 = node_u32;
+        match_pst->keys_u = keys_u;
+        match_pst->value_pv = NULL;
+
+        /* a single key is found on the path of nodes with one child */
+        if(keys_u == 1)
+        {
+            while(trie_pst->nodes_pst[node_u32].value_pv == NULL)
+            {
+                node_u32 = trie_pst->nodes_pst[node_u32].child_u32;
+            }
+            match_pst->value_pv = trie_pst->nodes_pst[node_u32].value_pv;
+        }
+    }
+
+    return(keys_u);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Looks up the value of a key
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *wstrie_Find_pv(const wstrie_t *trie_pst, const char *key_cpc, size_t len_u)
+{
+    uint32_t node_u32;
+
+    if(len_u == 0)
+        return NULL;
+
+    node_u32 = Walk_u32(trie_pst, key_cpc, len_u);
+    return((node_u32 != UINT32_MAX) ? trie_pst->nodes_pst[node_u32].value_pv : NULL);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Returns the characters all matching keys have in common
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+size_t wstrie_Common_u(const wstrie_t *trie_pst, const wstrie_match_t *match_pcst,
+                        char *buf_pc, size_t size_u)
+{
+    uint32_t node_u32 = match_pcst->node_u32;
+    uint32_t child_u32;
+    size_t len_u = 0;
+
+    if((match_pcst->keys_u == 0) || (size_u == 0))
+        return 0;
+
+    /* follow the nodes with exactly one child until a key ends */
+    while((len_u + 1U < size_u) && (trie_pst->nodes_pst[node_u32].value_pv == NULL))
+    {
+        child_u32 = trie_pst->nodes_pst[node_u32].child_u32;
+        if((child_u32 == 0) || (trie_pst->nodes_pst[child_u32].next_u32 != 0))
+            break;
+
+        buf_pc[len_u++] = trie_pst->nodes_pst[child_u32].ch_c;
+        node_u32 = child_u32;
+    }
+    buf_pc[len_u] = '\0';
+
+    return(len_u);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Visits the values of the matching keys in key order
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void wstrie_ForEach_vd(const wstrie_t *trie_pst, const wstrie_match_t *match_pcst,
+                        wstrie_visit_t visit_fp, void *data_pv)
+{
+    if((match_pcst->keys_u == 0) || (visit_fp == NULL))
+        return;
+
+    (void)Visit_bol(trie_pst, match_pcst->node_u32, visit_fp, data_pv);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Searches the child of a node for a character
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index
+ * @param   node_u32    parent node
+ * @param   ch_c        character of the child
+ * @return  index of the child, 0 if there is none
+*//*------------------------------------------------------------------------------------*/
+static uint32_t FindChild_u32(const wstrie_t *trie_pst, uint32_t node_u32, char ch_c)
+{
+    uint32_t mask_u32 = 2U * trie_pst->size_u32 - 1U;
+    uint32_t slot_u32 = EdgeSlot_u32(node_u32, ch_c, mask_u32);
+    uint32_t child_u32;
+
+    /* the index is at most half full, a free slot ends the probe sequence */
+    while((child_u32 = trie_pst->edges_pu32[slot_u32]) != 0)
+    {
+        if((trie_pst->nodes_pst[child_u32].parent_u32 == node_u32)
+            && (trie_pst->nodes_pst[child_u32].ch_c == ch_c))
+            return child_u32;
+        slot_u32 = (slot_u32 + 1U) & mask_u32;
+    }
+
+    return 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the first slot of an edge in the edge index
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   parent_u32  parent node
+ * @param   ch_c        character of the child
+ * @param   mask_u32    number of slots minus 1
+ * @return  slot index
+*//*------------------------------------------------------------------------------------*/
+static uint32_t EdgeSlot_u32(uint32_t parent_u32, char ch_c, uint32_t mask_u32)
+{
+    uint32_t hash_u32 = (parent_u32 * 256U + (unsigned char)ch_c) * 2654435761U;
+
+    return((hash_u32 ^ (hash_u32 >> 16)) & mask_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Adds the edge from the parent of a node to the node to the edge index
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   edges_pu32  edge index with a free slot
+ * @param   mask_u32    number of slots minus 1
+ * @param   nodes_pcst  node array
+ * @param   child_u32   node to add
+*//*------------------------------------------------------------------------------------*/
+static void AddEdge_vd(uint32_t *edges_pu32, uint32_t mask_u32, const wstrie_node_t *nodes_pcst,
+                        uint32_t child_u32)
+{
+    uint32_t slot_u32 = EdgeSlot_u32(nodes_pcst[child_u32].parent_u32,
+                                        nodes_pcst[child_u32].ch_c, mask_u32);
+
+    while(edges_pu32[slot_u32] != 0)
+    {
+        slot_u32 = (slot_u32 + 1U) & mask_u32;
+    }
+    edges_pu32[slot_u32] = child_u32;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Follows the characters of a key from the root
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index
+ * @param   key_cpc     key
+ * @param   len_u       length of the key
+ * @return  node of the last character, the root for an empty key, UINT32_MAX if the
+ *              key is not on a path of the index
+*//*------------------------------------------------------------------------------------*/
+static uint32_t Walk_u32(const wstrie_t *trie_pst, const char *key_cpc, size_t len_u)
+{
+    uint32_t node_u32 = 0;
+    size_t idx_u;
+
+    if((trie_pst == NULL) || (trie_pst->used_u32 == 0) || ((key_cpc == NULL) && (len_u > 0)))
+        return UINT32_MAX;
+
+    for(idx_u = 0; idx_u < len_u; idx_u++)
+    {
+        node_u32 = FindChild_u32(trie_pst, node_u32, key_cpc[idx_u]);
+        if(node_u32 == 0)
+            return UINT32_MAX;
+    }
+    return(node_u32);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Makes room for a number of nodes, the array grows by doubling
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index
+ * @param   nodes_u     number of nodes needed
+ * @return  wserr_OK on success, wserr_ERR_NO_MEM if out of memory
+*//*------------------------------------------------------------------------------------*/
+static wserr_t Reserve_t(wstrie_t *trie_pst, size_t nodes_u)
+{
+    wstrie_node_t *nodes_pst;
+    uint32_t *edges_pu32;
+    size_t size_u = (trie_pst->size_u32 != 0) ? trie_pst->size_u32 : MIN_NODES;
+    uint32_t node_u32;
+
+    if(nodes_u <= trie_pst->size_u32)
+        return wserr_OK;
+
+    while(size_u < nodes_u)
+        size_u *= 2U;
+
+    if(size_u >= UINT32_MAX / 2U)
+        return wserr_ERR_NO_MEM;
+
+    /* the edge index is built again for the new size, the old one stays valid
+     * until both allocations succeeded */
+    edges_pu32 = calloc(2U * size_u, sizeof(uint32_t));
+    if(edges_pu32 == NULL)
+        return wserr_ERR_NO_MEM;
+
+    nodes_pst = realloc(trie_pst->nodes_pst, size_u * sizeof(wstrie_node_t));
+    if(nodes_pst == NULL)
+    {
+        free(edges_pu32);
+        return wserr_ERR_NO_MEM;
+    }
+
+    for(node_u32 = 1; node_u32 < trie_pst->used_u32; node_u32++)
+    {
+        AddEdge_vd(edges_pu32, (uint32_t)(2U * size_u - 1U), nodes_pst, node_u32);
+    }
+    free(trie_pst->edges_pu32);
+
+    trie_pst->nodes_pst = nodes_pst;
+    trie_pst->edges_pu32 = edges_pu32;
+    trie_pst->size_u32 = (uint32_t)size_u;
+    return wserr_OK;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Visits the value of a node and the values below it, the recursion depth is
+ *              the length of the longest key
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index
+ * @param   node_u32    first node to visit
+ * @param   visit_fp    callback
+ * @param   data_pv     passed to the callback
+ * @return  false if the callback stopped the iteration
+*//*------------------------------------------------------------------------------------*/
+static bool Visit_bol(const wstrie_t *trie_pst, uint32_t node_u32, wstrie_visit_t visit_fp,
+                        void *data_pv)
+{
+    uint32_t child_u32;
+
+    if((trie_pst->nodes_pst[node_u32].value_pv != NULL)
+        && !visit_fp(data_pv, trie_pst->nodes_pst[node_u32].value_pv))
+        return false;
+
+    for(child_u32 = trie_pst->nodes_pst[node_u32].child_u32; child_u32 != 0;
+        child_u32 = trie_pst->nodes_pst[child_u32].next_u32)
+    {
+        if(!Visit_bol(trie_pst, child_u32, visit_fp, data_pv))
+            return false;
+    }
+    return true;
+}
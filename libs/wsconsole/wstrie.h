@@ -0,0 +1,247 @@
+/*****************************************************************************************
+* FILENAME :        wstrie.h
+*
+* DESCRIPTION :
+*       Header file for the prefix index of the console. The keys are stored in a
+*       trie of nodes kept in one array, a key or a prefix is found in steps
+*       proportional to its length, independent of the number of keys. Every node
+*       counts the keys below it, so the matches of a prefix are known without
+*       visiting them.
+*
+* Date: 16. Oct 2026
+*
+* NOTES :
+* Functional flow description / User interface
+*   wstrie_t trie_st;
+*   wstrie_match_t match_st;
+*
+*   wstrie_Init_vd(&trie_st);
+*   wserr_LOG(wstrie_Insert_t(&trie_st, "add", addItem_pv));
+*
+*   if(wstrie_Match_u(&trie_st, "ad", 2, &match_st) == 1)
+*       item_pv = match_st.value_pv;
+*
+*   wstrie_Free_vd(&trie_st);
+*
+*   Keys cannot be removed, the index lives as long as its owner. The siblings of a
+*   node are kept in character order, wstrie_ForEach_vd visits the keys sorted. A
+*   lookup does not scan the siblings, the child of a node for a character is found
+*   in a hash index over the edges, so each character costs the same however many
+*   keys share the prefix.
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*****************************************************************************************/
+#ifndef WSTRIE_H
+#define WSTRIE_H
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/****************************************************************************************/
+/* Imported header files: */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "wserr.h"
+
+/****************************************************************************************/
+/* Global constant defines: */
+
+/****************************************************************************************/
+/* Global function like macro defines (to be avoided): */
+
+/****************************************************************************************/
+/* Global type definitions (enum (en), struct (st), union (un), typedef (tx): */
+
+/**
+ * @brief Node of the trie, one character of one or more keys
+ */
+typedef struct wstrie_node_tag
+{
+    /**
+     * index of the first child and of the next sibling, 0 if there is none
+     */
+    uint32_t child_u32;
+    uint32_t next_u32;
+    /**
+     * index of the parent node, the key of the node in the edge index
+     */
+    uint32_t parent_u32;
+    /**
+     * number of keys ending at this node or below
+     */
+    uint32_t keys_u32;
+    char ch_c;
+    /**
+     * value of the key ending at this node, NULL if no key ends here
+     */
+    void *value_pv;
+} wstrie_node_t;
+
+/**
+ * @brief Prefix index. The structure is exposed to embed it in the owner, all
+ *          elements are private.
+ */
+typedef struct wstrie_tag
+{
+    /**
+     * node array, node 0 is the root
+     */
+    wstrie_node_t *nodes_pst;
+    uint32_t used_u32;
+    uint32_t size_u32;
+    /**
+     * edge index, open addressing over parent node and character with twice as
+     * many slots as nodes, a slot holds the child node or 0 if it is free
+     */
+    uint32_t *edges_pu32;
+} wstrie_t;
+
+/**
+ * @brief Keys starting with a prefix, see wstrie_Match_u
+ */
+typedef struct wstrie_match_tag
+{
+    /**
+     * node of the last character of the prefix
+     */
+    uint32_t node_u32;
+    /**
+     * number of matching keys
+     */
+    size_t keys_u;
+    /**
+     * value of the only matching key, NULL if none or several keys match
+     */
+    void *value_pv;
+} wstrie_match_t;
+
+/**
+ * @brief Callback of wstrie_ForEach_vd, returns false to stop the iteration
+ */
+typedef bool (*wstrie_visit_t)(void *data_pv, void *value_pv);
+
+/****************************************************************************************/
+/* Global function definitions: */
+/**---------------------------------------------------------------------------------------
+ * @brief   initializes an empty index, no memory is allocated before the first key
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index to initialize
+*//*------------------------------------------------------------------------------------*/
+extern void wstrie_Init_vd(wstrie_t *trie_pst);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   releases the nodes of the index, the index is empty afterwards
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index to release
+*//*------------------------------------------------------------------------------------*/
+extern void wstrie_Free_vd(wstrie_t *trie_pst);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   adds a key, the index is unchanged if the call fails
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   key_cpc       nul terminated key, not empty
+ * @param   value_pv      value returned for the key, not NULL
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if a parameter is invalid or the key exists already
+ *          - wserr_ERR_NO_MEM if out of memory
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wstrie_Insert_t(wstrie_t *trie_pst, const char *key_cpc, void *value_pv);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   makes room for keys of the given total length, the following inserts of
+ *              these keys do not fail for lack of memory
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   chars_u       sum of the lengths of the keys
+ * @return
+ *          - wserr_OK on success
+ *          - wserr_ERR_PARAM if trie_pst is NULL
+ *          - wserr_ERR_NO_MEM if out of memory
+*//*------------------------------------------------------------------------------------*/
+extern wserr_t wstrie_Reserve_t(wstrie_t *trie_pst, size_t chars_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   looks up the keys starting with a prefix
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   prefix_cpc    prefix, need not be nul terminated
+ * @param   len_u         length of the prefix, 0 matches all keys
+ * @param   match_pst     receives the matching keys, may be NULL
+ * @return  number of keys starting with the prefix
+*//*------------------------------------------------------------------------------------*/
+extern size_t wstrie_Match_u(const wstrie_t *trie_pst, const char *prefix_cpc, size_t len_u,
+                                wstrie_match_t *match_pst);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   looks up the value of a key
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   key_cpc       key, need not be nul terminated
+ * @param   len_u         length of the key
+ * @return  value of the key, NULL if the key is not in the index
+*//*------------------------------------------------------------------------------------*/
+extern void *wstrie_Find_pv(const wstrie_t *trie_pst, const char *key_cpc, size_t len_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   returns the characters all matching keys have in common behind the prefix
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   match_pcst    result of wstrie_Match_u with at least one key
+ * @param   buf_pc        receives the nul terminated characters
+ * @param   size_u        size of buf_pc, at least 1
+ * @return  number of characters stored in buf_pc
+*//*------------------------------------------------------------------------------------*/
+extern size_t wstrie_Common_u(const wstrie_t *trie_pst, const wstrie_match_t *match_pcst,
+                                char *buf_pc, size_t size_u);
+
+/**---------------------------------------------------------------------------------------
+ * @brief   visits the values of the matching keys in key order
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst      index
+ * @param   match_pcst    result of wstrie_Match_u
+ * @param   visit_fp      called once per key, returns false to stop
+ * @param   data_pv       passed to visit_fp
+*//*------------------------------------------------------------------------------------*/
+extern void wstrie_ForEach_vd(const wstrie_t *trie_pst, const wstrie_match_t *match_pcst,
+                                wstrie_visit_t visit_fp, void *data_pv);
+
+/****************************************************************************************/
+/* Global data definitions: */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //WSTRIE_H
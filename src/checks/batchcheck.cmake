@@ -0,0 +1,24 @@
+# Runs a script with the commands in order and on several threads and fails if the
+# output or the exit code differ, called by ctest with
+#   -DARG3CLI=<arg3cli> -DSCRIPT=<script> -DJOBS=<n> -DEXPECT=<regex>
+execute_process(
+    COMMAND ${ARG3CLI} -f ${SCRIPT}
+    RESULT_VARIABLE serialResult
+    OUTPUT_VARIABLE serial
+)
+if(NOT serial MATCHES "${EXPECT}")
+    message(FATAL_ERROR "${SCRIPT} printed\n${serial}")
+endif()
+
+execute_process(
+    COMMAND ${ARG3CLI} -f ${SCRIPT} -j ${JOBS}
+    RESULT_VARIABLE parallelResult
+    OUTPUT_VARIABLE parallel
+)
+if(NOT parallel STREQUAL serial)
+    message(FATAL_ERROR "${SCRIPT} with -j ${JOBS} printed\n${parallel}\ninstead of\n${serial}")
+endif()
+if(NOT parallelResult STREQUAL serialResult)
+    message(FATAL_ERROR "${SCRIPT} with -j ${JOBS} exits with ${parallelResult} "
+                        "instead of ${serialResult}")
+endif()
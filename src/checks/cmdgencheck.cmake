@@ -0,0 +1,15 @@
+# Runs the command table generator on a definition file it has to reject and checks
+# the reason, called by ctest with
+#   -DWSCMDGEN=<wscmdgen> -DDEF=<commands.def> -DOUT=<commands_hash.h> -DEXPECT=<regex>
+execute_process(
+    COMMAND ${WSCMDGEN} ${DEF} ${OUT}
+    RESULT_VARIABLE result
+    ERROR_VARIABLE errors
+)
+
+if(result EQUAL 0)
+    message(FATAL_ERROR "wscmdgen accepted ${DEF}")
+endif()
+if(NOT errors MATCHES "${EXPECT}")
+    message(FATAL_ERROR "wscmdgen rejected ${DEF} with: ${errors}")
+endif()
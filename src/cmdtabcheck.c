@@ -0,0 +1,235 @@
+/****************************************************************************************
+* FILENAME :        cmdtabcheck.c
+*
+* SHORT DESCRIPTION:
+*   Check of a command table with the perfect hash of the generator
+*
+* DETAILED DESCRIPTION :
+*   Builds the command table of checks/cmdgen_many.def with the header wscmdgen
+*   generated for it. The definition file has more commands than buckets, so
+*   several names share a bucket and the generator has to find seeds separating
+*   them. Every command must be stored at the slot of its name, every slot must
+*   be used and the console must accept the table and find each command by name.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wsconsole.h"
+#include "wscmdtab.h"
+#include "wserr.h"
+#include "cmdgen_many_hash.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static size_t NoInput_u(char *buf_pc, size_t size_u);
+static void DropOutput_vd(void *data_pv, const char *buf_pc, size_t len_u);
+static wserr_t RunCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp);
+static int CheckSlots_i(void);
+static int CheckRegister_i(void);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Command table of the definition file
+ */
+#define WSCMD WSCMDTAB_ITEM
+static const wsconsole_cmdItem_t commandItems_cast[WSCMDTAB_COUNT] =
+{
+#include "checks/cmdgen_many.def"
+};
+#undef WSCMD
+WSCMDTAB_TABLE(commandTable_cst, commandItems_cast);
+
+/**
+ * Command executed by the check, it remembers the last executed command
+ */
+static const char *executed_scpc = NULL;
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    int failed_i;
+
+    failed_i = CheckSlots_i();
+    failed_i += CheckRegister_i();
+
+    return((failed_i > 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks that the table is complete and each name hashes to its own slot
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  number of misplaced or missing commands
+*//*------------------------------------------------------------------------------------*/
+static int CheckSlots_i(void)
+{
+    size_t idx_u;
+    size_t slot_u;
+    int failed_i = 0;
+
+    if(WSCMDTAB_BUCKETS >= WSCMDTAB_COUNT)
+    {
+        fprintf(stderr, "cmdtabcheck: %d buckets for %d commands\n",
+                WSCMDTAB_BUCKETS, WSCMDTAB_COUNT);
+        failed_i++;
+    }
+
+    for(idx_u = 0; idx_u < WSCMDTAB_COUNT; idx_u++)
+    {
+        if(commandItems_cast[idx_u].command == NULL)
+        {
+            fprintf(stderr, "cmdtabcheck: slot %zu is not used\n", idx_u);
+            failed_i++;
+            continue;
+        }
+
+        slot_u = wscmdtab_Slot_u(&commandTable_cst,
+                                 wscmdtab_Hash_u32(commandItems_cast[idx_u].command));
+        if(slot_u != idx_u)
+        {
+            fprintf(stderr, "cmdtabcheck: %s is stored at %zu, its slot is %zu\n",
+                    commandItems_cast[idx_u].command, idx_u, slot_u);
+            failed_i++;
+        }
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Registers the table with a console and executes every command by its name
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  number of commands not executed, 1 if the table is not accepted
+*//*------------------------------------------------------------------------------------*/
+static int CheckRegister_i(void)
+{
+    wsconsole_config_t config_st;
+    wsconsole_tp console_x;
+    char line_ca[64];
+    size_t idx_u;
+    int failed_i = 0;
+
+    (void)wsconsole_InitParameter_t(&config_st);
+    config_st.getBufferFunc_fp = NoInput_u;
+    config_st.writeFunc_fp = DropOutput_vd;
+
+    console_x = wsconsole_AllocateConsole_t();
+    if((console_x == NULL) || (wsconsole_Init_t(console_x, &config_st) != wserr_OK)
+        || (wsconsole_RegisterTable_t(console_x, &commandTable_cst) != wserr_OK))
+    {
+        fprintf(stderr, "cmdtabcheck: command table not accepted\n");
+        failed_i = 1;
+    }
+    else
+    {
+        for(idx_u = 0; idx_u < WSCMDTAB_COUNT; idx_u++)
+        {
+            executed_scpc = NULL;
+            (void)snprintf(line_ca, sizeof(line_ca), "%s\n", commandItems_cast[idx_u].command);
+            (void)wsconsole_Feed_t(console_x, line_ca, strlen(line_ca));
+            if((executed_scpc == NULL) ||
+               (strcmp(executed_scpc, commandItems_cast[idx_u].command) != 0))
+            {
+                fprintf(stderr, "cmdtabcheck: %s not executed\n",
+                        commandItems_cast[idx_u].command);
+                failed_i++;
+            }
+        }
+    }
+
+    if(console_x != NULL)
+    {
+        (void)wsconsole_DeInit_t(console_x);
+        (void)wsconsole_FreeConsole_t(console_x);
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Input interface of the console, the lines are passed with wsconsole_Feed_t
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  0, no input
+*//*------------------------------------------------------------------------------------*/
+static size_t NoInput_u(char *buf_pc, size_t size_u)
+{
+    (void)buf_pc;
+    (void)size_u;
+    return 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Output interface of the console, the output is not checked
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void DropOutput_vd(void *data_pv, const char *buf_pc, size_t len_u)
+{
+    (void)data_pv;
+    (void)buf_pc;
+    (void)len_u;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Callback of all commands of the table, remembers the executed command
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt     pointer to command
+ * @param   resp_fp    FILE object to create the response
+ * @return  wserr_OK
+*//*------------------------------------------------------------------------------------*/
+static wserr_t RunCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp)
+{
+    (void)resp_fp;
+    executed_scpc = cmd_pt->command;
+    return wserr_OK;
+}
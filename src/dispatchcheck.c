@@ -0,0 +1,356 @@
+/****************************************************************************************
+* FILENAME :        dispatchcheck.c
+*
+* SHORT DESCRIPTION:
+*   Check of the heap free dispatch of the console
+*
+* DETAILED DESCRIPTION :
+*   Feeds command lines to a console executing the commands itself and to a console
+*   handing them to an executor, both with a persistent history, and fails if the
+*   dispatch of a line uses the heap after warm-up. Each kind of console is checked
+*   with the compile time line buffers and with line memory for long lines. malloc,
+*   calloc and realloc are replaced by wrappers which count the allocations of the
+*   calling thread, so the allocations of the console, the argument parser and the
+*   C library are all seen. The wrappers use the allocator of the GNU C library.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "wsconsole.h"
+#include "wshist.h"
+#include "wserr.h"
+#include "argtable3.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Number of times every line is dispatched before the allocations are checked
+ */
+#define CHECK_WARMUP_RUNS 2
+
+/**
+ * Line length of the consoles with line memory, the long line of the check holds
+ * more arguments than fit into the compile time buffers
+ */
+#define CHECK_LINE_LEN 256U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+extern void *__libc_malloc(size_t size_u);
+extern void *__libc_calloc(size_t count_u, size_t size_u);
+extern void *__libc_realloc(void *mem_pv, size_t size_u);
+
+static unsigned long CountAllocs_u(void);
+static size_t NoInput_u(char *buf_pc, size_t size_u);
+static void DropOutput_vd(void *data_pv, const char *buf_pc, size_t len_u);
+static void Submit_vd(wsconsole_tp console_x, void *data_pv);
+static wserr_t AddCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp);
+static int CheckConsole_i(bool deferred_bol, size_t lineLen_u, wshist_tp hist_x);
+static int CheckLines_i(wsconsole_tp console_x, bool deferred_bol);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Heap allocations of this thread
+ */
+static __thread unsigned long allocs_xsu = 0;
+
+/**
+ * Argument table of the add command
+ */
+static void *addArgs_apv[3];
+
+/**
+ * Command with an argument table, the help command is registered by the console
+ */
+static wsconsole_cmdItem_t addItem_st =
+{
+    .command = "add",
+    .help = "Adds two numbers",
+    .hint = NULL,
+    .func = AddCommand_t,
+    .argtable = addArgs_apv,
+    .atomic = false,
+    .independent = false,
+};
+
+/**
+ * Lines dispatched by the check, the unique prefix, omitted arguments and invalid
+ * arguments take different paths
+ */
+static const char *lines_capc[] =
+{
+    "add 1 2\n",
+    "add 7\n",
+    "ad 3 4\n",
+    "add x\n",
+    "help add\n",
+    "\n",
+    "unknown\n",
+    "add 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19 20 21 22 23 24 25\n",
+};
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates memory and counts the allocation for the calling thread
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *malloc(size_t size_u)
+{
+    allocs_xsu++;
+    return(__libc_malloc(size_u));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Allocates zeroed memory and counts the allocation for the calling thread
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *calloc(size_t count_u, size_t size_u)
+{
+    allocs_xsu++;
+    return(__libc_calloc(count_u, size_u));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Resizes memory and counts the allocation for the calling thread
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+void *realloc(void *mem_pv, size_t size_u)
+{
+    allocs_xsu++;
+    return(__libc_realloc(mem_pv, size_u));
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    char histPath_ca[] = "/tmp/dispatchcheck_XXXXXX";
+    wshist_config_t histConfig_st;
+    wshist_tp hist_x;
+    int histFd_i;
+    int failed_i;
+
+    addArgs_apv[0] = arg_int0(NULL, NULL, "<a>", "First number");
+    addArgs_apv[1] = arg_int0(NULL, NULL, "<b>", "Second number");
+    addArgs_apv[2] = arg_end(20);
+
+    histFd_i = mkstemp(histPath_ca);
+    if(histFd_i < 0)
+    {
+        fprintf(stderr, "dispatchcheck: history file cannot be created\n");
+        return EXIT_FAILURE;
+    }
+    (void)close(histFd_i);
+    (void)wshist_InitParameter_t(&histConfig_st);
+    histConfig_st.path_cpc = histPath_ca;
+    hist_x = wshist_AllocateHistory_t(&histConfig_st);
+
+    failed_i = (hist_x == NULL) ? 1 : 0;
+    failed_i += CheckConsole_i(false, 0, hist_x);
+    failed_i += CheckConsole_i(true, 0, hist_x);
+    failed_i += CheckConsole_i(false, CHECK_LINE_LEN, hist_x);
+    failed_i += CheckConsole_i(true, CHECK_LINE_LEN, hist_x);
+
+    if(hist_x != NULL)
+        (void)wshist_FreeHistory_t(hist_x);
+    (void)unlink(histPath_ca);
+    arg_freetable(addArgs_apv, sizeof(addArgs_apv) / sizeof(addArgs_apv[0]));
+
+    return((failed_i > 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Sets up a console and checks the dispatch of all lines
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   deferred_bol    the commands are handed to an executor, which is this
+ *                          thread calling wsconsole_ExecutePending_t
+ * @param   lineLen_u       line length of the console, 0 for the compile time size
+ * @param   hist_x          history of the console
+ * @return  number of failed lines, 1 if the console cannot be set up
+*//*------------------------------------------------------------------------------------*/
+static int CheckConsole_i(bool deferred_bol, size_t lineLen_u, wshist_tp hist_x)
+{
+    wsconsole_config_t config_st;
+    wsconsole_tp console_x;
+    int failed_i;
+
+    (void)wsconsole_InitParameter_t(&config_st);
+    config_st.getBufferFunc_fp = NoInput_u;
+    config_st.writeFunc_fp = DropOutput_vd;
+    config_st.allocCountFunc_fp = CountAllocs_u;
+    config_st.history_x = hist_x;
+    config_st.lineLen_u = lineLen_u;
+    if(deferred_bol)
+        config_st.submitFunc_fp = Submit_vd;
+
+    console_x = wsconsole_AllocateConsole_t();
+    if((console_x == NULL) || (wsconsole_Init_t(console_x, &config_st) != wserr_OK)
+        || (wsconsole_RegisterCommand_t(console_x, &addItem_st) != wserr_OK))
+    {
+        fprintf(stderr, "dispatchcheck: console setup failed\n");
+        return 1;
+    }
+
+    failed_i = CheckLines_i(console_x, deferred_bol);
+
+    (void)wsconsole_DeInit_t(console_x);
+    (void)wsconsole_FreeConsole_t(console_x);
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Dispatches every line after warm-up and reports the lines which used the
+ *              heap
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   console_x       console to check
+ * @param   deferred_bol    the pending command is executed after each line
+ * @return  number of failed lines
+*//*------------------------------------------------------------------------------------*/
+static int CheckLines_i(wsconsole_tp console_x, bool deferred_bol)
+{
+    int failed_i = 0;
+    int run_i;
+    size_t idx_u;
+    size_t allocs_u;
+
+    for(idx_u = 0; idx_u < sizeof(lines_capc) / sizeof(lines_capc[0]); idx_u++)
+    {
+        for(run_i = 0; run_i < CHECK_WARMUP_RUNS; run_i++)
+        {
+            (void)wsconsole_Feed_t(console_x, lines_capc[idx_u], strlen(lines_capc[idx_u]));
+            if(deferred_bol)
+                (void)wsconsole_ExecutePending_t(console_x);
+        }
+    }
+
+    for(idx_u = 0; idx_u < sizeof(lines_capc) / sizeof(lines_capc[0]); idx_u++)
+    {
+        (void)wsconsole_Feed_t(console_x, lines_capc[idx_u], strlen(lines_capc[idx_u]));
+        if(deferred_bol)
+            (void)wsconsole_ExecutePending_t(console_x);
+        allocs_u = wsconsole_GetDispatchAllocs_u(console_x);
+        if(allocs_u != 0)
+        {
+            fprintf(stderr, "dispatchcheck: %zu heap allocations dispatching \"%.*s\"%s\n",
+                    allocs_u, (int)strcspn(lines_capc[idx_u], "\n"), lines_capc[idx_u],
+                    deferred_bol ? " deferred" : "");
+            failed_i++;
+        }
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the heap allocations of the calling thread
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  number of allocations so far
+*//*------------------------------------------------------------------------------------*/
+static unsigned long CountAllocs_u(void)
+{
+    return(allocs_xsu);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Input interface of the console, the lines are passed with wsconsole_Feed_t
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  0, no input
+*//*------------------------------------------------------------------------------------*/
+static size_t NoInput_u(char *buf_pc, size_t size_u)
+{
+    (void)buf_pc;
+    (void)size_u;
+    return 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Output interface of the console, the output is not checked
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void DropOutput_vd(void *data_pv, const char *buf_pc, size_t len_u)
+{
+    (void)data_pv;
+    (void)buf_pc;
+    (void)len_u;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Executor interface of the console, the check executes the pending command
+ *              after each line
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+*//*------------------------------------------------------------------------------------*/
+static void Submit_vd(wsconsole_tp console_x, void *data_pv)
+{
+    (void)console_x;
+    (void)data_pv;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Adds two numbers
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   cmd_pt     pointer to command
+ * @param   resp_fp    FILE object to create the response
+ * @return  wserr_OK
+*//*------------------------------------------------------------------------------------*/
+static wserr_t AddCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp)
+{
+    struct arg_int **argtable_ppst = (struct arg_int **)cmd_pt->argtable;
+
+    fprintf(resp_fp, "The result is: %d\n", *argtable_ppst[0]->ival + *argtable_ppst[1]->ival);
+    return wserr_OK;
+}
@@ -0,0 +1,290 @@
+/****************************************************************************************
+* FILENAME :        histcheck.c
+*
+* SHORT DESCRIPTION:
+*   Check of the compaction of the history file
+*
+* DETAILED DESCRIPTION :
+*   Writes numbered lines of equal length to a history file above its size limit
+*   and checks that the compaction keeps the newest lines only, at most half of the
+*   limit and starting with a complete line. The file is compacted once when the
+*   history is opened and repeatedly while lines are appended and flushed.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "wshist.h"
+#include "wserr.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Size limit of the checked history files
+ */
+#define CHECK_MAX_BYTES WSHIST_MIN_BYTES
+
+/**
+ * Format of the numbered lines, each line has CHECK_LINE_LEN characters including
+ * the line feed
+ */
+#define CHECK_LINE_FMT "cmd %05d"
+#define CHECK_LINE_LEN 10
+
+/**
+ * Number of lines written, the lines fill the limit several times
+ */
+#define CHECK_LINES 1000
+
+/**
+ * Lines appended between two flushes of the history
+ */
+#define CHECK_FLUSH_LINES 50
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static int CheckOpenCompaction_i(const char *path_cpc);
+static int CheckFlushCompaction_i(const char *path_cpc);
+static int ReadLines_i(const char *path_cpc, int *first_pi, long *size_pi);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    char histPath_ca[] = "/tmp/histcheck_XXXXXX";
+    int histFd_i;
+    int failed_i;
+
+    histFd_i = mkstemp(histPath_ca);
+    if(histFd_i < 0)
+    {
+        fprintf(stderr, "histcheck: history file cannot be created\n");
+        return EXIT_FAILURE;
+    }
+    (void)close(histFd_i);
+
+    failed_i = CheckOpenCompaction_i(histPath_ca);
+    failed_i += CheckFlushCompaction_i(histPath_ca);
+
+    (void)unlink(histPath_ca);
+
+    return((failed_i > 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Opens a history file above the limit and checks that exactly the newest
+ *              complete lines fitting into half of the limit are kept
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    path of the history file
+ * @return  number of failed checks
+*//*------------------------------------------------------------------------------------*/
+static int CheckOpenCompaction_i(const char *path_cpc)
+{
+    wshist_config_t histConfig_st;
+    wshist_tp hist_x;
+    FILE *hist_fp;
+    long size_i;
+    int first_i;
+    int lines_i;
+    int line_i;
+
+    hist_fp = fopen(path_cpc, "w");
+    if(hist_fp == NULL)
+    {
+        fprintf(stderr, "histcheck: %s cannot be written\n", path_cpc);
+        return 1;
+    }
+    for(line_i = 0; line_i < CHECK_LINES; line_i++)
+    {
+        fprintf(hist_fp, CHECK_LINE_FMT "\n", line_i);
+    }
+    (void)fclose(hist_fp);
+
+    (void)wshist_InitParameter_t(&histConfig_st);
+    histConfig_st.path_cpc = path_cpc;
+    histConfig_st.maxBytes_u = CHECK_MAX_BYTES;
+    hist_x = wshist_AllocateHistory_t(&histConfig_st);
+    if(hist_x == NULL)
+    {
+        fprintf(stderr, "histcheck: history cannot be opened\n");
+        return 1;
+    }
+    (void)wshist_FreeHistory_t(hist_x);
+
+    lines_i = ReadLines_i(path_cpc, &first_i, &size_i);
+    if((lines_i != (CHECK_MAX_BYTES / 2) / CHECK_LINE_LEN) ||
+       (first_i + lines_i != CHECK_LINES))
+    {
+        fprintf(stderr, "histcheck: open kept %d lines from %d, %ld bytes\n",
+                lines_i, first_i, size_i);
+        return 1;
+    }
+
+    return 0;
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Appends lines to an empty history and flushes it in between, checks that
+ *              the file stays below the limit and ends with the newest lines
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    path of the history file
+ * @return  number of failed checks
+*//*------------------------------------------------------------------------------------*/
+static int CheckFlushCompaction_i(const char *path_cpc)
+{
+    wshist_config_t histConfig_st;
+    wshist_tp hist_x;
+    char line_ca[CHECK_LINE_LEN];
+    long size_i;
+    int first_i;
+    int lines_i;
+    int line_i;
+    int failed_i = 0;
+
+    if(truncate(path_cpc, 0) != 0)
+    {
+        fprintf(stderr, "histcheck: %s cannot be truncated\n", path_cpc);
+        return 1;
+    }
+
+    (void)wshist_InitParameter_t(&histConfig_st);
+    histConfig_st.path_cpc = path_cpc;
+    histConfig_st.maxBytes_u = CHECK_MAX_BYTES;
+    hist_x = wshist_AllocateHistory_t(&histConfig_st);
+    if(hist_x == NULL)
+    {
+        fprintf(stderr, "histcheck: history cannot be opened\n");
+        return 1;
+    }
+
+    for(line_i = 0; line_i < CHECK_LINES; line_i++)
+    {
+        (void)snprintf(line_ca, sizeof(line_ca), CHECK_LINE_FMT, line_i);
+        if(wshist_Append_t(hist_x, line_ca) != wserr_OK)
+            failed_i++;
+
+        if(((line_i + 1) % CHECK_FLUSH_LINES) == 0)
+        {
+            if(wshist_Flush_t(hist_x) != wserr_OK)
+                failed_i++;
+
+            lines_i = ReadLines_i(path_cpc, &first_i, &size_i);
+            if((lines_i <= 0) || (size_i > CHECK_MAX_BYTES) ||
+               (first_i + lines_i != line_i + 1))
+            {
+                fprintf(stderr, "histcheck: after line %d the file has %d lines from %d, "
+                        "%ld bytes\n", line_i, lines_i, first_i, size_i);
+                failed_i++;
+            }
+        }
+    }
+    (void)wshist_FreeHistory_t(hist_x);
+
+    /* the last compaction dropped the oldest lines */
+    lines_i = ReadLines_i(path_cpc, &first_i, &size_i);
+    if(first_i == 0)
+    {
+        fprintf(stderr, "histcheck: the file was not compacted\n");
+        failed_i++;
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Reads a history file of numbered lines and checks that the lines are
+ *              complete and follow each other
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   path_cpc    path of the history file
+ * @param   first_pi    receives the number of the first line, -1 if there is none
+ * @param   size_pi     receives the size of the file
+ * @return  number of lines, -1 if the file cannot be read or a line is broken or
+ *              missing
+*//*------------------------------------------------------------------------------------*/
+static int ReadLines_i(const char *path_cpc, int *first_pi, long *size_pi)
+{
+    char line_ca[2 * CHECK_LINE_LEN];
+    char expected_ca[CHECK_LINE_LEN + 1];
+    FILE *hist_fp;
+    int lines_i = 0;
+    int number_i;
+
+    *first_pi = -1;
+    *size_pi = 0;
+    hist_fp = fopen(path_cpc, "r");
+    if(hist_fp == NULL)
+        return -1;
+
+    while(fgets(line_ca, sizeof(line_ca), hist_fp) != NULL)
+    {
+        if((sscanf(line_ca, "cmd %d", &number_i) != 1) || (number_i < 0))
+        {
+            lines_i = -1;
+            break;
+        }
+        if(*first_pi < 0)
+            *first_pi = number_i;
+
+        (void)snprintf(expected_ca, sizeof(expected_ca), CHECK_LINE_FMT "\n",
+                       *first_pi + lines_i);
+        if(strcmp(line_ca, expected_ca) != 0)
+        {
+            lines_i = -1;
+            break;
+        }
+        lines_i++;
+    }
+
+    *size_pi = ftell(hist_fp);
+    (void)fclose(hist_fp);
+
+    return(lines_i);
+}
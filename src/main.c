@@ -32,16 +32,30 @@
 
 /***************************************************************************************/
 /* Include Interfaces */
+#include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
-#include <termios.h>
+#include <fcntl.h>
+#include <pthread.h>
 
 #include "wsconsole.h"
+#include "wsserver.h"
+#include "wsbatch.h"
+#include "wsterm.h"
+#include "wshist.h"
+#include "wscmdtab.h"
 #include "wserr.h"
 #include "argtable3.h"
+#include "commands_hash.h"
 
 /***************************************************************************************/
 /* Local constant defines */
 
+/**
+ * Number of threads executing the commands of the server sessions
+ */
+#define SERVER_WORKERS 4
+
 /***************************************************************************************/
 /* Local function like makros */
 
@@ -50,10 +64,13 @@
 
 /***************************************************************************************/
 /* Local functions prototypes: */
-static char GetCharacter_c(void);
 static void InterruptHandler_vd(int dummy);
 static void PosixPutCharacter_vd(void *data_vp, char character_c, bool isLastChar_b);
+static void PosixWrite_vd(void *data_vp, const char *buf_pc, size_t len_u);
 static wserr_t AddCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp);
+static wserr_t StartServer_t(const char *address_cpc);
+static void *ServerThread_pv(void *data_pv);
+static int RunScript_i(const char *path_cpc, int jobs_i);
 
 /***************************************************************************************/
 /* Local variables: */
@@ -62,6 +79,34 @@ static wserr_t AddCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp);
  */
 static wsconsole_tp console_xs;
 
+/**
+ * Console server sharing the commands of the console, NULL if not started
+ */
+static wsserver_tp server_xs = NULL;
+static pthread_t serverThread_sts;
+
+/**
+ * Persistent command history of the console and the server sessions, NULL if not
+ * requested
+ */
+static wshist_tp history_xs = NULL;
+
+/**
+ * Argument tables of the commands, the entries are created at start up
+ */
+static void *addArgs_apv[3];
+
+/**
+ * Command table of commands.def, the descriptions stay in read only memory
+ */
+#define WSCMD WSCMDTAB_ITEM
+static const wsconsole_cmdItem_t commandItems_cast[WSCMDTAB_COUNT] =
+{
+#include "commands.def"
+};
+#undef WSCMD
+WSCMDTAB_TABLE(commandTable_cst, commandItems_cast);
+
 /***************************************************************************************/
 /* Global functions (unlimited visibility) */
 /**--------------------------------------------------------------------------------------
@@ -69,82 +114,111 @@ static wsconsole_tp console_xs;
  * @author    S. Wink
  * @date      03. Mar. 2024
 *//*-----------------------------------------------------------------------------------*/
-int main(void)
+int main(int argc, char *argv[])
 {
     wsconsole_config_t consoleConfig_sts;
-    wsconsole_cmdItem_t command_st;
+    struct arg_str *listen_pst = arg_str0(NULL, "listen", "<path|port>",
+                        "serve the commands on a Unix socket or a localhost TCP port");
+    struct arg_file *script_pst = arg_file0("f", "file", "<script>",
+                        "execute the commands of the script and exit, - reads stdin");
+    struct arg_int *jobs_pst = arg_int0("j", "jobs", "<n>",
+                        "run the independent commands of the script on n threads");
+    struct arg_file *history_pst = arg_file0(NULL, "history", "<file>",
+                        "keep the command history in the file");
+    struct arg_lit *help_pst = arg_lit0("h", "help", "print this help and exit");
+    struct arg_end *optEnd_pst = arg_end(5);
+    void *options_apv[] = {listen_pst, script_pst, jobs_pst, history_pst, help_pst,
+                            optEnd_pst};
+    wshist_config_t histConfig_st;
+    bool batch_bol;
+    int exitCode_i = EXIT_SUCCESS;
+
+    if((arg_parse(argc, argv, options_apv) > 0) || (help_pst->count > 0))
+    {
+        arg_print_errors(stderr, optEnd_pst, argv[0]);
+        printf("Usage: %s", argv[0]);
+        arg_print_syntax(stdout, options_apv, "\n");
+        arg_print_glossary(stdout, options_apv, "  %-20s %s\n");
+        arg_freetable(options_apv, sizeof(options_apv) / sizeof(options_apv[0]));
+        return (help_pst->count > 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    batch_bol = (script_pst->count > 0);
 
     wserr_LOG(wsconsole_InitParameter_t(&consoleConfig_sts));
-    consoleConfig_sts.getCharFunc_fp = GetCharacter_c;
-    consoleConfig_sts.intHandler_fp = InterruptHandler_vd;
+    consoleConfig_sts.getBufferFunc_fp = wsterm_Read_u;
     consoleConfig_sts.putCharFunc_fp = PosixPutCharacter_vd;
+    consoleConfig_sts.writeFunc_fp = PosixWrite_vd;
+    if(!batch_bol)
+    {
+        consoleConfig_sts.intHandler_fp = InterruptHandler_vd;
+        consoleConfig_sts.termFd_i = STDIN_FILENO;
+        /* interactive sessions keep the editor responsive while a command runs,
+         * scripted input is executed line by line */
+        consoleConfig_sts.asyncExec_bol = isatty(STDIN_FILENO);
+
+        if(history_pst->count > 0)
+        {
+            (void)wshist_InitParameter_t(&histConfig_st);
+            histConfig_st.path_cpc = history_pst->filename[0];
+            history_xs = wshist_AllocateHistory_t(&histConfig_st);
+            if(history_xs == NULL)
+            {
+                fprintf(stderr, "%s: cannot open history file %s\n", argv[0],
+                        histConfig_st.path_cpc);
+            }
+            consoleConfig_sts.history_x = history_xs;
+        }
+    }
 
     console_xs = wsconsole_AllocateConsole_t();
     wserr_LOG(wsconsole_Init_t(console_xs, &consoleConfig_sts));
-      
-    command_st.command = "add";
-    command_st.hint = NULL;
-    command_st.help = "Adds the two numbers and returns the result.";
-    command_st.func = &AddCommand_t;
-    struct arg_int *add_args[2];
-    add_args[0] = arg_int0(NULL, NULL, "<a>", "First number");
-    add_args[1] = arg_int0(NULL, NULL, "<b>", "Second number");
-    struct arg_end *end = arg_end(20);
-    void *argtable[] = {add_args[0], add_args[1], end};
-    command_st.argtable = argtable;
-
-    wserr_LOG(wsconsole_RegisterCommand_t(console_xs, &command_st));
 
-    while(true)
+    addArgs_apv[0] = arg_int0(NULL, NULL, "<a>", "First number");
+    addArgs_apv[1] = arg_int0(NULL, NULL, "<b>", "Second number");
+    addArgs_apv[2] = arg_end(20);
+
+    wserr_LOG(wsconsole_RegisterTable_t(console_xs, &commandTable_cst));
+
+    if(batch_bol)
+    {
+        exitCode_i = RunScript_i(script_pst->filename[0],
+                                    (jobs_pst->count > 0) ? jobs_pst->ival[0] : 0);
+    }
+    else
     {
-        wserr_LOG(wsconsole_Run_t(console_xs));
+        /* the server sessions share the commands registered above */
+        if(listen_pst->count > 0)
+        {
+            wserr_LOG(StartServer_t(listen_pst->sval[0]));
+        }
+
+        while(true)
+        {
+            wserr_LOG(wsconsole_Run_t(console_xs));
+        }
     }
  
+    if(server_xs != NULL)
+    {
+        (void)pthread_cancel(serverThread_sts);
+        (void)pthread_join(serverThread_sts, NULL);
+        wserr_LOG(wsserver_FreeServer_t(server_xs));
+    }
     wserr_LOG(wsconsole_DeInit_t(console_xs));   
+    wserr_LOG(wsconsole_FreeConsole_t(console_xs));
+    if(history_xs != NULL)
+    {
+        wserr_LOG(wshist_FreeHistory_t(history_xs));
+    }
+    arg_freetable(addArgs_apv, sizeof(addArgs_apv) / sizeof(addArgs_apv[0]));
+    arg_freetable(options_apv, sizeof(options_apv) / sizeof(options_apv[0]));
+
+    return(exitCode_i);
 }
 
 /***************************************************************************************/
 /* Local functions: */
 
-/**--------------------------------------------------------------------------------------
- * @brief     This function retrieves exactly one character from stdin, in 
- *            character-by-character mode (as opposed to reading a full line)
- * @author    S. Wink
- * @date      03. Mar. 2024
- * @return    one character retrieved by stdin
-*//*-----------------------------------------------------------------------------------*/
-static char GetCharacter_c(void)
-{
-    char buffer_c = 0;
-    struct termios old_st = {0};
-    if (tcgetattr(0, &old_st) < 0)
-        perror("tcsetattr()");
-
-    struct termios raw = old_st;
-
-    /* Do what cfmakeraw does (Using --std=c99 means that cfmakeraw isn't
-    available) */
-    raw.c_iflag &=
-        ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON);
-    raw.c_oflag &= ~OPOST;
-    raw.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
-    raw.c_cflag &= ~(CSIZE | PARENB);
-    raw.c_cflag |= CS8;
-
-    raw.c_cc[VMIN] = 1;
-    raw.c_cc[VTIME] = 0;
-
-    if (tcsetattr(0, TCSANOW, &raw) < 0)
-        perror("tcsetattr ICANON");
-
-    if (read(0, &buffer_c, 1) < 0)
-        perror("read()");
-
-    if (tcsetattr(0, TCSADRAIN, &old_st) < 0)
-        perror("tcsetattr ~ICANON");
-    return (buffer_c);
-}
-
 /**--------------------------------------------------------------------------------------
  * @brief     The interrupt handler function is a signal handler for SIGINT (Ctrl-C). 
  *            It's used to capture Ctrl-C and interrupt the CLI input.
@@ -179,6 +253,24 @@ static void PosixPutCharacter_vd(void *data_vp, char character_c, bool isLastCha
         fflush(outStream_fp);
 }
 
+/**--------------------------------------------------------------------------------------
+ * @brief     This function outputs a block of characters to stdout, to be used as the
+ *            block output callback from embedded cli.
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+ * @param     *data_vp      pointer to data channel
+ * @param     buf_pc        characters to print to channel
+ * @param     len_u         number of characters
+ * @return    none
+*//*-----------------------------------------------------------------------------------*/
+static void PosixWrite_vd(void *data_vp, const char *buf_pc, size_t len_u)
+{
+    FILE *outStream_fp = data_vp;
+
+    fwrite(buf_pc, 1, len_u, outStream_fp);
+    fflush(outStream_fp);
+}
+
 /**--------------------------------------------------------------------------------------
  * @brief     This is the callback function to add two numbers.
  * @author    S. Wink
@@ -205,3 +297,105 @@ static wserr_t AddCommand_t(wsconsole_cmdItem_tp cmd_pt, FILE *resp_fp)
     fprintf(resp_fp, "The result is: %d\n", result);
     return wserr_OK;
 }
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Starts the console server on its own thread
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+ * @param     address_cpc   Unix socket path, or localhost TCP port if only digits
+ * @return    wserr_OK on success, else the error of the server initialization
+*//*-----------------------------------------------------------------------------------*/
+static wserr_t StartServer_t(const char *address_cpc)
+{
+    wsserver_config_t serverConfig_st;
+    wserr_t exeResult_st;
+
+    (void)wsserver_InitParameter_t(&serverConfig_st);
+    if((address_cpc[0] != '\0') && (strspn(address_cpc, "0123456789") == strlen(address_cpc)))
+    {
+        serverConfig_st.tcpPort_i = atoi(address_cpc);
+    }
+    else
+    {
+        serverConfig_st.unixPath_cpc = address_cpc;
+    }
+    serverConfig_st.registry_x = console_xs;
+    serverConfig_st.history_x = history_xs;
+    serverConfig_st.workers_u = SERVER_WORKERS;
+
+    server_xs = wsserver_AllocateServer_t();
+    if(server_xs == NULL)
+        return wserr_ERR_NO_MEM;
+
+    exeResult_st = wsserver_Init_t(server_xs, &serverConfig_st);
+    if((wserr_OK == exeResult_st)
+        && (pthread_create(&serverThread_sts, NULL, ServerThread_pv, server_xs) != 0))
+    {
+        exeResult_st = wserr_ERR_NO_MEM;
+    }
+    if(wserr_OK != exeResult_st)
+    {
+        (void)wsserver_FreeServer_t(server_xs);
+        server_xs = NULL;
+    }
+
+    return(exeResult_st);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Thread of the console server, serves all sessions
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+ * @param     data_pv       server object
+ * @return    NULL
+*//*-----------------------------------------------------------------------------------*/
+static void *ServerThread_pv(void *data_pv)
+{
+    while(true)
+    {
+        wserr_LOG(wsserver_Poll_t(data_pv, -1));
+    }
+
+    return(NULL);
+}
+
+/**--------------------------------------------------------------------------------------
+ * @brief     Executes the commands of a script in batch mode
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+ * @param     path_cpc      path of the script, - for stdin
+ * @param     jobs_i        number of threads for the independent commands, 0 runs
+ *                          all commands on the calling thread
+ * @return    EXIT_SUCCESS if all commands succeeded, else EXIT_FAILURE
+*//*-----------------------------------------------------------------------------------*/
+static int RunScript_i(const char *path_cpc, int jobs_i)
+{
+    wsbatch_config_t batchConfig_st;
+    wserr_t exeResult_st;
+    size_t failed_u = 0;
+
+    (void)wsbatch_InitParameter_t(&batchConfig_st);
+    batchConfig_st.workers_u = (jobs_i > 0) ? (size_t)jobs_i : 0;
+    if(strcmp(path_cpc, "-") == 0)
+    {
+        batchConfig_st.fd_i = STDIN_FILENO;
+    }
+    else
+    {
+        batchConfig_st.fd_i = open(path_cpc, O_RDONLY);
+        if(batchConfig_st.fd_i < 0)
+        {
+            perror(path_cpc);
+            return EXIT_FAILURE;
+        }
+    }
+
+    exeResult_st = wsbatch_Run_t(console_xs, &batchConfig_st, &failed_u);
+    if(failed_u > 0)
+        fprintf(stderr, "%zu command(s) failed\n", failed_u);
+
+    if(batchConfig_st.fd_i != STDIN_FILENO)
+        (void)close(batchConfig_st.fd_i);
+
+    return (wserr_OK == exeResult_st) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,244 @@
+/****************************************************************************************
+* FILENAME :        rexbench.c
+*
+* SHORT DESCRIPTION:
+*   Benchmark of the arg_rex matchers
+*
+* DETAILED DESCRIPTION :
+*   Times arg_parse of one arg_rex argument with the backtracking matcher and with
+*   the linear time matcher (ARG_REX_LINEAR). The pathological patterns are matched
+*   against inputs of growing length. Ambiguous alternatives cost the backtracker
+*   little, but a loop whose body matches the empty string is repeated up to the
+*   repetition limit before the backtracker gives up, which costs about a
+*   millisecond per value even for short inputs. Nested twice like ((b*)*)*a*c it
+*   runs for minutes, so such patterns are left out. The typical patterns are the
+*   kind used to validate option values.
+*
+*   usage: rexbench [max length of the pathological inputs, default 1024]
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "argtable3.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Minimum measuring time of one case in nanoseconds
+ */
+#define BENCH_MIN_NS 20000000.0
+
+/**
+ * Length of the shortest pathological input, each further input is this factor longer
+ */
+#define BENCH_LEN_STEP 4
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Pattern matched against a fixed input
+ */
+typedef struct benchCase_tag
+{
+    const char *pattern_cpc;
+    const char *text_cpc;
+}benchCase_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static double TimeParse_d(const char *pattern_cpc, int flags_i, const char *text_cpc,
+                            int *match_pi);
+static double Now_d(void);
+static void PrintCase_vd(const char *pattern_cpc, const char *text_cpc);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Patterns with ambiguous alternatives or loops matching the empty string, matched
+ * against "aaa...a" without a match
+ */
+static const char *pathological_capc[] =
+{
+    "(a|a)*b",
+    "(a|aa)*b",
+    "(b*)*a*c",
+    "(b?)*a*c",
+    "(b*b*)*a*c",
+    "(b*)+a*c",
+};
+
+/**
+ * Patterns validating typical option values
+ */
+static const benchCase_t typical_casx[] =
+{
+    { "[0-9]+", "4711" },
+    { "[a-z][a-z0-9_]*", "log_level_2" },
+    { "(get|set|list|delete)", "delete" },
+    { "[0-9]+\\.[0-9]+\\.[0-9]+\\.[0-9]+", "192.168.100.200" },
+    { "[A-Za-z0-9._]+@[A-Za-z0-9.]+\\.[a-z]+", "stephan.wink@example.com" },
+    { "0x[0-9a-fA-F]+", "0xDEADbeef" },
+};
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(int argc, char *argv[])
+{
+    static char text_ca[4096];
+    int maxLen_i = (argc > 1) ? atoi(argv[1]) : 1024;
+    int len_i;
+    int backMatch_i;
+    int linMatch_i;
+    double back_d;
+    double lin_d;
+    size_t idx_u;
+
+    if((maxLen_i <= 0) || (maxLen_i >= (int)sizeof(text_ca)))
+    {
+        fprintf(stderr, "usage: %s [max input length 1..%d]\n", argv[0],
+                (int)sizeof(text_ca) - 1);
+        return EXIT_FAILURE;
+    }
+
+    printf("%-44s %-24s %14s %14s\n", "pattern", "input", "backtrack ns", "linear ns");
+
+    for(idx_u = 0; idx_u < sizeof(pathological_capc) / sizeof(pathological_capc[0]); idx_u++)
+    {
+        for(len_i = BENCH_LEN_STEP; len_i <= maxLen_i; len_i *= BENCH_LEN_STEP)
+        {
+            memset(text_ca, 'a', (size_t)len_i);
+            text_ca[len_i] = '\0';
+            back_d = TimeParse_d(pathological_capc[idx_u], 0, text_ca, &backMatch_i);
+            lin_d = TimeParse_d(pathological_capc[idx_u], ARG_REX_LINEAR, text_ca, &linMatch_i);
+            PrintCase_vd(pathological_capc[idx_u], text_ca);
+            printf(" %14.0f %14.0f%s\n", back_d, lin_d,
+                    (backMatch_i != linMatch_i) ? "  MISMATCH" : "");
+        }
+    }
+
+    for(idx_u = 0; idx_u < sizeof(typical_casx) / sizeof(typical_casx[0]); idx_u++)
+    {
+        back_d = TimeParse_d(typical_casx[idx_u].pattern_cpc, 0, typical_casx[idx_u].text_cpc,
+                                &backMatch_i);
+        lin_d = TimeParse_d(typical_casx[idx_u].pattern_cpc, ARG_REX_LINEAR,
+                                typical_casx[idx_u].text_cpc, &linMatch_i);
+        PrintCase_vd(typical_casx[idx_u].pattern_cpc, typical_casx[idx_u].text_cpc);
+        printf(" %14.0f %14.0f%s\n", back_d, lin_d,
+                (backMatch_i != linMatch_i) ? "  MISMATCH" : "");
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Parses one value with an arg_rex argument until the minimum measuring time
+ *              has passed
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pattern_cpc regular expression
+ * @param   flags_i     flags of arg_rex, ARG_REX_LINEAR selects the linear matcher
+ * @param   text_cpc    value to match
+ * @param   match_pi    receives 1 if the value matches, else 0
+ * @return  time of one arg_parse in nanoseconds
+*//*------------------------------------------------------------------------------------*/
+static double TimeParse_d(const char *pattern_cpc, int flags_i, const char *text_cpc,
+                            int *match_pi)
+{
+    struct arg_rex *rex_pst = arg_rex1(NULL, NULL, pattern_cpc, NULL, flags_i, NULL);
+    struct arg_end *end_pst = arg_end(1);
+    void *argtable_apv[] = { rex_pst, end_pst };
+    char *argv_apc[] = { "rexbench", (char *)text_cpc, NULL };
+    unsigned long runs_u = 0;
+    double start_d;
+    double elapsed_d;
+    int errors_i = 1;
+
+    (void)arg_compile(argtable_apv);
+    start_d = Now_d();
+    do
+    {
+        errors_i = arg_parse(2, argv_apc, argtable_apv);
+        runs_u++;
+        elapsed_d = Now_d() - start_d;
+    } while(elapsed_d < BENCH_MIN_NS);
+
+    *match_pi = (errors_i == 0) ? 1 : 0;
+    arg_freetable(argtable_apv, sizeof(argtable_apv) / sizeof(argtable_apv[0]));
+
+    return(elapsed_d / (double)runs_u);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Returns the monotonic time
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  time in nanoseconds
+*//*------------------------------------------------------------------------------------*/
+static double Now_d(void)
+{
+    struct timespec now_st;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &now_st);
+    return((double)now_st.tv_sec * 1e9 + (double)now_st.tv_nsec);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Prints the pattern and the input of a case, long inputs are shortened
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   pattern_cpc regular expression
+ * @param   text_cpc    matched value
+*//*------------------------------------------------------------------------------------*/
+static void PrintCase_vd(const char *pattern_cpc, const char *text_cpc)
+{
+    char input_ca[32];
+    size_t len_u = strlen(text_cpc);
+
+    if(len_u > 20U)
+        (void)snprintf(input_ca, sizeof(input_ca), "%.14s...(%u)", text_cpc, (unsigned)len_u);
+    else
+        (void)snprintf(input_ca, sizeof(input_ca), "%s", text_cpc);
+    printf("%-44s %-24s", pattern_cpc, input_ca);
+}
@@ -0,0 +1,176 @@
+/****************************************************************************************
+* FILENAME :        tokencheck.c
+*
+* SHORT DESCRIPTION:
+*   Check of the splitting of a command line into arguments
+*
+* DETAILED DESCRIPTION :
+*   Splits lines with quotes, escapes and whitespace with embedded_cli_tokenize_spans
+*   and compares the arguments, their positions in the line and the quoted flag
+*   with the expected results. The quotes and escapes are removed in place, so each
+*   argument must be found at its offset, nul terminated and of its length. A line
+*   with more arguments than argv holds checks that the rest of the line is
+*   dropped.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "embedded_cli.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Most arguments of a checked line, including the terminating NULL entry
+ */
+#define CHECK_MAX_ARGC 8
+
+/**
+ * Size of the line buffer
+ */
+#define CHECK_LINE_LEN 64U
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Line and its expected arguments
+ */
+typedef struct line_tag
+{
+    const char *line_cpc;
+    /**
+     * size of argv passed to the tokenizer
+     */
+    int maxArgc_i;
+    int argc_i;
+    const char *args_capc[CHECK_MAX_ARGC];
+    /**
+     * one character per argument, 'q' if the argument is quoted
+     */
+    const char *quoted_cpc;
+} line_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static int CheckLine_i(const line_t *line_pcst);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Checked lines, quotes keep whitespace, quotes of the other kind and backslashes,
+ * a backslash keeps the next character outside of quotes
+ */
+static const line_t lines_cast[] =
+{
+    {"add 1 2",                     CHECK_MAX_ARGC, 3, {"add", "1", "2"}, "---"},
+    {"  add\t1  2 \r\n",            CHECK_MAX_ARGC, 3, {"add", "1", "2"}, "---"},
+    {"say \"hello world\" 'a b'",   CHECK_MAX_ARGC, 3, {"say", "hello world", "a b"},
+                                                                                "-qq"},
+    {"say c\\ d e\\\"f \"\"",       CHECK_MAX_ARGC, 4, {"say", "c d", "e\"f", ""}, "-qqq"},
+    {"\"it's\" 'say \"hi\"' \"a\\b\"", CHECK_MAX_ARGC, 3, {"it's", "say \"hi\"", "a\\b"},
+                                                                                "qqq"},
+    {"pre\"mid dle\"post x",        CHECK_MAX_ARGC, 2, {"premid dlepost", "x"}, "q-"},
+    {"say \"open end",              CHECK_MAX_ARGC, 2, {"say", "open end"}, "-q"},
+    {"say end\\",                   CHECK_MAX_ARGC, 2, {"say", "end"}, "-q"},
+    {"''",                          CHECK_MAX_ARGC, 1, {""}, "q"},
+    {"",                            CHECK_MAX_ARGC, 0, {NULL}, ""},
+    {" \t ",                        CHECK_MAX_ARGC, 0, {NULL}, ""},
+    {"a b \"c d\" e f",             3,              2, {"a", "b"}, "--"},
+    {"a b",                         1,              0, {NULL}, ""},
+};
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    size_t idx_u;
+    int failed_i = 0;
+
+    for(idx_u = 0; idx_u < sizeof(lines_cast) / sizeof(lines_cast[0]); idx_u++)
+    {
+        failed_i += CheckLine_i(&lines_cast[idx_u]);
+    }
+
+    return((failed_i > 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Splits a line and compares the arguments and their positions
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   line_pcst   line and expected arguments
+ * @return  1 if the line is not split as expected, 0 otherwise
+*//*------------------------------------------------------------------------------------*/
+static int CheckLine_i(const line_t *line_pcst)
+{
+    char buf_ca[CHECK_LINE_LEN];
+    char *argv_apc[CHECK_MAX_ARGC];
+    struct embedded_cli_token tokens_ast[CHECK_MAX_ARGC];
+    int argc_i;
+    int arg_i;
+
+    (void)snprintf(buf_ca, sizeof(buf_ca), "%s", line_pcst->line_cpc);
+    argc_i = embedded_cli_tokenize_spans(buf_ca, sizeof(buf_ca), argv_apc, tokens_ast,
+                                         line_pcst->maxArgc_i);
+    if((argc_i != line_pcst->argc_i) || (argv_apc[argc_i] != NULL))
+    {
+        fprintf(stderr, "tokencheck: \"%s\" has %d arguments\n", line_pcst->line_cpc, argc_i);
+        return 1;
+    }
+
+    for(arg_i = 0; arg_i < argc_i; arg_i++)
+    {
+        if((strcmp(argv_apc[arg_i], line_pcst->args_capc[arg_i]) != 0) ||
+           (argv_apc[arg_i] != &buf_ca[tokens_ast[arg_i].offset]) ||
+           (tokens_ast[arg_i].len != strlen(line_pcst->args_capc[arg_i])) ||
+           (tokens_ast[arg_i].quoted != (line_pcst->quoted_cpc[arg_i] == 'q')))
+        {
+            fprintf(stderr, "tokencheck: \"%s\" argument %d is \"%s\" at %zu, length %zu%s\n",
+                    line_pcst->line_cpc, arg_i, argv_apc[arg_i], tokens_ast[arg_i].offset,
+                    tokens_ast[arg_i].len, tokens_ast[arg_i].quoted ? ", quoted" : "");
+            return 1;
+        }
+    }
+
+    return 0;
+}
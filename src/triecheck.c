@@ -0,0 +1,399 @@
+/****************************************************************************************
+* FILENAME :        triecheck.c
+*
+* SHORT DESCRIPTION:
+*   Check of the prefix index of the command names
+*
+* DETAILED DESCRIPTION :
+*   Fills a wstrie with command names sharing prefixes and checks the number of keys
+*   and the value returned for unique, ambiguous, exact and unknown prefixes, the
+*   common characters used for the completion, the key order of wstrie_ForEach_vd
+*   and the rejected keys. A second index with many keys checks that the lookup
+*   still finds every key after the index has grown several times.
+*
+* AUTHOR :    Stephan Wink        CREATED ON :    16. Oct 2026
+*
+* Copyright (c) [2024] [Stephan Wink]
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+****************************************************************************************/
+
+/***************************************************************************************/
+/* Include Interfaces */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wstrie.h"
+#include "wserr.h"
+
+/***************************************************************************************/
+/* Local constant defines */
+
+/**
+ * Number of keys of the grown index
+ */
+#define CHECK_MANY_KEYS 2000
+
+/***************************************************************************************/
+/* Local function like makros */
+
+/***************************************************************************************/
+/* Local type definitions (enum, struct, union) */
+
+/**
+ * @brief Expected result of a prefix lookup
+ */
+typedef struct prefix_tag
+{
+    const char *prefix_cpc;
+    size_t keys_u;
+    /**
+     * key of the only match, NULL if none or several keys match
+     */
+    const char *value_cpc;
+} prefix_t;
+
+/**
+ * @brief Keys collected by wstrie_ForEach_vd
+ */
+typedef struct visit_tag
+{
+    const char *keys_apc[8];
+    size_t count_u;
+} visit_t;
+
+/***************************************************************************************/
+/* Local functions prototypes: */
+static int CheckPrefixes_i(wstrie_t *trie_pst);
+static int CheckCommon_i(wstrie_t *trie_pst);
+static int CheckOrder_i(wstrie_t *trie_pst);
+static int CheckRejected_i(wstrie_t *trie_pst);
+static int CheckMany_i(void);
+static bool CollectKey_bol(void *data_pv, void *value_pv);
+
+/***************************************************************************************/
+/* Local variables: */
+
+/**
+ * Keys of the index, the value of each key is the key itself. The list is not
+ * sorted to check the order of wstrie_ForEach_vd.
+ */
+static const char *keys_capc[] =
+{
+    "history",
+    "add",
+    "help",
+    "adduser",
+    "addr",
+    "quit",
+};
+
+/**
+ * Lookups of the index
+ */
+static const prefix_t prefixes_cast[] =
+{
+    {"",        6, NULL},
+    {"h",       2, NULL},
+    {"he",      1, "help"},
+    {"his",     1, "history"},
+    {"ad",      3, NULL},
+    {"add",     3, NULL},
+    {"addu",    1, "adduser"},
+    {"q",       1, "quit"},
+    {"quits",   0, NULL},
+    {"x",       0, NULL},
+    {"Add",     0, NULL},
+};
+
+/***************************************************************************************/
+/* Global functions (unlimited visibility) */
+/**--------------------------------------------------------------------------------------
+ * @brief     Main function and entry point for executable
+ * @author    S. Wink
+ * @date      16. Oct. 2026
+*//*-----------------------------------------------------------------------------------*/
+int main(void)
+{
+    wstrie_t trie_st;
+    size_t idx_u;
+    int failed_i = 0;
+
+    wstrie_Init_vd(&trie_st);
+    for(idx_u = 0; idx_u < sizeof(keys_capc) / sizeof(keys_capc[0]); idx_u++)
+    {
+        if(wstrie_Insert_t(&trie_st, keys_capc[idx_u], (void *)keys_capc[idx_u]) != wserr_OK)
+        {
+            fprintf(stderr, "triecheck: key %s not inserted\n", keys_capc[idx_u]);
+            failed_i++;
+        }
+    }
+
+    failed_i += CheckPrefixes_i(&trie_st);
+    failed_i += CheckCommon_i(&trie_st);
+    failed_i += CheckOrder_i(&trie_st);
+    failed_i += CheckRejected_i(&trie_st);
+    wstrie_Free_vd(&trie_st);
+
+    failed_i += CheckMany_i();
+
+    return((failed_i > 0) ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+/***************************************************************************************/
+/* Local functions: */
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks the number of keys and the value of each prefix lookup, an exact
+ *              key which is also the prefix of other keys is found by its full name
+ *              only
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index of keys_capc
+ * @return  number of failed lookups
+*//*------------------------------------------------------------------------------------*/
+static int CheckPrefixes_i(wstrie_t *trie_pst)
+{
+    const prefix_t *prefix_pcst;
+    wstrie_match_t match_st;
+    size_t keys_u;
+    size_t idx_u;
+    bool valueOk_bol;
+    int failed_i = 0;
+
+    for(idx_u = 0; idx_u < sizeof(prefixes_cast) / sizeof(prefixes_cast[0]); idx_u++)
+    {
+        prefix_pcst = &prefixes_cast[idx_u];
+        keys_u = wstrie_Match_u(trie_pst, prefix_pcst->prefix_cpc,
+                                strlen(prefix_pcst->prefix_cpc), &match_st);
+        if(prefix_pcst->value_cpc == NULL)
+            valueOk_bol = (match_st.value_pv == NULL);
+        else
+            valueOk_bol = (match_st.value_pv != NULL) &&
+                          (strcmp(match_st.value_pv, prefix_pcst->value_cpc) == 0);
+
+        if((keys_u != prefix_pcst->keys_u) || (match_st.keys_u != keys_u) || !valueOk_bol)
+        {
+            fprintf(stderr, "triecheck: prefix \"%s\" matches %zu keys, value %s\n",
+                    prefix_pcst->prefix_cpc, keys_u,
+                    (match_st.value_pv != NULL) ? (const char *)match_st.value_pv : "NULL");
+            failed_i++;
+        }
+    }
+
+    if((wstrie_Find_pv(trie_pst, "add", 3) != keys_capc[1]) ||
+       (wstrie_Find_pv(trie_pst, "addu", 4) != NULL) ||
+       (wstrie_Find_pv(trie_pst, "addrx", 4) != keys_capc[4]))
+    {
+        fprintf(stderr, "triecheck: exact lookup failed\n");
+        failed_i++;
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks the characters the matching keys have in common behind the prefix
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index of keys_capc
+ * @return  number of failed lookups
+*//*------------------------------------------------------------------------------------*/
+static int CheckCommon_i(wstrie_t *trie_pst)
+{
+    wstrie_match_t match_st;
+    char common_ca[16];
+    int failed_i = 0;
+
+    (void)wstrie_Match_u(trie_pst, "a", 1, &match_st);
+    if((wstrie_Common_u(trie_pst, &match_st, common_ca, sizeof(common_ca)) != 2) ||
+       (strcmp(common_ca, "dd") != 0))
+    {
+        fprintf(stderr, "triecheck: common part of \"a\" is \"%s\"\n", common_ca);
+        failed_i++;
+    }
+
+    (void)wstrie_Match_u(trie_pst, "hi", 2, &match_st);
+    if((wstrie_Common_u(trie_pst, &match_st, common_ca, sizeof(common_ca)) != 5) ||
+       (strcmp(common_ca, "story") != 0))
+    {
+        fprintf(stderr, "triecheck: common part of \"hi\" is \"%s\"\n", common_ca);
+        failed_i++;
+    }
+
+    /* a short buffer gets the beginning of the common part */
+    (void)wstrie_Match_u(trie_pst, "hi", 2, &match_st);
+    if((wstrie_Common_u(trie_pst, &match_st, common_ca, 3) != 2) ||
+       (strcmp(common_ca, "st") != 0))
+    {
+        fprintf(stderr, "triecheck: truncated common part of \"hi\" is \"%s\"\n", common_ca);
+        failed_i++;
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks that the matching keys are visited in key order
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index of keys_capc
+ * @return  number of failed iterations
+*//*------------------------------------------------------------------------------------*/
+static int CheckOrder_i(wstrie_t *trie_pst)
+{
+    static const char *sorted_capc[] = {"add", "addr", "adduser", "help", "history", "quit"};
+    wstrie_match_t match_st;
+    visit_t visit_st;
+    size_t idx_u;
+    int failed_i = 0;
+
+    visit_st.count_u = 0;
+    (void)wstrie_Match_u(trie_pst, "", 0, &match_st);
+    wstrie_ForEach_vd(trie_pst, &match_st, CollectKey_bol, &visit_st);
+    if(visit_st.count_u != sizeof(sorted_capc) / sizeof(sorted_capc[0]))
+    {
+        fprintf(stderr, "triecheck: %zu keys visited\n", visit_st.count_u);
+        return 1;
+    }
+    for(idx_u = 0; idx_u < visit_st.count_u; idx_u++)
+    {
+        if(strcmp(visit_st.keys_apc[idx_u], sorted_capc[idx_u]) != 0)
+        {
+            fprintf(stderr, "triecheck: key %zu visited is %s\n", idx_u,
+                    visit_st.keys_apc[idx_u]);
+            failed_i++;
+        }
+    }
+
+    visit_st.count_u = 0;
+    (void)wstrie_Match_u(trie_pst, "add", 3, &match_st);
+    wstrie_ForEach_vd(trie_pst, &match_st, CollectKey_bol, &visit_st);
+    if((visit_st.count_u != 3) || (strcmp(visit_st.keys_apc[0], "add") != 0) ||
+       (strcmp(visit_st.keys_apc[2], "adduser") != 0))
+    {
+        fprintf(stderr, "triecheck: keys of \"add\" visited in the wrong order\n");
+        failed_i++;
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks that duplicate, empty and keys without value are rejected and do
+ *              not change the index
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   trie_pst    index of keys_capc
+ * @return  number of accepted keys
+*//*------------------------------------------------------------------------------------*/
+static int CheckRejected_i(wstrie_t *trie_pst)
+{
+    static const char other_cc[] = "other";
+    int failed_i = 0;
+
+    if((wstrie_Insert_t(trie_pst, "help", (void *)other_cc) != wserr_ERR_PARAM) ||
+       (wstrie_Insert_t(trie_pst, "", (void *)other_cc) != wserr_ERR_PARAM) ||
+       (wstrie_Insert_t(trie_pst, "new", NULL) != wserr_ERR_PARAM) ||
+       (wstrie_Insert_t(trie_pst, NULL, (void *)other_cc) != wserr_ERR_PARAM))
+    {
+        fprintf(stderr, "triecheck: invalid key accepted\n");
+        failed_i++;
+    }
+
+    if((wstrie_Find_pv(trie_pst, "help", 4) != keys_capc[2]) ||
+       (wstrie_Match_u(trie_pst, "", 0, NULL) != sizeof(keys_capc) / sizeof(keys_capc[0])))
+    {
+        fprintf(stderr, "triecheck: index changed by a rejected key\n");
+        failed_i++;
+    }
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Checks the lookup of an index which has grown several times, the keys
+ *              share their first characters so the nodes have many children
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @return  number of keys not found, 1 if the index cannot be filled
+*//*------------------------------------------------------------------------------------*/
+static int CheckMany_i(void)
+{
+    static char keys_aac[CHECK_MANY_KEYS][8];
+    wstrie_t trie_st;
+    wstrie_match_t match_st;
+    size_t idx_u;
+    int failed_i = 0;
+
+    wstrie_Init_vd(&trie_st);
+    for(idx_u = 0; idx_u < CHECK_MANY_KEYS; idx_u++)
+    {
+        (void)snprintf(keys_aac[idx_u], sizeof(keys_aac[idx_u]), "k%c%c%04zu",
+                       'A' + (int)(idx_u % 26U), 'a' + (int)(idx_u / 26U % 26U), idx_u);
+        if(wstrie_Insert_t(&trie_st, keys_aac[idx_u], keys_aac[idx_u]) != wserr_OK)
+        {
+            fprintf(stderr, "triecheck: key %s not inserted\n", keys_aac[idx_u]);
+            wstrie_Free_vd(&trie_st);
+            return 1;
+        }
+    }
+
+    for(idx_u = 0; idx_u < CHECK_MANY_KEYS; idx_u++)
+    {
+        if((wstrie_Find_pv(&trie_st, keys_aac[idx_u], strlen(keys_aac[idx_u]))
+                != keys_aac[idx_u]) ||
+           (wstrie_Match_u(&trie_st, keys_aac[idx_u], strlen(keys_aac[idx_u]), &match_st)
+                != 1) ||
+           (match_st.value_pv != keys_aac[idx_u]))
+        {
+            fprintf(stderr, "triecheck: key %s not found\n", keys_aac[idx_u]);
+            failed_i++;
+        }
+    }
+
+    if(wstrie_Match_u(&trie_st, "kA", 2, NULL) != (CHECK_MANY_KEYS + 25U) / 26U)
+    {
+        fprintf(stderr, "triecheck: wrong number of keys below \"kA\"\n");
+        failed_i++;
+    }
+
+    wstrie_Free_vd(&trie_st);
+
+    return(failed_i);
+}
+
+/**---------------------------------------------------------------------------------------
+ * @brief   Visitor of wstrie_ForEach_vd, collects the keys
+ * @author  S. Wink
+ * @date    16. Oct. 2026
+ * @param   data_pv     visit_t collecting the keys
+ * @param   value_pv    key
+ * @return  true while there is room for further keys
+*//*------------------------------------------------------------------------------------*/
+static bool CollectKey_bol(void *data_pv, void *value_pv)
+{
+    visit_t *visit_pst = (visit_t *)data_pv;
+
+    visit_pst->keys_apc[visit_pst->count_u++] = (const char *)value_pv;
+
+    return(visit_pst->count_u < sizeof(visit_pst->keys_apc) / sizeof(visit_pst->keys_apc[0]));
+}